@@ -0,0 +1,353 @@
+/******************************************************************************
+ * File Name: bench.c
+ *
+ * Description: Frame benchmark of the scan strategies. All times are taken
+ * from the WDT counter, which also runs in Deep Sleep, and are summed in
+ * counter ticks over a window of BENCH_WINDOW_MS. A single measurement has a
+ * resolution of one ILO period, but the error does not accumulate over the
+ * window.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "cy_pdl.h"
+#include "cycfg_capsense.h"
+#include "wdt_timer.h"
+#include "bench.h"
+
+#if (0u != BENCH_ENABLE)
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+#define BENCH_WDT_MASK                   (0xFFFFu)
+
+/* Batches between the start of their scan and the end of their processing:
+ * at most one queued per widget and the one being scanned
+ */
+#define BENCH_BATCHES                    (CY_CAPSENSE_WIDGET_COUNT + 1u)
+
+/*******************************************************************************
+ * Global Definitions
+ *******************************************************************************/
+static bench_result_t bench_result;
+
+/* Window in progress, in WDT ticks */
+static uint32_t bench_last_pass;
+static uint32_t bench_elapsed;
+static uint32_t bench_sleep;
+static uint32_t bench_deepsleep;
+static uint32_t bench_msc_busy;
+static uint32_t bench_widgets;
+
+static uint32_t bench_latency;
+static uint32_t bench_latency_max;
+static uint32_t bench_batches;
+
+/* Scan in flight, written by the end-of-scan interrupt */
+static volatile bool bench_scanning = false;
+static volatile uint32_t bench_scan_start;
+
+/* Scan start of the batches not processed yet, in scan order */
+static uint32_t bench_batch_start[BENCH_BATCHES];
+static volatile uint32_t bench_batch_head;
+static uint32_t bench_batch_tail;
+
+/*******************************************************************************
+ * Function Name: bench_init
+ ********************************************************************************
+ * Summary:
+ *  Starts the first measurement window.
+ *
+ * Return:
+ *  void
+ *
+ * Parameters:
+ *  void
+ *******************************************************************************/
+void bench_init(void)
+{
+    bench_result.windows = 0u;
+    bench_last_pass = Cy_WDT_GetCount();
+    bench_elapsed = 0u;
+    bench_sleep = 0u;
+    bench_deepsleep = 0u;
+    bench_msc_busy = 0u;
+    bench_widgets = 0u;
+    bench_latency = 0u;
+    bench_latency_max = 0u;
+    bench_batches = 0u;
+    bench_scanning = false;
+    bench_batch_head = 0u;
+    bench_batch_tail = 0u;
+}
+
+/*******************************************************************************
+ * Function Name: bench_now
+ ********************************************************************************
+ * Summary:
+ *  Returns the WDT counter.
+ *
+ * Return:
+ *  uint32_t - WDT counter
+ *
+ * Parameters:
+ *  void
+ *******************************************************************************/
+uint32_t bench_now(void)
+{
+    return Cy_WDT_GetCount();
+}
+
+/*******************************************************************************
+ * Function Name: bench_close
+ ********************************************************************************
+ * Summary:
+ *  Computes the results of the window and starts the next one.
+ *
+ *******************************************************************************/
+static void bench_close(void)
+{
+    uint64_t windowUs = wdt_timer_ticks_to_us(bench_elapsed);
+    uint64_t sleepUs = wdt_timer_ticks_to_us(bench_sleep);
+    uint64_t deepSleepUs = wdt_timer_ticks_to_us(bench_deepsleep);
+    uint64_t activeUs = (windowUs > (sleepUs + deepSleepUs)) ? (windowUs - sleepUs - deepSleepUs) : 0u;
+    uint64_t mscBusyUs = wdt_timer_ticks_to_us(bench_msc_busy);
+    uint64_t charge;
+    uint32_t widgets = (0u != bench_widgets) ? bench_widgets : 1u;
+
+    /* uA x us = pC, per frame of CY_CAPSENSE_WIDGET_COUNT widgets */
+    charge = (activeUs * BENCH_ACTIVE_UA) + (sleepUs * BENCH_SLEEP_UA) + (deepSleepUs * BENCH_DEEPSLEEP_UA);
+
+    bench_result.framesPerSecX10 = (uint32_t)(((uint64_t)bench_widgets * 10000000u) /
+                                              ((uint64_t)CY_CAPSENSE_WIDGET_COUNT * windowUs));
+    bench_result.cpuBusyUsPerFrame = (uint32_t)((activeUs * CY_CAPSENSE_WIDGET_COUNT) / widgets);
+    bench_result.mscIdlePermille = (mscBusyUs < windowUs) ? (uint32_t)(((windowUs - mscBusyUs) * 1000u) / windowUs) :
+                                                            0u;
+    bench_result.chargeNcPerFrame = (uint32_t)((charge * CY_CAPSENSE_WIDGET_COUNT) / (1000u * (uint64_t)widgets));
+    bench_result.latencyUs = (0u != bench_batches) ?
+                             (uint32_t)(wdt_timer_ticks_to_us(bench_latency) / bench_batches) : 0u;
+    bench_result.maxLatencyUs = (uint32_t)wdt_timer_ticks_to_us(bench_latency_max);
+    bench_result.windows++;
+
+    bench_elapsed = 0u;
+    bench_sleep = 0u;
+    bench_deepsleep = 0u;
+    bench_msc_busy = 0u;
+    bench_widgets = 0u;
+    bench_latency = 0u;
+    bench_latency_max = 0u;
+    bench_batches = 0u;
+}
+
+/*******************************************************************************
+ * Function Name: bench_pass
+ ********************************************************************************
+ * Summary:
+ *  Called once per main loop pass. Closes the window after BENCH_WINDOW_MS.
+ *  A scan in flight is split at the end of the window.
+ *
+ * Return:
+ *  void
+ *
+ * Parameters:
+ *  void
+ *******************************************************************************/
+void bench_pass(void)
+{
+    uint32_t interruptState;
+    uint32_t now;
+
+    interruptState = Cy_SysLib_EnterCriticalSection();
+    now = Cy_WDT_GetCount();
+    bench_elapsed += (now - bench_last_pass) & BENCH_WDT_MASK;
+    bench_last_pass = now;
+
+    if ((0u != bench_elapsed) && (wdt_timer_ticks_to_us(bench_elapsed) >= (BENCH_WINDOW_MS * 1000u)))
+    {
+        if (bench_scanning)
+        {
+            bench_msc_busy += (now - bench_scan_start) & BENCH_WDT_MASK;
+            bench_scan_start = now;
+        }
+        bench_close();
+    }
+    Cy_SysLib_ExitCriticalSection(interruptState);
+}
+
+/*******************************************************************************
+ * Function Name: bench_processed
+ ********************************************************************************
+ * Summary:
+ *  Counts one processed widget.
+ *
+ * Return:
+ *  void
+ *
+ * Parameters:
+ *  void
+ *******************************************************************************/
+void bench_processed(void)
+{
+    bench_widgets++;
+}
+
+/*******************************************************************************
+ * Function Name: bench_batch_processed
+ ********************************************************************************
+ * Summary:
+ *  Adds the time from the start of the scan of the oldest batch in flight
+ *  to now to the latency of the window.
+ *
+ * Return:
+ *  void
+ *
+ * Parameters:
+ *  void
+ *******************************************************************************/
+void bench_batch_processed(void)
+{
+    uint32_t ticks;
+
+    if (bench_batch_tail == bench_batch_head)
+    {
+        return;
+    }
+    ticks = (Cy_WDT_GetCount() - bench_batch_start[bench_batch_tail]) & BENCH_WDT_MASK;
+    bench_batch_tail = (bench_batch_tail + 1u) % BENCH_BATCHES;
+
+    bench_latency += ticks;
+    if (ticks > bench_latency_max)
+    {
+        bench_latency_max = ticks;
+    }
+    bench_batches++;
+}
+
+/*******************************************************************************
+ * Function Name: bench_scan_started
+ ********************************************************************************
+ * Summary:
+ *  Marks the start of a scan. Called from the end-of-scan callback or with
+ *  interrupts disabled.
+ *
+ * Return:
+ *  void
+ *
+ * Parameters:
+ *  void
+ *******************************************************************************/
+void bench_scan_started(void)
+{
+    bench_scan_start = Cy_WDT_GetCount();
+    bench_scanning = true;
+
+    bench_batch_start[bench_batch_head] = bench_scan_start;
+    bench_batch_head = (bench_batch_head + 1u) % BENCH_BATCHES;
+}
+
+/*******************************************************************************
+ * Function Name: bench_scan_done
+ ********************************************************************************
+ * Summary:
+ *  Adds the duration of the completed scan to the busy time of the MSC
+ *  block. Called from the end-of-scan callback.
+ *
+ * Return:
+ *  void
+ *
+ * Parameters:
+ *  void
+ *******************************************************************************/
+void bench_scan_done(void)
+{
+    if (bench_scanning)
+    {
+        bench_msc_busy += (Cy_WDT_GetCount() - bench_scan_start) & BENCH_WDT_MASK;
+        bench_scanning = false;
+    }
+}
+
+/*******************************************************************************
+ * Function Name: bench_sleep_end
+ ********************************************************************************
+ * Summary:
+ *  Adds a CPU Sleep or Deep Sleep period to the idle time of the CPU.
+ *
+ * Return:
+ *  void
+ *
+ * Parameters:
+ *  deep - true for Deep Sleep
+ *  start - BENCH_SLEEP_BEGIN() at the entry
+ *******************************************************************************/
+void bench_sleep_end(bool deep, uint32_t start)
+{
+    uint32_t ticks = (Cy_WDT_GetCount() - start) & BENCH_WDT_MASK;
+
+    if (deep)
+    {
+        bench_deepsleep += ticks;
+    }
+    else
+    {
+        bench_sleep += ticks;
+    }
+}
+
+/*******************************************************************************
+ * Function Name: bench_get_result
+ ********************************************************************************
+ * Summary:
+ *  Returns the results of the last complete window.
+ *
+ * Return:
+ *  const bench_result_t * - results, windows is 0 until the first window
+ *  is complete
+ *
+ * Parameters:
+ *  void
+ *******************************************************************************/
+const bench_result_t * bench_get_result(void)
+{
+    return &bench_result;
+}
+
+#endif /* BENCH_ENABLE */
+
+/* [] END OF FILE */
@@ -0,0 +1,139 @@
+/******************************************************************************
+ * File Name: bench.h
+ *
+ * Description: Frame benchmark of the scan strategies. Measures the frame
+ * rate, the CPU busy time per frame, the idle time of the MSC block, a
+ * charge estimate per frame and the latency from the start of a scan to the
+ * end of its processing over fixed windows, on the target and in the host
+ * simulation. Compiled out unless BENCH_ENABLE is set.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+
+#ifndef BENCH_H
+#define BENCH_H
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+/* 1 = measure the frame benchmark, 0 = the measurement is compiled out */
+#ifndef BENCH_ENABLE
+#define BENCH_ENABLE                     (0u)
+#endif
+
+/* Length of a measurement window. At most 1000 ms, so that the 16-bit WDT
+ * counter does not wrap between two main loop passes at the slowest
+ * low-power interval.
+ */
+#ifndef BENCH_WINDOW_MS
+#define BENCH_WINDOW_MS                  (1000u)
+#endif
+
+/* Nominal CPU current in Active, CPU Sleep and Deep Sleep in uA, used to
+ * weight the time in each power state into the charge estimate. The MSC
+ * current does not depend on the strategy and is not included.
+ */
+#ifndef BENCH_ACTIVE_UA
+#define BENCH_ACTIVE_UA                  (2500u)
+#endif
+
+#ifndef BENCH_SLEEP_UA
+#define BENCH_SLEEP_UA                   (1200u)
+#endif
+
+#ifndef BENCH_DEEPSLEEP_UA
+#define BENCH_DEEPSLEEP_UA               (3u)
+#endif
+
+/* Instrumentation of the application. BENCH_SLEEP_BEGIN() returns the start
+ * of a sleep period passed to BENCH_SLEEP_END(). BENCH_BATCH_PROCESSED()
+ * follows the processing of each scanned batch, in scan order.
+ */
+#if (0u != BENCH_ENABLE)
+#define BENCH_PASS()                     bench_pass()
+#define BENCH_PROCESSED()                bench_processed()
+#define BENCH_BATCH_PROCESSED()          bench_batch_processed()
+#define BENCH_SCAN_STARTED()             bench_scan_started()
+#define BENCH_SCAN_DONE()                bench_scan_done()
+#define BENCH_SLEEP_BEGIN()              bench_now()
+#define BENCH_SLEEP_END(deep, start)     bench_sleep_end((deep), (start))
+#else
+#define BENCH_PASS()
+#define BENCH_PROCESSED()
+#define BENCH_BATCH_PROCESSED()
+#define BENCH_SCAN_STARTED()
+#define BENCH_SCAN_DONE()
+#define BENCH_SLEEP_BEGIN()              (0u)
+#define BENCH_SLEEP_END(deep, start)     ((void)(start))
+#endif /* BENCH_ENABLE */
+
+/*******************************************************************************
+ * Types
+ *******************************************************************************/
+/* Results of the last complete window */
+typedef struct
+{
+    uint32_t windows;                /* windows completed */
+    uint32_t framesPerSecX10;        /* frames per second x 10; a frame is one processing of every widget */
+    uint32_t cpuBusyUsPerFrame;      /* CPU time out of Sleep and Deep Sleep per frame, us */
+    uint32_t mscIdlePermille;        /* time without a scan in flight, per mille of the window */
+    uint32_t chargeNcPerFrame;       /* CPU charge per frame from BENCH_*_UA, nC */
+    uint32_t latencyUs;              /* mean time from the start of a scan to the end of its processing, us */
+    uint32_t maxLatencyUs;           /* longest of these times, us */
+} bench_result_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+void bench_init(void);
+uint32_t bench_now(void);
+void bench_pass(void);
+void bench_processed(void);
+void bench_batch_processed(void);
+void bench_scan_started(void);
+void bench_scan_done(void);
+void bench_sleep_end(bool deep, uint32_t start);
+const bench_result_t * bench_get_result(void);
+
+#endif /* BENCH_H */
+
+/* [] END OF FILE */
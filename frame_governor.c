@@ -0,0 +1,338 @@
+/******************************************************************************
+ * File Name: frame_governor.c
+ *
+ * Description: Fixed-period frame governor. Each WDT interrupt starts a frame
+ * unless the frame before is still being scanned or processed; that tick is
+ * counted as an overrun and the frame starts on the next tick, so frames
+ * always start on the tick grid. The period and the frame time are measured
+ * with the WDT counter.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include <string.h>
+#include "cy_pdl.h"
+#include "cycfg_capsense.h"
+#include "wdt_timer.h"
+#include "frame_governor.h"
+
+#if (0u != FRAME_GOVERNOR_ENABLE)
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+#define FRAME_GOVERNOR_WDT_MASK          (0xFFFFu)
+
+/* Fractional bits of the mean times in WDT ticks */
+#define FRAME_GOVERNOR_MEAN_SHIFT        (4u)
+
+/*******************************************************************************
+ * Global Definitions
+ *******************************************************************************/
+static frame_governor_stats_t frame_governor_stats;
+
+/* Widgets of the frame left to scan and left to process */
+static volatile uint32_t frame_governor_to_scan = 0u;
+static volatile uint32_t frame_governor_to_process = 0u;
+
+/* WDT count at the start of the frame. The period to the next start is not
+ * measured after a tick in low-power mode.
+ */
+static uint32_t frame_governor_start = 0u;
+static bool frame_governor_timed = false;
+
+/* Periods and frame times in WDT ticks */
+static uint64_t frame_governor_period_sum = 0u;
+static uint32_t frame_governor_periods = 0u;
+static uint32_t frame_governor_min_period = 0u;
+static uint32_t frame_governor_max_period = 0u;
+static uint64_t frame_governor_busy_sum = 0u;
+static uint32_t frame_governor_busy_frames = 0u;
+static uint32_t frame_governor_max_busy = 0u;
+
+/*******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+static void frame_governor_begin(uint32_t now);
+static uint32_t frame_governor_mean_us(uint64_t sum, uint32_t count);
+
+/*******************************************************************************
+ * Function Name: frame_governor_init
+ ********************************************************************************
+ * Summary:
+ *  Clears the statistics and starts the first frame. The WDT interrupt
+ *  interval must be FRAME_GOVERNOR_PERIOD_US.
+ *
+ * Return:
+ *  void
+ *
+ * Parameters:
+ *  void
+ *******************************************************************************/
+void frame_governor_init(void)
+{
+    memset(&frame_governor_stats, 0, sizeof(frame_governor_stats));
+    frame_governor_period_sum = 0u;
+    frame_governor_periods = 0u;
+    frame_governor_min_period = UINT32_MAX;
+    frame_governor_max_period = 0u;
+    frame_governor_busy_sum = 0u;
+    frame_governor_busy_frames = 0u;
+    frame_governor_max_busy = 0u;
+    frame_governor_restart();
+}
+
+/*******************************************************************************
+ * Function Name: frame_governor_tick
+ ********************************************************************************
+ * Summary:
+ *  Starts a frame if the frame before has been processed, otherwise counts an
+ *  overrun. Called from the WDT interrupt.
+ *
+ * Return:
+ *  bool - true if a frame starts; the caller starts its first scan
+ *
+ * Parameters:
+ *  run - false in low-power mode, where no frame starts
+ *******************************************************************************/
+bool frame_governor_tick(bool run)
+{
+    uint32_t now = Cy_WDT_GetCount();
+    uint32_t ticks;
+
+    if (!run)
+    {
+        frame_governor_timed = false;
+        return false;
+    }
+    if (0u != frame_governor_to_process)
+    {
+        frame_governor_stats.overruns++;
+        return false;
+    }
+
+    if (frame_governor_timed)
+    {
+        ticks = (now - frame_governor_start) & FRAME_GOVERNOR_WDT_MASK;
+        frame_governor_period_sum += ticks;
+        frame_governor_periods++;
+        if (ticks < frame_governor_min_period)
+        {
+            frame_governor_min_period = ticks;
+        }
+        if (ticks > frame_governor_max_period)
+        {
+            frame_governor_max_period = ticks;
+        }
+    }
+    frame_governor_begin(now);
+    return true;
+}
+
+/*******************************************************************************
+ * Function Name: frame_governor_scan_allowed
+ ********************************************************************************
+ * Summary:
+ *  Tells whether the frame has widgets left to scan.
+ *
+ * Return:
+ *  bool - false once every widget of the frame has been scanned
+ *
+ * Parameters:
+ *  void
+ *******************************************************************************/
+bool frame_governor_scan_allowed(void)
+{
+    return (0u != frame_governor_to_scan);
+}
+
+/*******************************************************************************
+ * Function Name: frame_governor_scanned
+ ********************************************************************************
+ * Summary:
+ *  Counts the widgets of a scan started for the frame. Called from the
+ *  end-of-scan callback or with interrupts disabled.
+ *
+ * Return:
+ *  void
+ *
+ * Parameters:
+ *  widgets - widgets of the batch
+ *******************************************************************************/
+void frame_governor_scanned(uint32_t widgets)
+{
+    frame_governor_to_scan = (widgets < frame_governor_to_scan) ? (frame_governor_to_scan - widgets) : 0u;
+}
+
+/*******************************************************************************
+ * Function Name: frame_governor_processed
+ ********************************************************************************
+ * Summary:
+ *  Counts the widgets of a processed batch and measures the frame time when
+ *  the last widget of the frame has been processed. Called from the main
+ *  loop; the WDT interrupt starts no frame while widgets are left.
+ *
+ * Return:
+ *  void
+ *
+ * Parameters:
+ *  widgets - widgets of the batch
+ *******************************************************************************/
+void frame_governor_processed(uint32_t widgets)
+{
+    uint32_t left = frame_governor_to_process;
+    uint32_t ticks;
+
+    if (0u == left)
+    {
+        return;
+    }
+    if (widgets < left)
+    {
+        frame_governor_to_process = left - widgets;
+        return;
+    }
+
+    ticks = (Cy_WDT_GetCount() - frame_governor_start) & FRAME_GOVERNOR_WDT_MASK;
+    frame_governor_busy_sum += ticks;
+    frame_governor_busy_frames++;
+    if (ticks > frame_governor_max_busy)
+    {
+        frame_governor_max_busy = ticks;
+    }
+    frame_governor_to_process = 0u;
+}
+
+/*******************************************************************************
+ * Function Name: frame_governor_restart
+ ********************************************************************************
+ * Summary:
+ *  Moves the next WDT interrupt one period from now and starts a frame at
+ *  once, for the return from low-power mode. The frame in progress, if any,
+ *  is abandoned.
+ *
+ * Return:
+ *  void
+ *
+ * Parameters:
+ *  void
+ *******************************************************************************/
+void frame_governor_restart(void)
+{
+    uint32_t interruptState;
+
+    interruptState = Cy_SysLib_EnterCriticalSection();
+
+    /* A tick already pending would end the new frame at once as an overrun */
+    Cy_WDT_ClearInterrupt();
+    NVIC_ClearPendingIRQ(srss_wdt_irq_IRQn);
+    wdt_timer_restart();
+    frame_governor_begin(Cy_WDT_GetCount());
+    Cy_SysLib_ExitCriticalSection(interruptState);
+}
+
+/*******************************************************************************
+ * Function Name: frame_governor_get_stats
+ ********************************************************************************
+ * Summary:
+ *  Returns the frame statistics, converted to microseconds with the current
+ *  ILO compensation.
+ *
+ * Return:
+ *  const frame_governor_stats_t * - statistics since frame_governor_init()
+ *
+ * Parameters:
+ *  void
+ *******************************************************************************/
+const frame_governor_stats_t * frame_governor_get_stats(void)
+{
+    frame_governor_stats_t * stats = &frame_governor_stats;
+    uint32_t below;
+    uint32_t above;
+
+    if (0u != frame_governor_periods)
+    {
+        stats->periodUs = frame_governor_mean_us(frame_governor_period_sum, frame_governor_periods);
+        stats->minPeriodUs = wdt_timer_ticks_to_us(frame_governor_min_period);
+        stats->maxPeriodUs = wdt_timer_ticks_to_us(frame_governor_max_period);
+        below = (stats->minPeriodUs < FRAME_GOVERNOR_PERIOD_US) ? (FRAME_GOVERNOR_PERIOD_US - stats->minPeriodUs) : 0u;
+        above = (stats->maxPeriodUs > FRAME_GOVERNOR_PERIOD_US) ? (stats->maxPeriodUs - FRAME_GOVERNOR_PERIOD_US) : 0u;
+        stats->jitterUs = (below > above) ? below : above;
+    }
+    if (0u != frame_governor_busy_frames)
+    {
+        stats->frameUs = frame_governor_mean_us(frame_governor_busy_sum, frame_governor_busy_frames);
+        stats->maxFrameUs = wdt_timer_ticks_to_us(frame_governor_max_busy);
+    }
+    return stats;
+}
+
+/*******************************************************************************
+ * Function Name: frame_governor_begin
+ ********************************************************************************
+ * Summary:
+ *  Starts a frame of all widgets at the given WDT count.
+ *
+ *******************************************************************************/
+static void frame_governor_begin(uint32_t now)
+{
+    frame_governor_start = now;
+    frame_governor_timed = true;
+    frame_governor_to_scan = CY_CAPSENSE_WIDGET_COUNT;
+    frame_governor_to_process = CY_CAPSENSE_WIDGET_COUNT;
+    frame_governor_stats.frames++;
+}
+
+/*******************************************************************************
+ * Function Name: frame_governor_mean_us
+ ********************************************************************************
+ * Summary:
+ *  Converts the mean of a sum of WDT ticks to microseconds without losing the
+ *  fraction of a tick.
+ *
+ *******************************************************************************/
+static uint32_t frame_governor_mean_us(uint64_t sum, uint32_t count)
+{
+    uint32_t mean = (uint32_t)((sum << FRAME_GOVERNOR_MEAN_SHIFT) / count);
+
+    return wdt_timer_ticks_to_us(mean) >> FRAME_GOVERNOR_MEAN_SHIFT;
+}
+
+#endif /* FRAME_GOVERNOR_ENABLE */
+
+/* [] END OF FILE */
@@ -0,0 +1,122 @@
+/******************************************************************************
+ * File Name: frame_governor.h
+ *
+ * Description: Fixed-period frame governor. Starts a frame that scans and
+ * processes every widget once on each WDT interrupt, stops the scan chaining
+ * at the end of the frame so the device sleeps for the rest of the period,
+ * and measures the achieved period, its jitter and the overruns.
+ * Compiled out unless FRAME_GOVERNOR_ENABLE is set.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+
+#ifndef FRAME_GOVERNOR_H
+#define FRAME_GOVERNOR_H
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+/* 1 = run the frames at FRAME_GOVERNOR_RATE_HZ, 0 = free-running pipeline */
+#ifndef FRAME_GOVERNOR_ENABLE
+#define FRAME_GOVERNOR_ENABLE            (0u)
+#endif
+
+/* Frame rate in Hz. The WDT interrupt interval becomes the frame period. At
+ * least 2 Hz, so that the two periods of an overrun fit the 16-bit WDT
+ * counter.
+ */
+#ifndef FRAME_GOVERNOR_RATE_HZ
+#define FRAME_GOVERNOR_RATE_HZ           (100u)
+#endif
+
+#define FRAME_GOVERNOR_PERIOD_US         (1000000u / FRAME_GOVERNOR_RATE_HZ)
+
+/* Instrumentation of the application. FRAME_GOVERNOR_TICK() returns true from
+ * the WDT interrupt when a new frame starts, FRAME_GOVERNOR_SCAN_ALLOWED()
+ * tells whether the frame has widgets left to scan, FRAME_GOVERNOR_SCANNED()
+ * and FRAME_GOVERNOR_PROCESSED() count the widgets of each scan and of each
+ * processed batch, and FRAME_GOVERNOR_RESTART() starts a frame at once on
+ * the return from low-power mode.
+ */
+#if (0u != FRAME_GOVERNOR_ENABLE)
+#define FRAME_GOVERNOR_TICK(run)         frame_governor_tick(run)
+#define FRAME_GOVERNOR_SCAN_ALLOWED()    frame_governor_scan_allowed()
+#define FRAME_GOVERNOR_SCANNED(widgets)  frame_governor_scanned(widgets)
+#define FRAME_GOVERNOR_PROCESSED(widgets) frame_governor_processed(widgets)
+#define FRAME_GOVERNOR_RESTART()         frame_governor_restart()
+#else
+#define FRAME_GOVERNOR_TICK(run)         ((void)(run), false)
+#define FRAME_GOVERNOR_SCAN_ALLOWED()    (true)
+#define FRAME_GOVERNOR_SCANNED(widgets)
+#define FRAME_GOVERNOR_PROCESSED(widgets)
+#define FRAME_GOVERNOR_RESTART()
+#endif /* FRAME_GOVERNOR_ENABLE */
+
+/*******************************************************************************
+ * Types
+ *******************************************************************************/
+typedef struct
+{
+    uint32_t frames;                 /* frames started */
+    uint32_t overruns;               /* ticks skipped, the frame before was not processed yet */
+    uint32_t periodUs;               /* mean time between two frame starts */
+    uint32_t minPeriodUs;
+    uint32_t maxPeriodUs;
+    uint32_t jitterUs;               /* largest deviation of a period from FRAME_GOVERNOR_PERIOD_US */
+    uint32_t frameUs;                /* mean time from the frame start to the end of its processing */
+    uint32_t maxFrameUs;
+} frame_governor_stats_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+void frame_governor_init(void);
+bool frame_governor_tick(bool run);
+bool frame_governor_scan_allowed(void);
+void frame_governor_scanned(uint32_t widgets);
+void frame_governor_processed(uint32_t widgets);
+void frame_governor_restart(void);
+const frame_governor_stats_t * frame_governor_get_stats(void);
+
+#endif /* FRAME_GOVERNOR_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,174 @@
+/******************************************************************************
+ * File Name: host_regmap.c
+ *
+ * Description: Compact EZI2C register map for a host controller. The map is
+ * built from the CAPSENSE context after each processed frame and copied
+ * into the EZI2C buffer between host transactions, so a host poll of a few
+ * bytes always returns the registers of one frame.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include <string.h>
+#include "host_regmap.h"
+
+/*******************************************************************************
+ * Global Definitions
+ *******************************************************************************/
+/* Buffer exposed to the host, and the map being built */
+static uint8_t host_regmap_buf[HOST_REGMAP_SIZE];
+static uint8_t host_regmap_next[HOST_REGMAP_SIZE];
+
+static uint16_t host_regmap_frame = 0u;
+static bool host_regmap_pending = false;
+
+static CySCB_Type * host_regmap_base = NULL;
+static cy_stc_scb_ezi2c_context_t * host_regmap_context = NULL;
+static IRQn_Type host_regmap_irq;
+
+/*******************************************************************************
+ * Function Name: host_regmap_attach_ezi2c
+ ********************************************************************************
+ * Summary:
+ *  Exposes the register map as the EZI2C primary buffer, read-only for the
+ *  host.
+ *
+ * Return:
+ *  void
+ *
+ * Parameters:
+ *  base - EZI2C SCB block
+ *  context - EZI2C context
+ *  irq - EZI2C interrupt, masked while the map is updated
+ *******************************************************************************/
+void host_regmap_attach_ezi2c(CySCB_Type * base, cy_stc_scb_ezi2c_context_t * context, IRQn_Type irq)
+{
+    host_regmap_context = context;
+    host_regmap_irq = irq;
+    host_regmap_base = base;
+
+    Cy_SCB_EZI2C_SetBuffer1(base, host_regmap_buf, HOST_REGMAP_SIZE, 0u, context);
+}
+
+/*******************************************************************************
+ * Function Name: host_regmap_update
+ ********************************************************************************
+ * Summary:
+ *  Builds the register map from the processed widgets. The map is exposed to
+ *  the host by the next host_regmap_publish() call.
+ *
+ * Return:
+ *  void
+ *
+ * Parameters:
+ *  context - CAPSENSE context
+ *******************************************************************************/
+void host_regmap_update(const cy_stc_capsense_context_t * context)
+{
+    const cy_stc_capsense_widget_config_t * ptrWdCfg = context->ptrWdConfig;
+    uint32_t wdId;
+#if (0u != HOST_REGMAP_NUM_SENSORS)
+    uint32_t snsId;
+    uint32_t snsIndex = 0u;
+    uint32_t pos;
+    uint32_t diff;
+#endif /* HOST_REGMAP_NUM_SENSORS */
+
+    memset(host_regmap_next, 0, HOST_REGMAP_STATUS_SIZE);
+    for (wdId = 0u; wdId < CY_CAPSENSE_WIDGET_COUNT; wdId++)
+    {
+        if (0u != Cy_CapSense_IsWidgetActive(wdId, context))
+        {
+            host_regmap_next[wdId >> 3u] |= (uint8_t)(1u << (wdId & 7u));
+        }
+
+#if (0u != HOST_REGMAP_NUM_SENSORS)
+        for (snsId = 0u; snsId < ptrWdCfg[wdId].numSns; snsId++)
+        {
+            /* Sensors before the range wrap around to large values */
+            pos = snsIndex - HOST_REGMAP_FIRST_SENSOR;
+            if (pos < HOST_REGMAP_NUM_SENSORS)
+            {
+                pos = HOST_REGMAP_DIFF_OFFSET + (2u * pos);
+                diff = ptrWdCfg[wdId].ptrSnsContext[snsId].diff;
+                host_regmap_next[pos] = (uint8_t)diff;
+                host_regmap_next[pos + 1u] = (uint8_t)(diff >> 8u);
+            }
+            snsIndex++;
+        }
+#endif /* HOST_REGMAP_NUM_SENSORS */
+    }
+    (void)ptrWdCfg;
+
+    host_regmap_pending = true;
+}
+
+/*******************************************************************************
+ * Function Name: host_regmap_publish
+ ********************************************************************************
+ * Summary:
+ *  Copies a new register map into the EZI2C buffer and increments the frame
+ *  counter. While the host is in a transaction, the copy is deferred to the
+ *  next call.
+ *
+ * Return:
+ *  void
+ *
+ * Parameters:
+ *  void
+ *******************************************************************************/
+void host_regmap_publish(void)
+{
+    if ((!host_regmap_pending) || (NULL == host_regmap_base))
+    {
+        return;
+    }
+
+    NVIC_DisableIRQ(host_regmap_irq);
+    if (0u == (Cy_SCB_EZI2C_GetActivity(host_regmap_base, host_regmap_context) & CY_SCB_EZI2C_STATUS_BUSY))
+    {
+        host_regmap_frame++;
+        host_regmap_next[HOST_REGMAP_FRAME_OFFSET] = (uint8_t)host_regmap_frame;
+        host_regmap_next[HOST_REGMAP_FRAME_OFFSET + 1u] = (uint8_t)(host_regmap_frame >> 8u);
+        memcpy(host_regmap_buf, host_regmap_next, HOST_REGMAP_SIZE);
+        host_regmap_pending = false;
+    }
+    NVIC_EnableIRQ(host_regmap_irq);
+}
+
+/* [] END OF FILE */
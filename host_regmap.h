@@ -0,0 +1,99 @@
+/******************************************************************************
+ * File Name: host_regmap.h
+ *
+ * Description: Compact EZI2C register map for a host controller. Instead of
+ * the full tuner data, the host reads the widget status bitmap, a frame
+ * counter and optionally the difference counts of a range of sensors. The
+ * register layout below is the interface to the host.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+
+#ifndef HOST_REGMAP_H
+#define HOST_REGMAP_H
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "cy_pdl.h"
+#include "cycfg_capsense.h"
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+/* EZI2C buffer with the I2C tuner interface: 0 = the tuner data for the
+ * CAPSENSE Tuner, 1 = the compact register map for a host controller
+ */
+#ifndef HOST_REGMAP_ENABLE
+#define HOST_REGMAP_ENABLE               (0u)
+#endif
+
+/* Sensors whose difference counts follow the frame counter. The index
+ * counts the sensors of all widgets in widget order. 0 sensors leaves out
+ * the difference counts.
+ */
+#ifndef HOST_REGMAP_FIRST_SENSOR
+#define HOST_REGMAP_FIRST_SENSOR         (0u)
+#endif
+
+#ifndef HOST_REGMAP_NUM_SENSORS
+#define HOST_REGMAP_NUM_SENSORS          (0u)
+#endif
+
+/* Register layout, read-only for the host. Multi-byte fields are
+ * little-endian.
+ *   [0 .. STATUS_SIZE-1] widget status, bit n of byte n/8 set while widget n
+ *                        is active
+ *   [FRAME_OFFSET]       frame counter, 16 bits, incremented whenever new scan
+ *                        results are published
+ *   [DIFF_OFFSET]        difference count of each sensor in the range,
+ *                        16 bits each
+ */
+#define HOST_REGMAP_STATUS_SIZE          ((CY_CAPSENSE_WIDGET_COUNT + 7u) / 8u)
+#define HOST_REGMAP_FRAME_OFFSET         (HOST_REGMAP_STATUS_SIZE)
+#define HOST_REGMAP_DIFF_OFFSET          (HOST_REGMAP_FRAME_OFFSET + 2u)
+#define HOST_REGMAP_SIZE                 (HOST_REGMAP_DIFF_OFFSET + (2u * HOST_REGMAP_NUM_SENSORS))
+
+/*******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+void host_regmap_attach_ezi2c(CySCB_Type * base, cy_stc_scb_ezi2c_context_t * context, IRQn_Type irq);
+void host_regmap_update(const cy_stc_capsense_context_t * context);
+void host_regmap_publish(void);
+
+#endif /* HOST_REGMAP_H */
+
+/* [] END OF FILE */
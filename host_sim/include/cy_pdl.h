@@ -0,0 +1,333 @@
+/******************************************************************************
+ * File Name: cy_pdl.h
+ *
+ * Description: Host simulation replacement for the PSoC 4 Peripheral Driver
+ * Library header. Declares the subset of PDL types and functions used by the
+ * application. The functions are implemented in sim_pdl.c on top of the
+ * virtual clock of the simulator.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#ifndef CY_PDL_H
+#define CY_PDL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/*******************************************************************************
+ * Common definitions
+ *******************************************************************************/
+typedef uint32_t cy_rslt_t;
+#define CY_RSLT_SUCCESS                  ((cy_rslt_t)0x00000000U)
+
+void sim_assert_failed(const char * file, int line);
+#define CY_ASSERT(x)                     do { if (!(x)) { sim_assert_failed(__FILE__, __LINE__); } } while (0)
+
+#define CY_UNUSED_PARAMETER(x)           ((void)(x))
+
+/* Every CY_SECTION object lands in the simulated flash, see Cy_Flash_WriteRow() */
+#define CY_SECTION(name)                 __attribute__((section("sim_flash")))
+#define CY_ALIGN(align)                  __attribute__((aligned(align)))
+
+/*******************************************************************************
+ * CMSIS core
+ *******************************************************************************/
+typedef enum
+{
+    srss_wdt_irq_IRQn               = 6,
+    scb_1_interrupt_IRQn            = 10,
+    scb_2_interrupt_IRQn            = 11,
+    msc_0_interrupt_IRQn            = 17,
+    msc_1_interrupt_IRQn            = 18,
+    SIM_IRQ_COUNT                   = 32
+} IRQn_Type;
+
+void __enable_irq(void);
+void __disable_irq(void);
+void __NOP(void);
+#define __COMPILER_BARRIER()             __asm__ volatile("" ::: "memory")
+void NVIC_EnableIRQ(IRQn_Type IRQn);
+void NVIC_DisableIRQ(IRQn_Type IRQn);
+void NVIC_ClearPendingIRQ(IRQn_Type IRQn);
+
+/*******************************************************************************
+ * SysLib
+ *******************************************************************************/
+void Cy_SysLib_Delay(uint32_t milliseconds);
+void Cy_SysLib_DelayUs(uint16_t microseconds);
+uint32_t Cy_SysLib_EnterCriticalSection(void);
+void Cy_SysLib_ExitCriticalSection(uint32_t savedIntrStatus);
+
+/*******************************************************************************
+ * SysInt
+ *******************************************************************************/
+typedef void (* cy_israddress)(void);
+
+typedef struct
+{
+    IRQn_Type       intrSrc;
+    uint32_t        intrPriority;
+} cy_stc_sysint_t;
+
+typedef enum
+{
+    CY_SYSINT_SUCCESS   = 0x00U,
+    CY_SYSINT_BAD_PARAM = 0x01U
+} cy_en_sysint_status_t;
+
+cy_en_sysint_status_t Cy_SysInt_Init(const cy_stc_sysint_t * config, cy_israddress userIsr);
+
+/*******************************************************************************
+ * WDT
+ *******************************************************************************/
+void Cy_WDT_Enable(void);
+void Cy_WDT_Disable(void);
+void Cy_WDT_Lock(void);
+void Cy_WDT_Unlock(void);
+void Cy_WDT_SetMatch(uint32_t match);
+uint32_t Cy_WDT_GetMatch(void);
+uint32_t Cy_WDT_GetCount(void);
+void Cy_WDT_ClearInterrupt(void);
+void Cy_WDT_MaskInterrupt(void);
+void Cy_WDT_UnmaskInterrupt(void);
+void Cy_WDT_ClearWatchdog(void);
+
+/*******************************************************************************
+ * Flash
+ *******************************************************************************/
+#define CY_FLASH_SIZEOF_ROW              (128u)
+
+typedef enum
+{
+    CY_FLASH_DRV_SUCCESS            = 0x00UL,
+    CY_FLASH_DRV_INV_PROT           = 0x01UL,
+    CY_FLASH_DRV_INVALID_INPUT_PARAMETERS = 0x02UL
+} cy_en_flashdrv_status_t;
+
+cy_en_flashdrv_status_t Cy_Flash_WriteRow(uint32_t rowAddr, const uint32_t * data);
+
+/*******************************************************************************
+ * SysTick
+ *******************************************************************************/
+typedef enum
+{
+    CY_SYSTICK_CLOCK_SOURCE_CLK_LF  = 0u,
+    CY_SYSTICK_CLOCK_SOURCE_CLK_CPU = 4u
+} cy_en_systick_clock_source_t;
+
+void Cy_SysTick_Init(cy_en_systick_clock_source_t clockSource, uint32_t interval);
+void Cy_SysTick_DisableInterrupt(void);
+uint32_t Cy_SysTick_GetValue(void);
+
+/*******************************************************************************
+ * SysClk
+ *******************************************************************************/
+typedef enum
+{
+    CY_SYSCLK_SUCCESS   = 0x00UL,
+    CY_SYSCLK_BAD_PARAM = 0x01UL,
+    CY_SYSCLK_TIMEOUT   = 0x02UL,
+    CY_SYSCLK_INVALID_STATE = 0x03UL,
+    CY_SYSCLK_STARTED   = 0x04UL
+} cy_en_sysclk_status_t;
+
+void Cy_SysClk_IloStartMeasurement(void);
+void Cy_SysClk_IloStopMeasurement(void);
+cy_en_sysclk_status_t Cy_SysClk_IloCompensate(uint32_t desiredDelay, uint32_t * compensatedCycles);
+uint32_t Cy_SysClk_ClkSysGetFrequency(void);
+
+/*******************************************************************************
+ * SysPm
+ *******************************************************************************/
+typedef enum
+{
+    CY_SYSPM_SUCCESS        = 0x00U,
+    CY_SYSPM_BAD_PARAM      = 0x01U,
+    CY_SYSPM_TIMEOUT        = 0x02U,
+    CY_SYSPM_INVALID_STATE  = 0x03U,
+    CY_SYSPM_CANCELED       = 0x04U,
+    CY_SYSPM_FAIL           = 0x05U
+} cy_en_syspm_status_t;
+
+typedef enum
+{
+    CY_SYSPM_SLEEP      = 0U,
+    CY_SYSPM_DEEPSLEEP  = 1U
+} cy_en_syspm_callback_type_t;
+
+typedef enum
+{
+    CY_SYSPM_CHECK_READY        = 0x01U,
+    CY_SYSPM_CHECK_FAIL         = 0x02U,
+    CY_SYSPM_BEFORE_TRANSITION  = 0x04U,
+    CY_SYSPM_AFTER_TRANSITION   = 0x08U
+} cy_en_syspm_callback_mode_t;
+
+typedef struct
+{
+    void * base;
+    void * context;
+} cy_stc_syspm_callback_params_t;
+
+typedef cy_en_syspm_status_t (* Cy_SysPmCallback)(cy_stc_syspm_callback_params_t * callbackParams,
+                                                  cy_en_syspm_callback_mode_t mode);
+
+typedef struct cy_stc_syspm_callback
+{
+    Cy_SysPmCallback                callback;
+    cy_en_syspm_callback_type_t     type;
+    uint32_t                        skipMode;
+    cy_stc_syspm_callback_params_t * callbackParams;
+    struct cy_stc_syspm_callback *  prevItm;
+    struct cy_stc_syspm_callback *  nextItm;
+    uint8_t                         order;
+} cy_stc_syspm_callback_t;
+
+bool Cy_SysPm_RegisterCallback(cy_stc_syspm_callback_t * handler);
+cy_en_syspm_status_t Cy_SysPm_CpuEnterSleep(void);
+cy_en_syspm_status_t Cy_SysPm_CpuEnterDeepSleep(void);
+cy_en_syspm_status_t Cy_SysClk_DeepSleepCallback(cy_stc_syspm_callback_params_t * callbackParams,
+                                                 cy_en_syspm_callback_mode_t mode);
+
+/*******************************************************************************
+ * GPIO
+ *******************************************************************************/
+typedef struct
+{
+    volatile uint32_t DR;
+    volatile uint32_t PS;
+    volatile uint32_t PC;
+} GPIO_PRT_Type;
+
+#define GPIO_PRT_DR(base)                (((GPIO_PRT_Type *)(base))->DR)
+
+void Cy_GPIO_Write(GPIO_PRT_Type * base, uint32_t pinNum, uint32_t value);
+uint32_t Cy_GPIO_ReadOut(GPIO_PRT_Type * base, uint32_t pinNum);
+void Cy_GPIO_Inv(GPIO_PRT_Type * base, uint32_t pinNum);
+
+/*******************************************************************************
+ * SCB (UART and EZI2C)
+ *******************************************************************************/
+typedef struct
+{
+    uint32_t instance;
+} CySCB_Type;
+
+typedef struct
+{
+    uint32_t baudRate;
+} cy_stc_scb_uart_config_t;
+
+typedef enum
+{
+    CY_SCB_UART_SUCCESS         = 0x00U,
+    CY_SCB_UART_BAD_PARAM       = 0x01U,
+    CY_SCB_UART_RECEIVE_BUSY    = 0x02U,
+    CY_SCB_UART_TRANSMIT_BUSY   = 0x03U
+} cy_en_scb_uart_status_t;
+
+/* UART transmit status and callback events */
+#define CY_SCB_UART_TRANSMIT_ACTIVE         (0x01UL)
+#define CY_SCB_UART_TRANSMIT_IN_FIFO_EVENT  (0x01UL)
+#define CY_SCB_UART_TRANSMIT_DONE_EVENT     (0x02UL)
+
+typedef void (* cy_cb_scb_uart_handle_events_t)(uint32_t event);
+
+typedef struct
+{
+    uint8_t * rxRingBuf;
+    uint32_t rxRingBufSize;
+    volatile uint32_t rxRingBufHead;
+    volatile uint32_t rxRingBufTail;
+    cy_cb_scb_uart_handle_events_t cbEvents;
+} cy_stc_scb_uart_context_t;
+
+cy_en_scb_uart_status_t Cy_SCB_UART_Init(CySCB_Type * base, const cy_stc_scb_uart_config_t * config,
+                                         cy_stc_scb_uart_context_t * context);
+void Cy_SCB_UART_Enable(CySCB_Type * base);
+void Cy_SCB_UART_StartRingBuffer(CySCB_Type * base, void * buffer, uint32_t size,
+                                 cy_stc_scb_uart_context_t * context);
+uint32_t Cy_SCB_UART_GetNumInRingBuffer(CySCB_Type const * base, cy_stc_scb_uart_context_t const * context);
+cy_en_scb_uart_status_t Cy_SCB_UART_Receive(CySCB_Type * base, void * buffer, uint32_t size,
+                                            cy_stc_scb_uart_context_t * context);
+void Cy_SCB_UART_PutArrayBlocking(CySCB_Type * base, void * buffer, uint32_t size);
+cy_en_scb_uart_status_t Cy_SCB_UART_Transmit(CySCB_Type * base, void * buffer, uint32_t size,
+                                             cy_stc_scb_uart_context_t * context);
+uint32_t Cy_SCB_UART_GetTransmitStatus(CySCB_Type const * base, cy_stc_scb_uart_context_t const * context);
+void Cy_SCB_UART_RegisterCallback(CySCB_Type const * base, cy_cb_scb_uart_handle_events_t callback,
+                                  cy_stc_scb_uart_context_t * context);
+bool Cy_SCB_UART_IsTxComplete(CySCB_Type const * base);
+void Cy_SCB_UART_Interrupt(CySCB_Type * base, cy_stc_scb_uart_context_t * context);
+cy_en_syspm_status_t Cy_SCB_UART_DeepSleepCallback(cy_stc_syspm_callback_params_t * callbackParams,
+                                                   cy_en_syspm_callback_mode_t mode);
+
+typedef struct
+{
+    uint8_t slaveAddress1;
+} cy_stc_scb_ezi2c_config_t;
+
+typedef enum
+{
+    CY_SCB_EZI2C_SUCCESS        = 0x00U,
+    CY_SCB_EZI2C_BAD_PARAM      = 0x01U
+} cy_en_scb_ezi2c_status_t;
+
+#define CY_SCB_EZI2C_STATUS_READ1        (0x01UL)
+#define CY_SCB_EZI2C_STATUS_WRITE1       (0x02UL)
+#define CY_SCB_EZI2C_STATUS_BUSY         (0x10UL)
+
+typedef struct
+{
+    uint8_t * buf1;
+    uint32_t buf1Size;
+    uint32_t buf1rwBondary;
+    volatile uint32_t status;
+} cy_stc_scb_ezi2c_context_t;
+
+cy_en_scb_ezi2c_status_t Cy_SCB_EZI2C_Init(CySCB_Type * base, const cy_stc_scb_ezi2c_config_t * config,
+                                           cy_stc_scb_ezi2c_context_t * context);
+void Cy_SCB_EZI2C_Enable(CySCB_Type * base);
+void Cy_SCB_EZI2C_SetBuffer1(CySCB_Type const * base, uint8_t * buffer, uint32_t size,
+                             uint32_t rwBoundary, cy_stc_scb_ezi2c_context_t * context);
+uint32_t Cy_SCB_EZI2C_GetActivity(CySCB_Type const * base, cy_stc_scb_ezi2c_context_t * context);
+void Cy_SCB_EZI2C_Interrupt(CySCB_Type * base, cy_stc_scb_ezi2c_context_t * context);
+cy_en_syspm_status_t Cy_SCB_EZI2C_DeepSleepCallback(cy_stc_syspm_callback_params_t * callbackParams,
+                                                    cy_en_syspm_callback_mode_t mode);
+
+#endif /* CY_PDL_H */
+
+/* [] END OF FILE */
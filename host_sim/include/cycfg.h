@@ -0,0 +1,94 @@
+/******************************************************************************
+ * File Name: cycfg.h
+ *
+ * Description: Host simulation replacement for the Device Configurator
+ * generated header. Provides the pin, SCB and MSC instance names used by the
+ * application.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#ifndef CYCFG_H
+#define CYCFG_H
+
+#include "cy_pdl.h"
+
+/*******************************************************************************
+ * Pins
+ *******************************************************************************/
+extern GPIO_PRT_Type sim_gpio_prt0;
+
+#define GPIO_PRT0                        (&sim_gpio_prt0)
+
+#define P0_4_PORT                        GPIO_PRT0
+#define P0_4_PIN                         (4U)
+#define P0_5_PORT                        GPIO_PRT0
+#define P0_5_PIN                         (5U)
+
+#define CYBSP_LED_BTN0_PORT              P0_4_PORT
+#define CYBSP_LED_BTN0_PIN               P0_4_PIN
+#define CYBSP_LED_BTN1_PORT              P0_5_PORT
+#define CYBSP_LED_BTN1_PIN               P0_5_PIN
+
+/*******************************************************************************
+ * Peripherals
+ *******************************************************************************/
+extern CySCB_Type sim_scb1;
+extern const cy_stc_scb_uart_config_t scb_1_config;
+extern const cy_stc_scb_ezi2c_config_t CYBSP_EZI2C_config;
+
+#define scb_1_HW                         (&sim_scb1)
+#define scb_1_IRQ                        scb_1_interrupt_IRQn
+#define CYBSP_UART_HW                    scb_1_HW
+#define CYBSP_EZI2C_HW                   scb_1_HW
+#define CYBSP_EZI2C_IRQ                  scb_1_IRQ
+#define CYBSP_I2C_HW                     CYBSP_EZI2C_HW
+
+typedef struct
+{
+    uint32_t instance;
+} MSC_Type;
+
+extern MSC_Type sim_msc0;
+extern MSC_Type sim_msc1;
+
+#define msc_0_msc_0_HW                   (&sim_msc0)
+#define CY_MSC0_IRQ                      msc_0_interrupt_IRQn
+#define msc_1_msc_0_HW                   (&sim_msc1)
+#define CY_MSC1_IRQ                      msc_1_interrupt_IRQn
+
+#endif /* CYCFG_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,288 @@
+/******************************************************************************
+ * File Name: cycfg_capsense.h
+ *
+ * Description: Host simulation replacement for the CAPSENSE Configurator
+ * generated header and the subset of the CAPSENSE middleware API used by the
+ * application. The widget layout is set at compile time with SIM_WIDGET_COUNT,
+ * SIM_SLOTS_PER_WIDGET and SIM_CHANNEL_COUNT. The middleware is implemented in sim_capsense.c on
+ * top of a simulated MSC block.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#ifndef CYCFG_CAPSENSE_H
+#define CYCFG_CAPSENSE_H
+
+#include "cy_pdl.h"
+#include "cycfg.h"
+
+/*******************************************************************************
+ * Generated configuration
+ *******************************************************************************/
+#ifndef SIM_WIDGET_COUNT
+#define SIM_WIDGET_COUNT                 (2u)
+#endif
+
+#ifndef SIM_SLOTS_PER_WIDGET
+#define SIM_SLOTS_PER_WIDGET             (1u)
+#endif
+
+/* MSC channels. Every slot scans one sensor of the widget on each channel */
+#ifndef SIM_CHANNEL_COUNT
+#define SIM_CHANNEL_COUNT                (1u)
+#endif
+
+#define SIM_SNS_PER_WIDGET               (SIM_SLOTS_PER_WIDGET * SIM_CHANNEL_COUNT)
+
+#define CY_CAPSENSE_WIDGET_COUNT         (SIM_WIDGET_COUNT)
+#define CY_CAPSENSE_SENSOR_COUNT         (SIM_WIDGET_COUNT * SIM_SNS_PER_WIDGET)
+#define CY_CAPSENSE_SLOT_COUNT           (SIM_WIDGET_COUNT * SIM_SLOTS_PER_WIDGET)
+#define CY_CAPSENSE_TOTAL_CH_NUMBER      (SIM_CHANNEL_COUNT)
+
+#define CY_CAPSENSE_BUTTON0_WDGT_ID      (0u)
+#define CY_CAPSENSE_BUTTON0_SNS0_ID      (0u)
+#define CY_CAPSENSE_BUTTON1_WDGT_ID      (1u)
+#define CY_CAPSENSE_BUTTON1_SNS0_ID      (0u)
+
+/* The simulated middleware includes the self-test library */
+#define CY_CAPSENSE_BIST_EN              (1u)
+#define CY_CAPSENSE_MULTI_FREQUENCY_SCAN_EN (0u)
+
+/*******************************************************************************
+ * Middleware definitions
+ *******************************************************************************/
+typedef uint32_t cy_capsense_status_t;
+
+#define CY_CAPSENSE_STATUS_SUCCESS       (0x00u)
+#define CY_CAPSENSE_STATUS_BAD_PARAM     (0x01u)
+#define CY_CAPSENSE_STATUS_HW_BUSY       (0x04u)
+
+#define CY_CAPSENSE_NOT_BUSY             (0x00u)
+#define CY_CAPSENSE_BUSY                 (0x80u)
+
+#define CY_CAPSENSE_WD_ACTIVE_MASK       (0x01u)
+#define CY_CAPSENSE_SNS_TOUCH_STATUS_MASK (0x01u)
+
+#define CY_CAPSENSE_COMMAND_PACKET_SIZE  (16u)
+#define CY_CAPSENSE_COMMAND_OK           (0u)
+#define CY_CAPSENSE_WRONG_HEADER         (1u)
+#define CY_CAPSENSE_WRONG_TAIL           (2u)
+#define CY_CAPSENSE_WRONG_CRC            (3u)
+
+#define CY_CAPSENSE_COMMAND_HEAD_0_IDX   (0u)
+#define CY_CAPSENSE_COMMAND_HEAD_1_IDX   (1u)
+#define CY_CAPSENSE_COMMAND_CODE_0_IDX   (2u)
+#define CY_CAPSENSE_COMMAND_CRC_0_IDX    (11u)
+#define CY_CAPSENSE_COMMAND_CRC_1_IDX    (12u)
+#define CY_CAPSENSE_COMMAND_TAIL_0_IDX   (13u)
+#define CY_CAPSENSE_COMMAND_TAIL_1_IDX   (14u)
+#define CY_CAPSENSE_COMMAND_TAIL_2_IDX   (15u)
+
+#define CY_CAPSENSE_COMMAND_HEAD_0       (0x0Du)
+#define CY_CAPSENSE_COMMAND_HEAD_1       (0x0Au)
+#define CY_CAPSENSE_COMMAND_TAIL_0       (0x00u)
+#define CY_CAPSENSE_COMMAND_TAIL_1       (0xFFu)
+#define CY_CAPSENSE_COMMAND_TAIL_2       (0xFFu)
+
+#define CY_CAPSENSE_TU_CMD_NONE_E        (0u)
+#define CY_CAPSENSE_TU_CMD_SUSPEND_E     (1u)
+#define CY_CAPSENSE_TU_CMD_RESUME_E      (2u)
+#define CY_CAPSENSE_TU_CMD_RESTART_E     (3u)
+#define CY_CAPSENSE_TU_CMD_PING_E        (5u)
+
+#define CY_CAPSENSE_TU_FSM_RUNNING       (0x00u)
+#define CY_CAPSENSE_TU_FSM_SUSPENDED     (0x01u)
+
+#define CY_CAPSENSE_CSX_GROUP            (2u)
+#define CY_CAPSENSE_WD_BUTTON_E          (1u)
+#define CY_CAPSENSE_WD_LINEAR_SLIDER_E   (2u)
+
+typedef enum
+{
+    CY_CAPSENSE_BIST_SUCCESS_E       = 0x00u,
+    CY_CAPSENSE_BIST_BAD_PARAM_E     = 0x01u,
+    CY_CAPSENSE_BIST_HW_BUSY_E       = 0x02u,
+    CY_CAPSENSE_BIST_LOW_LIMIT_E     = 0x04u,
+    CY_CAPSENSE_BIST_HIGH_LIMIT_E    = 0x08u,
+    CY_CAPSENSE_BIST_ERROR_E         = 0x10u,
+    CY_CAPSENSE_BIST_FAIL_E          = 0xFFFFu,
+} cy_en_capsense_bist_status_t;
+
+typedef struct
+{
+    uint16_t raw;
+    uint16_t bsln;
+    uint16_t diff;
+    uint8_t status;
+    uint8_t negBslnRstCnt;
+    uint8_t bslnExt;
+    uint8_t cdacComp;
+} cy_stc_capsense_sensor_context_t;
+
+typedef struct
+{
+    uint16_t fingerTh;
+    uint16_t proxTh;
+    uint16_t maxRawCount;
+    uint16_t noiseTh;
+    uint16_t nNoiseTh;
+    uint16_t hysteresis;
+    uint8_t onDebounce;
+    uint8_t lowBslnRst;
+    uint16_t snsClk;
+    uint16_t cdacRef;
+    uint16_t numSubConversions;
+    uint8_t cdacCompDivider;
+    uint8_t status;
+} cy_stc_capsense_widget_context_t;
+
+typedef struct
+{
+    uint16_t configId;
+    uint16_t tunerCmd;
+    uint16_t scanCounter;
+    uint8_t tunerSt;
+    uint8_t numFineInitWaitCycles;
+    uint32_t status;
+} cy_stc_capsense_common_context_t;
+
+typedef struct
+{
+    uint16_t firstSlotId;
+    uint16_t numSlots;
+    uint16_t numSns;
+    uint16_t numCols;
+    uint16_t numRows;
+    uint8_t wdType;
+    uint8_t senseMethod;
+    cy_stc_capsense_widget_context_t * ptrWdContext;
+    cy_stc_capsense_sensor_context_t * ptrSnsContext;
+    uint32_t * ptrEltdCapacitance;
+} cy_stc_capsense_widget_config_t;
+
+typedef struct
+{
+    uint16_t wdId;
+    uint16_t snsId;
+} cy_stc_capsense_scan_slot_t;
+
+typedef struct
+{
+    uint16_t numWd;
+    uint16_t numSns;
+    uint8_t numChannels;
+    uint8_t channelOffset;
+} cy_stc_capsense_common_config_t;
+
+/* Sensor being scanned, passed to the start-sample and end-of-scan callbacks */
+typedef struct
+{
+    uint8_t widgetIndex;
+    uint16_t sensorIndex;
+} cy_stc_active_scan_sns_t;
+
+typedef enum
+{
+    CY_CAPSENSE_START_SAMPLE_E = 0x01u,
+    CY_CAPSENSE_END_OF_SCAN_E  = 0x02u,
+} cy_en_capsense_callback_event_t;
+
+typedef void (* cy_capsense_callback_t)(cy_stc_active_scan_sns_t * ptrActiveScan);
+typedef void (* cy_capsense_tuner_send_callback_t)(void * context);
+typedef void (* cy_capsense_tuner_receive_callback_t)(uint8_t ** commandPacket, uint8_t ** tunerPacket,
+                                                      void * context);
+
+typedef struct
+{
+    cy_capsense_callback_t ptrSSCallback;
+    cy_capsense_callback_t ptrEOSCallback;
+    cy_capsense_tuner_send_callback_t ptrTunerSendCallback;
+    cy_capsense_tuner_receive_callback_t ptrTunerReceiveCallback;
+} cy_stc_capsense_internal_context_t;
+
+typedef struct cy_stc_capsense_context
+{
+    const cy_stc_capsense_common_config_t * ptrCommonConfig;
+    cy_stc_capsense_common_context_t * ptrCommonContext;
+    cy_stc_capsense_internal_context_t * ptrInternalContext;
+    const cy_stc_capsense_widget_config_t * ptrWdConfig;
+    cy_stc_capsense_widget_context_t * ptrWdContext;
+    const cy_stc_capsense_scan_slot_t * ptrScanSlots;
+    cy_stc_active_scan_sns_t * ptrActiveScanSns;
+} cy_stc_capsense_context_t;
+
+typedef struct
+{
+    cy_stc_capsense_common_context_t commonContext;
+    cy_stc_capsense_widget_context_t widgetContext[CY_CAPSENSE_WIDGET_COUNT];
+    cy_stc_capsense_sensor_context_t sensorContext[CY_CAPSENSE_SENSOR_COUNT];
+} cy_stc_capsense_tuner_t;
+
+extern cy_stc_capsense_tuner_t cy_capsense_tuner;
+extern cy_stc_capsense_context_t cy_capsense_context;
+
+/*******************************************************************************
+ * Middleware API
+ *******************************************************************************/
+cy_capsense_status_t Cy_CapSense_Init(cy_stc_capsense_context_t * context);
+cy_capsense_status_t Cy_CapSense_Enable(cy_stc_capsense_context_t * context);
+cy_capsense_status_t Cy_CapSense_Initialize(cy_stc_capsense_context_t * context);
+void Cy_CapSense_InitializeAllBaselines(cy_stc_capsense_context_t * context);
+cy_capsense_status_t Cy_CapSense_ScanSlots(uint32_t startSlotId, uint32_t numberSlots,
+                                           cy_stc_capsense_context_t * context);
+cy_capsense_status_t Cy_CapSense_ScanAllSlots(cy_stc_capsense_context_t * context);
+uint32_t Cy_CapSense_IsBusy(const cy_stc_capsense_context_t * context);
+cy_capsense_status_t Cy_CapSense_ProcessWidget(uint32_t widgetId, cy_stc_capsense_context_t * context);
+cy_capsense_status_t Cy_CapSense_ProcessAllWidgets(cy_stc_capsense_context_t * context);
+uint32_t Cy_CapSense_IsWidgetActive(uint32_t widgetId, const cy_stc_capsense_context_t * context);
+uint32_t Cy_CapSense_IsAnyWidgetActive(const cy_stc_capsense_context_t * context);
+void Cy_CapSense_InterruptHandler(void * base, cy_stc_capsense_context_t * context);
+uint32_t Cy_CapSense_RunTuner(cy_stc_capsense_context_t * context);
+uint32_t Cy_CapSense_CheckTunerCmdIntegrity(const uint8_t * commandPacket);
+cy_capsense_status_t Cy_CapSense_RegisterCallback(cy_en_capsense_callback_event_t callbackType,
+                                                  cy_capsense_callback_t callbackFunction,
+                                                  cy_stc_capsense_context_t * context);
+cy_en_capsense_bist_status_t Cy_CapSense_CheckIntegritySensorPins(uint32_t widgetId, uint32_t sensorId,
+                                                                  cy_stc_capsense_context_t * context);
+cy_en_capsense_bist_status_t Cy_CapSense_MeasureCapacitanceSensorElectrode(uint32_t widgetId, uint32_t eltdId,
+                                                                           cy_stc_capsense_context_t * context);
+cy_en_capsense_bist_status_t Cy_CapSense_CheckIntegritySensorBaseline(uint32_t widgetId, uint32_t sensorId,
+                                                                      uint16_t baselineHighLimit,
+                                                                      uint16_t baselineLowLimit,
+                                                                      cy_stc_capsense_context_t * context);
+
+#endif /* CYCFG_CAPSENSE_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,186 @@
+/******************************************************************************
+ * File Name: sim.h
+ *
+ * Description: Internal interface of the host simulator. Declares the virtual
+ * clock, the interrupt delivery model, the run-time configuration and the
+ * statistics shared by the simulated PDL (sim_pdl.c), the simulated
+ * CAPSENSE middleware and MSC block (sim_capsense.c) and the raw count
+ * replay (sim_replay.c).
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#ifndef SIM_H
+#define SIM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "cy_pdl.h"
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+#define SIM_NS_PER_US                    (1000ULL)
+#define SIM_NS_PER_MS                    (1000000ULL)
+#define SIM_NS_PER_S                     (1000000000ULL)
+#define SIM_NEVER                        (UINT64_MAX)
+
+/* Number of LEDs wired on the simulated board */
+#define SIM_LED_COUNT                    (2u)
+
+/*******************************************************************************
+ * Data types
+ *******************************************************************************/
+typedef uint64_t sim_ns_t;
+
+/* Power state used for time accounting */
+typedef enum
+{
+    SIM_STATE_ACTIVE,
+    SIM_STATE_SLEEP,
+    SIM_STATE_DEEPSLEEP
+} sim_power_state_t;
+
+/* Run-time configuration, read from SIM_* environment variables */
+typedef struct
+{
+    uint32_t frames;                 /* Frames to run before the report */
+    sim_ns_t max_time;               /* Virtual time limit */
+    sim_ns_t slot_scan;              /* MSC conversion time per slot */
+    sim_ns_t scan_setup;             /* CPU cost of Cy_CapSense_ScanSlots() */
+    sim_ns_t irq_latency;            /* Event to ISR entry */
+    sim_ns_t isr;                    /* CPU cost of one MSC interrupt */
+    sim_ns_t process[64];            /* CPU cost of Cy_CapSense_ProcessWidget() */
+    sim_ns_t api;                    /* CPU cost of a small driver call */
+    uint32_t ilo_hz;                 /* Actual ILO frequency */
+    uint32_t wdt_match;              /* WDT match value set by the device configuration */
+    sim_ns_t ilo_meas;               /* ILO measurement duration */
+    sim_ns_t deepsleep_wake;         /* Deep Sleep exit time */
+    sim_ns_t sleep_wake;             /* CPU Sleep exit time */
+    uint32_t uart_baud;
+    bool tuner_host;                 /* Tuner host sends commands */
+    bool tuner_suspended;            /* Tuner starts suspended, no frames are sent */
+    double active_ua;                /* CPU current per power state */
+    double sleep_ua;
+    double deepsleep_ua;
+    sim_ns_t touch_period;
+    sim_ns_t touch_duration;
+    uint32_t touch_widgets;          /* Widgets 0..n-1 follow the touch script */
+    uint32_t noise;                  /* Raw count noise amplitude */
+    uint32_t emi_sns_clk;            /* Sense clock divider picking up the interference, 0 = none */
+    uint32_t emi_noise;              /* Raw count amplitude of the interference */
+    uint32_t seed;
+    bool verbose;
+    const char * uart_capture;        /* file receiving the UART TX bytes */
+    const char * replay;              /* raw count trace replayed in place of the touch script */
+    sim_ns_t bist_pins;              /* Sensor pin short check */
+    sim_ns_t bist_cap;               /* Electrode capacitance measurement */
+    uint32_t bist_short;             /* Widget with a shorted sensor pin */
+    const char * flash;               /* file holding the flash contents across runs */
+    sim_ns_t flash_row;              /* Flash row erase and program time */
+} sim_config_t;
+
+/* Statistics collected during the run */
+typedef struct
+{
+    sim_ns_t active;
+    sim_ns_t sleep;
+    sim_ns_t deepsleep;
+    sim_ns_t msc_busy;
+    uint32_t deepsleep_entries;
+    uint32_t sleep_entries;
+    uint32_t deepsleep_rejects;
+    uint32_t scans;
+    uint32_t msc_interrupts;
+    uint32_t wdt_interrupts;
+    uint64_t processed;
+    uint64_t tx_bytes;
+    uint64_t tuner_commands;
+    uint32_t flash_rows;
+    sim_ns_t first_frame;            /* Time when every widget was processed once */
+} sim_stats_t;
+
+/*******************************************************************************
+ * Global variables
+ *******************************************************************************/
+extern sim_ns_t sim_now;
+extern sim_config_t sim_cfg;
+extern sim_stats_t sim_stats;
+
+/*******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+/* Core (sim_core.c) */
+void sim_init(void);
+void sim_cpu(sim_ns_t duration);
+void sim_idle(sim_power_state_t state);
+void sim_service_interrupts(void);
+void sim_set_pending(IRQn_Type irq);
+void sim_clear_pending(IRQn_Type irq);
+void sim_register_isr(IRQn_Type irq, cy_israddress isr);
+void sim_enable_irq(IRQn_Type irq, bool enable);
+void sim_mask_irqs(bool mask);
+bool sim_irqs_masked(void);
+void sim_finish(int status);
+uint32_t sim_rand(void);
+
+/* Peripherals (sim_pdl.c) */
+void sim_pdl_init(void);
+sim_ns_t sim_pdl_next_event(void);
+void sim_pdl_update(void);
+void sim_pdl_report(void);
+void sim_uart_host_inject(const uint8_t * data, uint32_t size);
+
+/* MSC block and CAPSENSE (sim_capsense.c) */
+void sim_capsense_init(void);
+sim_ns_t sim_msc_next_event(void);
+void sim_msc_update(void);
+bool sim_touch_active(uint32_t widgetId, sim_ns_t time);
+void sim_led_changed(uint32_t led, bool on);
+void sim_capsense_report(void);
+
+/* Raw count replay (sim_replay.c) */
+void sim_replay_load(void);
+void sim_replay_start(void);
+bool sim_replay_done(sim_ns_t time);
+uint16_t sim_replay_raw(uint32_t widgetId, uint32_t snsId, sim_ns_t time);
+uint64_t sim_replay_touch_index(uint32_t widgetId, sim_ns_t time);
+sim_ns_t sim_replay_touch_onset(uint32_t widgetId, uint64_t index);
+uint32_t sim_replay_touches(uint32_t widgetId);
+void sim_replay_report(double frames);
+
+#endif /* SIM_H */
+
+/* [] END OF FILE */
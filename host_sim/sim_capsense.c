@@ -0,0 +1,1025 @@
+/******************************************************************************
+ * File Name: sim_capsense.c
+ *
+ * Description: Simulated MSC block and CAPSENSE middleware. Each slot converts
+ * for SIM_SLOT_SCAN_US and raises an interrupt on each channel; the interrupt
+ * handlers store a synthetic raw count per channel and the last one starts the
+ * next slot of the ScanSlots request. Raw
+ * counts follow a periodic touch script per widget, or a recorded trace with
+ * SIM_REPLAY (sim_replay.c), and the processing stage
+ * implements baseline, difference count, debounce and hysteresis so that touch
+ * detection and LED latency can be measured. The self-test functions take
+ * SIM_BIST_PINS_US and SIM_BIST_CAP_US and fail on the sensors of the
+ * SIM_BIST_SHORT widget.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include "sim.h"
+#include "cycfg_capsense.h"
+#include "../scan_schedule.h"
+#include "../self_test.h"
+#include "../warm_start.h"
+#include "../multi_freq.h"
+#include "../frame_governor.h"
+#include "../bench.h"
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+#define SIM_RAW_BASE                     (1000u)
+#define SIM_RAW_TOUCH_SIGNAL             (250u)
+#define SIM_SNS_CLK                      (4u)
+#define SIM_CDAC_COMP                    (32u)
+#define SIM_CDAC_COMP_DIV_CONFIG         (4u)
+#define SIM_CDAC_COMP_DIV                (6u)
+#define SIM_CDAC_COMP_STEP               (8)
+#define SIM_TUNER_PING_PERIOD            (50u * SIM_NS_PER_MS)
+#define SIM_ELTD_CAPACITANCE_FF          (12000u)
+
+/*******************************************************************************
+ * Data types
+ *******************************************************************************/
+typedef struct
+{
+    uint64_t count;
+    sim_ns_t sum;
+    sim_ns_t min;
+    sim_ns_t max;
+} sim_latency_t;
+
+typedef struct
+{
+    uint64_t detected_touch;         /* Index of the last detected touch */
+    uint64_t led_touch;              /* Index of the last touch shown on LED */
+    sim_ns_t last_processed;
+    sim_ns_t max_refresh;
+    sim_ns_t last_sample;
+    uint64_t processed;
+    uint32_t false_touches;
+    uint32_t detections;
+} sim_widget_stats_t;
+
+/*******************************************************************************
+ * Global Definitions
+ *******************************************************************************/
+cy_stc_capsense_tuner_t cy_capsense_tuner;
+
+static cy_stc_capsense_common_config_t sim_common_config;
+static cy_stc_capsense_internal_context_t sim_internal_context;
+static cy_stc_capsense_widget_config_t sim_wd_config[CY_CAPSENSE_WIDGET_COUNT];
+static cy_stc_capsense_scan_slot_t sim_scan_slots[CY_CAPSENSE_SLOT_COUNT * CY_CAPSENSE_TOTAL_CH_NUMBER];
+static cy_stc_active_scan_sns_t sim_active_scan_sns;
+static uint32_t sim_eltd_cap[CY_CAPSENSE_WIDGET_COUNT][SIM_SNS_PER_WIDGET + 1u];
+
+cy_stc_capsense_context_t cy_capsense_context =
+{
+    .ptrCommonConfig = &sim_common_config,
+    .ptrCommonContext = &cy_capsense_tuner.commonContext,
+    .ptrInternalContext = &sim_internal_context,
+    .ptrWdConfig = sim_wd_config,
+    .ptrWdContext = cy_capsense_tuner.widgetContext,
+    .ptrScanSlots = sim_scan_slots,
+    .ptrActiveScanSns = &sim_active_scan_sns,
+};
+
+/* MSC block state */
+static bool sim_msc_busy;
+static uint32_t sim_msc_slot;
+static uint32_t sim_msc_last_slot;
+static sim_ns_t sim_msc_event;
+static uint16_t sim_msc_sample[CY_CAPSENSE_TOTAL_CH_NUMBER];
+static bool sim_msc_irq_raised[CY_CAPSENSE_TOTAL_CH_NUMBER];
+static uint32_t sim_msc_channels_left;
+
+static uint8_t sim_debounce[CY_CAPSENSE_SENSOR_COUNT];
+static sim_ns_t sim_sample_time[CY_CAPSENSE_SLOT_COUNT];
+static sim_widget_stats_t sim_wd_stats[CY_CAPSENSE_WIDGET_COUNT];
+static sim_latency_t sim_detect_latency;
+static sim_latency_t sim_led_latency;
+static sim_latency_t sim_active_refresh;
+static sim_latency_t sim_sample_interval;
+static sim_ns_t sim_tuner_ping;
+
+/*******************************************************************************
+ * Touch script
+ *******************************************************************************/
+static uint32_t sim_touch_widgets(void)
+{
+    return (sim_cfg.touch_widgets < CY_CAPSENSE_WIDGET_COUNT) ? sim_cfg.touch_widgets : CY_CAPSENSE_WIDGET_COUNT;
+}
+
+static sim_ns_t sim_touch_phase(uint32_t widgetId)
+{
+    return (sim_cfg.touch_period * widgetId) / sim_touch_widgets();
+}
+
+/* Returns the index (starting from 1) of the touch in progress, 0 if none */
+static uint64_t sim_touch_index(uint32_t widgetId, sim_ns_t time)
+{
+    sim_ns_t phase = sim_touch_phase(widgetId);
+    uint64_t index;
+
+    if (NULL != sim_cfg.replay)
+    {
+        return sim_replay_touch_index(widgetId, time);
+    }
+    if ((widgetId >= sim_touch_widgets()) || (0u == sim_cfg.touch_period) || (time < phase))
+    {
+        return 0u;
+    }
+    index = (time - phase) / sim_cfg.touch_period;
+    if ((0u == index) || (((time - phase) % sim_cfg.touch_period) >= sim_cfg.touch_duration))
+    {
+        return 0u;
+    }
+    return index;
+}
+
+static sim_ns_t sim_touch_onset(uint32_t widgetId, uint64_t index)
+{
+    if (NULL != sim_cfg.replay)
+    {
+        return sim_replay_touch_onset(widgetId, index);
+    }
+    return sim_touch_phase(widgetId) + (index * sim_cfg.touch_period);
+}
+
+bool sim_touch_active(uint32_t widgetId, sim_ns_t time)
+{
+    return (0u != sim_touch_index(widgetId, time));
+}
+
+static void sim_latency_add(sim_latency_t * latency, sim_ns_t value)
+{
+    if ((0u == latency->count) || (value < latency->min))
+    {
+        latency->min = value;
+    }
+    if (value > latency->max)
+    {
+        latency->max = value;
+    }
+    latency->sum += value;
+    latency->count++;
+}
+
+/*******************************************************************************
+ * Function Name: sim_led_changed
+ ********************************************************************************
+ * Summary:
+ *  Records the touch-to-LED latency when the LED of a widget turns on for
+ *  the touch that was last detected on that widget.
+ *
+ *******************************************************************************/
+void sim_led_changed(uint32_t led, bool on)
+{
+    uint64_t index;
+
+    if ((!on) || (led >= CY_CAPSENSE_WIDGET_COUNT))
+    {
+        return;
+    }
+    index = sim_wd_stats[led].detected_touch;
+    if ((0u != index) && (index != sim_wd_stats[led].led_touch))
+    {
+        sim_wd_stats[led].led_touch = index;
+        sim_latency_add(&sim_led_latency, sim_now - sim_touch_onset(led, index));
+    }
+}
+
+/*******************************************************************************
+ * Function Name: sim_tuner_command
+ ********************************************************************************
+ * Summary:
+ *  Builds a tuner command packet with a valid header, CRC and tail.
+ *
+ *******************************************************************************/
+static uint16_t sim_crc16(const uint8_t * data, uint32_t size)
+{
+    uint16_t crc = 0xFFFFu;
+    uint32_t i;
+
+    while (0u != size--)
+    {
+        crc ^= (uint16_t)((uint16_t)*data++ << 8u);
+        for (i = 0u; i < 8u; i++)
+        {
+            crc = (0u != (crc & 0x8000u)) ? (uint16_t)((crc << 1u) ^ 0x1021u) : (uint16_t)(crc << 1u);
+        }
+    }
+    return crc;
+}
+
+static void sim_tuner_command(uint8_t command, uint8_t * packet)
+{
+    uint16_t crc;
+
+    memset(packet, 0, CY_CAPSENSE_COMMAND_PACKET_SIZE);
+    packet[CY_CAPSENSE_COMMAND_HEAD_0_IDX] = CY_CAPSENSE_COMMAND_HEAD_0;
+    packet[CY_CAPSENSE_COMMAND_HEAD_1_IDX] = CY_CAPSENSE_COMMAND_HEAD_1;
+    packet[CY_CAPSENSE_COMMAND_CODE_0_IDX] = command;
+    crc = sim_crc16(packet, CY_CAPSENSE_COMMAND_CRC_0_IDX);
+    packet[CY_CAPSENSE_COMMAND_CRC_0_IDX] = (uint8_t)(crc >> 8u);
+    packet[CY_CAPSENSE_COMMAND_CRC_1_IDX] = (uint8_t)crc;
+    packet[CY_CAPSENSE_COMMAND_TAIL_0_IDX] = CY_CAPSENSE_COMMAND_TAIL_0;
+    packet[CY_CAPSENSE_COMMAND_TAIL_1_IDX] = CY_CAPSENSE_COMMAND_TAIL_1;
+    packet[CY_CAPSENSE_COMMAND_TAIL_2_IDX] = CY_CAPSENSE_COMMAND_TAIL_2;
+}
+
+/*******************************************************************************
+ * Function Name: sim_capsense_init
+ ********************************************************************************
+ * Summary:
+ *  Builds the widget layout: every widget is a CSX button occupying
+ *  SIM_SLOTS_PER_WIDGET consecutive slots, with one sensor per slot and MSC
+ *  channel. Slot entries of channel n follow those of channel n - 1, as in
+ *  the generated configuration.
+ *
+ *******************************************************************************/
+void sim_capsense_init(void)
+{
+    uint32_t wd;
+    uint32_t sns;
+    uint32_t ch;
+
+    memset(&cy_capsense_tuner, 0, sizeof(cy_capsense_tuner));
+    memset(sim_debounce, 0, sizeof(sim_debounce));
+    memset(sim_sample_time, 0, sizeof(sim_sample_time));
+    memset(sim_wd_stats, 0, sizeof(sim_wd_stats));
+    memset(&sim_detect_latency, 0, sizeof(sim_detect_latency));
+    memset(&sim_led_latency, 0, sizeof(sim_led_latency));
+    memset(&sim_active_refresh, 0, sizeof(sim_active_refresh));
+    memset(&sim_sample_interval, 0, sizeof(sim_sample_interval));
+    memset(&sim_internal_context, 0, sizeof(sim_internal_context));
+
+    sim_common_config.numWd = CY_CAPSENSE_WIDGET_COUNT;
+    sim_common_config.numSns = CY_CAPSENSE_SENSOR_COUNT;
+    sim_common_config.numChannels = CY_CAPSENSE_TOTAL_CH_NUMBER;
+    sim_common_config.channelOffset = 0u;
+
+    for (wd = 0u; wd < CY_CAPSENSE_WIDGET_COUNT; wd++)
+    {
+        cy_stc_capsense_widget_context_t * wdCxt = &cy_capsense_tuner.widgetContext[wd];
+
+        sim_wd_config[wd].firstSlotId = (uint16_t)(wd * SIM_SLOTS_PER_WIDGET);
+        sim_wd_config[wd].numSlots = SIM_SLOTS_PER_WIDGET;
+        sim_wd_config[wd].numSns = SIM_SNS_PER_WIDGET;
+        sim_wd_config[wd].numCols = SIM_SNS_PER_WIDGET;
+        sim_wd_config[wd].numRows = 1u;
+        sim_wd_config[wd].wdType = CY_CAPSENSE_WD_BUTTON_E;
+        sim_wd_config[wd].senseMethod = CY_CAPSENSE_CSX_GROUP;
+        sim_wd_config[wd].ptrWdContext = wdCxt;
+        sim_wd_config[wd].ptrSnsContext = &cy_capsense_tuner.sensorContext[wd * SIM_SNS_PER_WIDGET];
+        sim_wd_config[wd].ptrEltdCapacitance = sim_eltd_cap[wd];
+
+        wdCxt->fingerTh = 100u;
+        wdCxt->proxTh = 200u;
+        wdCxt->noiseTh = 40u;
+        wdCxt->nNoiseTh = 40u;
+        wdCxt->hysteresis = 10u;
+        wdCxt->onDebounce = 3u;
+        wdCxt->lowBslnRst = 30u;
+        wdCxt->snsClk = SIM_SNS_CLK;
+        wdCxt->cdacRef = 32u;
+        wdCxt->numSubConversions = 128u;
+        wdCxt->maxRawCount = 4000u;
+        wdCxt->cdacCompDivider = SIM_CDAC_COMP_DIV_CONFIG;
+
+        for (sns = 0u; sns < SIM_SNS_PER_WIDGET; sns++)
+        {
+            ch = sns % CY_CAPSENSE_TOTAL_CH_NUMBER;
+            sim_scan_slots[(ch * CY_CAPSENSE_SLOT_COUNT) + (wd * SIM_SLOTS_PER_WIDGET) +
+                           (sns / CY_CAPSENSE_TOTAL_CH_NUMBER)].wdId = (uint16_t)wd;
+            sim_scan_slots[(ch * CY_CAPSENSE_SLOT_COUNT) + (wd * SIM_SLOTS_PER_WIDGET) +
+                           (sns / CY_CAPSENSE_TOTAL_CH_NUMBER)].snsId = (uint16_t)sns;
+        }
+    }
+
+    sim_msc_busy = false;
+    sim_msc_event = SIM_NEVER;
+    memset(sim_msc_irq_raised, 0, sizeof(sim_msc_irq_raised));
+    sim_msc_channels_left = 0u;
+    sim_tuner_ping = sim_cfg.tuner_host ? SIM_TUNER_PING_PERIOD : SIM_NEVER;
+
+    if (NULL != sim_cfg.replay)
+    {
+        sim_replay_load();
+    }
+}
+
+/*******************************************************************************
+ * Function Name: sim_msc_next_event
+ ********************************************************************************
+ * Summary:
+ *  Returns the time of the next MSC or tuner host event.
+ *
+ *******************************************************************************/
+sim_ns_t sim_msc_next_event(void)
+{
+    return (sim_tuner_ping < sim_msc_event) ? sim_tuner_ping : sim_msc_event;
+}
+
+/*******************************************************************************
+ * Function Name: sim_msc_update
+ ********************************************************************************
+ * Summary:
+ *  Completes the conversion of the current slot on every channel and raises
+ *  the MSC interrupt of each channel. The raw count scales with the sense
+ *  clock divider of the widget, and a divider equal to SIM_EMI_SNS_CLK adds
+ *  the interference.
+ *  A replay takes the recorded raw count without noise. Also lets the
+ *  simulated tuner host send its periodic command.
+ *
+ *******************************************************************************/
+void sim_msc_update(void)
+{
+    if (sim_now >= sim_msc_event)
+    {
+        uint32_t ch;
+
+        for (ch = 0u; ch < CY_CAPSENSE_TOTAL_CH_NUMBER; ch++)
+        {
+            const cy_stc_capsense_scan_slot_t * slot = &sim_scan_slots[(ch * CY_CAPSENSE_SLOT_COUNT) + sim_msc_slot];
+            uint32_t wd = slot->wdId;
+
+            if (NULL != sim_cfg.replay)
+            {
+                sim_msc_sample[ch] = sim_replay_raw(wd, slot->snsId, sim_now);
+            }
+            else
+            {
+                uint32_t snsClk = cy_capsense_tuner.widgetContext[wd].snsClk;
+                uint32_t compDiv = cy_capsense_tuner.widgetContext[wd].cdacCompDivider;
+                uint32_t cdacComp = cy_capsense_tuner.sensorContext[(wd * SIM_SNS_PER_WIDGET) + slot->snsId].cdacComp;
+                int32_t noise = (0u != sim_cfg.noise) ?
+                    ((int32_t)(sim_rand() % ((2u * sim_cfg.noise) + 1u)) - (int32_t)sim_cfg.noise) : 0;
+                int32_t level = (int32_t)SIM_RAW_BASE + (int32_t)(wd % 16u) +
+                    (sim_touch_active(wd, sim_now) ? (int32_t)SIM_RAW_TOUCH_SIGNAL : 0);
+
+                if ((snsClk == sim_cfg.emi_sns_clk) && (0u != sim_cfg.emi_noise))
+                {
+                    noise += (int32_t)(sim_rand() % ((2u * sim_cfg.emi_noise) + 1u)) - (int32_t)sim_cfg.emi_noise;
+                }
+                /* The compensation removes cdacComp / cdacCompDivider of the charge; the
+                 * calibration balances it, any other divider shifts the raw count.
+                 */
+                if (0u != compDiv)
+                {
+                    level += ((int32_t)SIM_CDAC_COMP - (int32_t)((cdacComp * SIM_CDAC_COMP_DIV) / compDiv)) *
+                        SIM_CDAC_COMP_STEP;
+                }
+                level = ((level * (int32_t)snsClk) / (int32_t)SIM_SNS_CLK) + noise;
+                sim_msc_sample[ch] = (uint16_t)((level > 0) ? level : 0);
+            }
+            sim_msc_irq_raised[ch] = true;
+            sim_set_pending((0u == ch) ? CY_MSC0_IRQ : CY_MSC1_IRQ);
+        }
+        sim_msc_event = SIM_NEVER;
+        sim_msc_channels_left = CY_CAPSENSE_TOTAL_CH_NUMBER;
+    }
+
+    if (sim_now >= sim_tuner_ping)
+    {
+        uint8_t packet[CY_CAPSENSE_COMMAND_PACKET_SIZE];
+        sim_tuner_command(CY_CAPSENSE_TU_CMD_PING_E, packet);
+        sim_uart_host_inject(packet, sizeof(packet));
+        sim_tuner_ping += SIM_TUNER_PING_PERIOD;
+    }
+}
+
+static void sim_msc_start_slot(uint32_t slot)
+{
+    sim_msc_slot = slot;
+    sim_active_scan_sns.widgetIndex = sim_scan_slots[slot].wdId;
+    sim_active_scan_sns.sensorIndex = sim_scan_slots[slot].snsId;
+    sim_msc_event = sim_now + sim_cfg.slot_scan + sim_cfg.irq_latency;
+    sim_stats.msc_busy += sim_cfg.slot_scan;
+}
+
+/*******************************************************************************
+ * Middleware API
+ *******************************************************************************/
+cy_capsense_status_t Cy_CapSense_Init(cy_stc_capsense_context_t * context)
+{
+    sim_cpu(100u * SIM_NS_PER_US);
+    context->ptrCommonContext->tunerSt = sim_cfg.tuner_suspended ? CY_CAPSENSE_TU_FSM_SUSPENDED :
+                                                                   CY_CAPSENSE_TU_FSM_RUNNING;
+    return CY_CAPSENSE_STATUS_SUCCESS;
+}
+
+cy_capsense_status_t Cy_CapSense_Initialize(cy_stc_capsense_context_t * context)
+{
+    uint32_t wd;
+
+    (void)context;
+    sim_cpu(50u * SIM_NS_PER_US);
+
+    /* Back to the configured divider, as with CSX_COMP_DIV_MODE=AUTO */
+    for (wd = 0u; wd < CY_CAPSENSE_WIDGET_COUNT; wd++)
+    {
+        cy_capsense_tuner.widgetContext[wd].cdacCompDivider = SIM_CDAC_COMP_DIV_CONFIG;
+    }
+    return CY_CAPSENSE_STATUS_SUCCESS;
+}
+
+cy_capsense_status_t Cy_CapSense_Enable(cy_stc_capsense_context_t * context)
+{
+    uint32_t sns;
+    uint32_t wd;
+
+    (void)Cy_CapSense_Initialize(context);
+
+    /* Calibration scans every slot several times */
+    sim_cpu(8u * CY_CAPSENSE_SLOT_COUNT * sim_cfg.slot_scan);
+    for (sns = 0u; sns < CY_CAPSENSE_SENSOR_COUNT; sns++)
+    {
+        cy_capsense_tuner.sensorContext[sns].raw = (NULL != sim_cfg.replay) ?
+            sim_replay_raw(sns / SIM_SNS_PER_WIDGET, sns % SIM_SNS_PER_WIDGET, 0u) :
+            (uint16_t)(SIM_RAW_BASE + ((sns / SIM_SNS_PER_WIDGET) % 16u));
+        cy_capsense_tuner.sensorContext[sns].cdacComp = SIM_CDAC_COMP;
+    }
+    for (wd = 0u; wd < CY_CAPSENSE_WIDGET_COUNT; wd++)
+    {
+        cy_capsense_tuner.widgetContext[wd].cdacCompDivider = SIM_CDAC_COMP_DIV;
+    }
+    Cy_CapSense_InitializeAllBaselines(context);
+    return CY_CAPSENSE_STATUS_SUCCESS;
+}
+
+void Cy_CapSense_InitializeAllBaselines(cy_stc_capsense_context_t * context)
+{
+    uint32_t sns;
+
+    (void)context;
+    sim_cpu(sim_cfg.api);
+    for (sns = 0u; sns < CY_CAPSENSE_SENSOR_COUNT; sns++)
+    {
+        cy_capsense_tuner.sensorContext[sns].bsln = cy_capsense_tuner.sensorContext[sns].raw;
+    }
+}
+
+cy_capsense_status_t Cy_CapSense_ScanSlots(uint32_t startSlotId, uint32_t numberSlots,
+                                           cy_stc_capsense_context_t * context)
+{
+    sim_cpu(sim_cfg.api);
+
+    if ((0u == numberSlots) || ((startSlotId + numberSlots) > CY_CAPSENSE_SLOT_COUNT))
+    {
+        return CY_CAPSENSE_STATUS_BAD_PARAM;
+    }
+    if (sim_msc_busy)
+    {
+        return CY_CAPSENSE_STATUS_HW_BUSY;
+    }
+
+    sim_msc_busy = true;
+    context->ptrCommonContext->status |= CY_CAPSENSE_BUSY;
+    sim_msc_last_slot = startSlotId + numberSlots - 1u;
+    sim_stats.scans++;
+    if ((NULL != sim_cfg.replay) && (1u == sim_stats.scans))
+    {
+        sim_replay_start();
+    }
+
+    /* Block configuration and analog wake-up */
+    sim_cpu(sim_cfg.scan_setup);
+    sim_msc_start_slot(startSlotId);
+    return CY_CAPSENSE_STATUS_SUCCESS;
+}
+
+cy_capsense_status_t Cy_CapSense_ScanAllSlots(cy_stc_capsense_context_t * context)
+{
+    return Cy_CapSense_ScanSlots(0u, CY_CAPSENSE_SLOT_COUNT, context);
+}
+
+uint32_t Cy_CapSense_IsBusy(const cy_stc_capsense_context_t * context)
+{
+    sim_cpu(sim_cfg.api);
+    return context->ptrCommonContext->status & CY_CAPSENSE_BUSY;
+}
+
+void Cy_CapSense_InterruptHandler(void * base, cy_stc_capsense_context_t * context)
+{
+    uint32_t ch = (msc_1_msc_0_HW == base) ? 1u : 0u;
+    const cy_stc_capsense_scan_slot_t * slot;
+
+    if ((ch >= CY_CAPSENSE_TOTAL_CH_NUMBER) || !sim_msc_irq_raised[ch])
+    {
+        return;
+    }
+    sim_msc_irq_raised[ch] = false;
+    sim_stats.msc_interrupts++;
+    sim_cpu(sim_cfg.isr);
+
+    slot = &sim_scan_slots[(ch * CY_CAPSENSE_SLOT_COUNT) + sim_msc_slot];
+    cy_capsense_tuner.sensorContext[(slot->wdId * SIM_SNS_PER_WIDGET) + slot->snsId].raw = sim_msc_sample[ch];
+    sim_sample_time[sim_msc_slot] = sim_now;
+
+    /* The slot completes with the interrupt of the last channel */
+    if (0u != --sim_msc_channels_left)
+    {
+        return;
+    }
+    if (sim_msc_slot < sim_msc_last_slot)
+    {
+        sim_msc_start_slot(sim_msc_slot + 1u);
+    }
+    else
+    {
+        sim_msc_busy = false;
+        context->ptrCommonContext->status &= ~(uint32_t)CY_CAPSENSE_BUSY;
+        context->ptrCommonContext->scanCounter++;
+        if (NULL != context->ptrInternalContext->ptrEOSCallback)
+        {
+            context->ptrInternalContext->ptrEOSCallback(context->ptrActiveScanSns);
+        }
+    }
+}
+
+cy_capsense_status_t Cy_CapSense_RegisterCallback(cy_en_capsense_callback_event_t callbackType,
+                                                  cy_capsense_callback_t callbackFunction,
+                                                  cy_stc_capsense_context_t * context)
+{
+    if ((NULL == callbackFunction) || (NULL == context))
+    {
+        return CY_CAPSENSE_STATUS_BAD_PARAM;
+    }
+    if (CY_CAPSENSE_START_SAMPLE_E == callbackType)
+    {
+        context->ptrInternalContext->ptrSSCallback = callbackFunction;
+    }
+    else
+    {
+        context->ptrInternalContext->ptrEOSCallback = callbackFunction;
+    }
+    return CY_CAPSENSE_STATUS_SUCCESS;
+}
+
+cy_capsense_status_t Cy_CapSense_ProcessWidget(uint32_t widgetId, cy_stc_capsense_context_t * context)
+{
+    const cy_stc_capsense_widget_config_t * ptrWdCfg;
+    cy_stc_capsense_widget_context_t * ptrWdCxt;
+    sim_widget_stats_t * stats;
+    uint32_t sns;
+    uint8_t status = 0u;
+    bool wasActive;
+
+    if (widgetId >= context->ptrCommonConfig->numWd)
+    {
+        return CY_CAPSENSE_STATUS_BAD_PARAM;
+    }
+
+    ptrWdCfg = &context->ptrWdConfig[widgetId];
+    ptrWdCxt = ptrWdCfg->ptrWdContext;
+    if ((NULL != sim_cfg.replay) && sim_replay_done(sim_sample_time[ptrWdCfg->firstSlotId]))
+    {
+        /* The raw counts of the trace are used up */
+        sim_finish(0);
+    }
+    sim_cpu(sim_cfg.process[widgetId % (sizeof(sim_cfg.process) / sizeof(sim_cfg.process[0u]))]);
+
+    for (sns = 0u; sns < ptrWdCfg->numSns; sns++)
+    {
+        cy_stc_capsense_sensor_context_t * ptrSns = &ptrWdCfg->ptrSnsContext[sns];
+        uint8_t * debounce = &sim_debounce[(widgetId * SIM_SNS_PER_WIDGET) + sns];
+        int32_t diff = (int32_t)ptrSns->raw - (int32_t)ptrSns->bsln;
+
+        ptrSns->diff = (diff > 0) ? (uint16_t)diff : 0u;
+
+        /* Baseline follows the raw count while the signal is within noise */
+        if ((diff < (int32_t)ptrWdCxt->noiseTh) && (diff > -(int32_t)ptrWdCxt->nNoiseTh))
+        {
+            ptrSns->bsln = (uint16_t)((int32_t)ptrSns->bsln + (diff / 8));
+        }
+        else if (diff <= -(int32_t)ptrWdCxt->nNoiseTh)
+        {
+            if (++ptrSns->negBslnRstCnt >= ptrWdCxt->lowBslnRst)
+            {
+                ptrSns->bsln = ptrSns->raw;
+                ptrSns->negBslnRstCnt = 0u;
+            }
+        }
+
+        if (0u != (ptrSns->status & CY_CAPSENSE_SNS_TOUCH_STATUS_MASK))
+        {
+            if (ptrSns->diff < (ptrWdCxt->fingerTh - ptrWdCxt->hysteresis))
+            {
+                ptrSns->status &= (uint8_t)~CY_CAPSENSE_SNS_TOUCH_STATUS_MASK;
+                *debounce = 0u;
+            }
+        }
+        else if (ptrSns->diff > (ptrWdCxt->fingerTh + ptrWdCxt->hysteresis))
+        {
+            if (++(*debounce) >= ptrWdCxt->onDebounce)
+            {
+                ptrSns->status |= CY_CAPSENSE_SNS_TOUCH_STATUS_MASK;
+            }
+        }
+        else
+        {
+            *debounce = 0u;
+        }
+        status |= (uint8_t)(ptrSns->status & CY_CAPSENSE_SNS_TOUCH_STATUS_MASK);
+    }
+
+    /* Statistics: a detection is attributed to the touch that was in
+     * progress when the widget was sampled.
+     */
+    stats = &sim_wd_stats[widgetId];
+    if ((0u != status) && (0u == (ptrWdCxt->status & CY_CAPSENSE_WD_ACTIVE_MASK)))
+    {
+        uint64_t index = sim_touch_index(widgetId, sim_sample_time[ptrWdCfg->firstSlotId]);
+        if (0u == index)
+        {
+            stats->false_touches++;
+        }
+        else if (index != stats->detected_touch)
+        {
+            stats->detected_touch = index;
+            stats->detections++;
+            sim_latency_add(&sim_detect_latency, sim_now - sim_touch_onset(widgetId, index));
+        }
+    }
+    wasActive = (0u != (ptrWdCxt->status & CY_CAPSENSE_WD_ACTIVE_MASK));
+    ptrWdCxt->status = (0u != status) ? CY_CAPSENSE_WD_ACTIVE_MASK : 0u;
+
+    if ((0u != stats->processed) && ((sim_now - stats->last_processed) > stats->max_refresh))
+    {
+        stats->max_refresh = sim_now - stats->last_processed;
+    }
+    if ((0u != stats->processed) && (0u != status) && wasActive)
+    {
+        /* Refresh interval of a widget that is tracking a touch */
+        sim_latency_add(&sim_active_refresh, sim_now - stats->last_processed);
+    }
+    if (0u != stats->processed)
+    {
+        /* Interval between the samples of the widget seen by the application */
+        sim_latency_add(&sim_sample_interval, sim_sample_time[ptrWdCfg->firstSlotId] - stats->last_sample);
+    }
+    stats->last_processed = sim_now;
+    stats->last_sample = sim_sample_time[ptrWdCfg->firstSlotId];
+    stats->processed++;
+    sim_stats.processed++;
+    if (sim_stats.processed == context->ptrCommonConfig->numWd)
+    {
+        sim_stats.first_frame = sim_now;
+    }
+
+    if ((NULL == sim_cfg.replay) &&
+        (sim_stats.processed >= ((uint64_t)sim_cfg.frames * context->ptrCommonConfig->numWd)))
+    {
+        sim_finish(0);
+    }
+    return CY_CAPSENSE_STATUS_SUCCESS;
+}
+
+cy_capsense_status_t Cy_CapSense_ProcessAllWidgets(cy_stc_capsense_context_t * context)
+{
+    uint32_t wd;
+
+    for (wd = 0u; wd < context->ptrCommonConfig->numWd; wd++)
+    {
+        (void)Cy_CapSense_ProcessWidget(wd, context);
+    }
+    return CY_CAPSENSE_STATUS_SUCCESS;
+}
+
+uint32_t Cy_CapSense_IsWidgetActive(uint32_t widgetId, const cy_stc_capsense_context_t * context)
+{
+    sim_cpu(sim_cfg.api);
+    return (uint32_t)context->ptrWdConfig[widgetId].ptrWdContext->status & CY_CAPSENSE_WD_ACTIVE_MASK;
+}
+
+uint32_t Cy_CapSense_IsAnyWidgetActive(const cy_stc_capsense_context_t * context)
+{
+    uint32_t wd;
+    uint32_t active = 0u;
+
+    sim_cpu(sim_cfg.api);
+    for (wd = 0u; wd < context->ptrCommonConfig->numWd; wd++)
+    {
+        active |= (uint32_t)context->ptrWdConfig[wd].ptrWdContext->status & CY_CAPSENSE_WD_ACTIVE_MASK;
+    }
+    return active;
+}
+
+uint32_t Cy_CapSense_CheckTunerCmdIntegrity(const uint8_t * commandPacket)
+{
+    uint16_t crc;
+
+    sim_cpu(sim_cfg.api);
+    if ((CY_CAPSENSE_COMMAND_HEAD_0 != commandPacket[CY_CAPSENSE_COMMAND_HEAD_0_IDX]) ||
+        (CY_CAPSENSE_COMMAND_HEAD_1 != commandPacket[CY_CAPSENSE_COMMAND_HEAD_1_IDX]))
+    {
+        return CY_CAPSENSE_WRONG_HEADER;
+    }
+    if ((CY_CAPSENSE_COMMAND_TAIL_0 != commandPacket[CY_CAPSENSE_COMMAND_TAIL_0_IDX]) ||
+        (CY_CAPSENSE_COMMAND_TAIL_1 != commandPacket[CY_CAPSENSE_COMMAND_TAIL_1_IDX]) ||
+        (CY_CAPSENSE_COMMAND_TAIL_2 != commandPacket[CY_CAPSENSE_COMMAND_TAIL_2_IDX]))
+    {
+        return CY_CAPSENSE_WRONG_TAIL;
+    }
+    crc = sim_crc16(commandPacket, CY_CAPSENSE_COMMAND_CRC_0_IDX);
+    if ((commandPacket[CY_CAPSENSE_COMMAND_CRC_0_IDX] != (uint8_t)(crc >> 8u)) ||
+        (commandPacket[CY_CAPSENSE_COMMAND_CRC_1_IDX] != (uint8_t)crc))
+    {
+        return CY_CAPSENSE_WRONG_CRC;
+    }
+    return CY_CAPSENSE_COMMAND_OK;
+}
+
+uint32_t Cy_CapSense_RunTuner(cy_stc_capsense_context_t * context)
+{
+    cy_stc_capsense_internal_context_t * ptrIntrCxt = context->ptrInternalContext;
+    cy_stc_capsense_common_context_t * ptrCommonCxt = context->ptrCommonContext;
+    uint8_t * commandPacket = NULL;
+    uint8_t * tunerPacket = NULL;
+    uint32_t command = CY_CAPSENSE_TU_CMD_NONE_E;
+
+    sim_cpu(4u * sim_cfg.api);
+
+    if (NULL != ptrIntrCxt->ptrTunerReceiveCallback)
+    {
+        ptrIntrCxt->ptrTunerReceiveCallback(&commandPacket, &tunerPacket, context);
+    }
+    if ((NULL != commandPacket) && (CY_CAPSENSE_COMMAND_OK == Cy_CapSense_CheckTunerCmdIntegrity(commandPacket)))
+    {
+        command = commandPacket[CY_CAPSENSE_COMMAND_CODE_0_IDX];
+        sim_stats.tuner_commands++;
+        ptrCommonCxt->tunerCmd = (uint16_t)command;
+        if (CY_CAPSENSE_TU_CMD_SUSPEND_E == command)
+        {
+            ptrCommonCxt->tunerSt = CY_CAPSENSE_TU_FSM_SUSPENDED;
+        }
+        else if ((CY_CAPSENSE_TU_CMD_RESUME_E == command) || (CY_CAPSENSE_TU_CMD_RESTART_E == command))
+        {
+            ptrCommonCxt->tunerSt = CY_CAPSENSE_TU_FSM_RUNNING;
+        }
+    }
+
+    if ((CY_CAPSENSE_TU_FSM_RUNNING == ptrCommonCxt->tunerSt) && (NULL != ptrIntrCxt->ptrTunerSendCallback))
+    {
+        ptrIntrCxt->ptrTunerSendCallback(context);
+    }
+    return command;
+}
+
+cy_en_capsense_bist_status_t Cy_CapSense_CheckIntegritySensorPins(uint32_t widgetId, uint32_t sensorId,
+                                                                  cy_stc_capsense_context_t * context)
+{
+    if ((widgetId >= context->ptrCommonConfig->numWd) || (sensorId >= context->ptrWdConfig[widgetId].numSns))
+    {
+        return CY_CAPSENSE_BIST_BAD_PARAM_E;
+    }
+    if (sim_msc_busy)
+    {
+        return CY_CAPSENSE_BIST_HW_BUSY_E;
+    }
+
+    /* Each pin is driven and read back against ground, supply and the other pins */
+    sim_cpu(sim_cfg.bist_pins);
+    return (widgetId == sim_cfg.bist_short) ? CY_CAPSENSE_BIST_FAIL_E : CY_CAPSENSE_BIST_SUCCESS_E;
+}
+
+cy_en_capsense_bist_status_t Cy_CapSense_MeasureCapacitanceSensorElectrode(uint32_t widgetId, uint32_t eltdId,
+                                                                           cy_stc_capsense_context_t * context)
+{
+    const cy_stc_capsense_widget_config_t * ptrWdCfg;
+
+    if (widgetId >= context->ptrCommonConfig->numWd)
+    {
+        return CY_CAPSENSE_BIST_BAD_PARAM_E;
+    }
+    ptrWdCfg = &context->ptrWdConfig[widgetId];
+    if (eltdId >= ((uint32_t)ptrWdCfg->numCols + ptrWdCfg->numRows))
+    {
+        return CY_CAPSENSE_BIST_BAD_PARAM_E;
+    }
+    if (sim_msc_busy)
+    {
+        return CY_CAPSENSE_BIST_HW_BUSY_E;
+    }
+
+    /* Blocking conversion on the MSC block */
+    sim_stats.msc_busy += sim_cfg.bist_cap;
+    sim_cpu(sim_cfg.bist_cap);
+    ptrWdCfg->ptrEltdCapacitance[eltdId] = SIM_ELTD_CAPACITANCE_FF + ((widgetId % 16u) * 100u);
+    return CY_CAPSENSE_BIST_SUCCESS_E;
+}
+
+cy_en_capsense_bist_status_t Cy_CapSense_CheckIntegritySensorBaseline(uint32_t widgetId, uint32_t sensorId,
+                                                                      uint16_t baselineHighLimit,
+                                                                      uint16_t baselineLowLimit,
+                                                                      cy_stc_capsense_context_t * context)
+{
+    uint16_t bsln;
+
+    if ((widgetId >= context->ptrCommonConfig->numWd) || (sensorId >= context->ptrWdConfig[widgetId].numSns))
+    {
+        return CY_CAPSENSE_BIST_BAD_PARAM_E;
+    }
+
+    sim_cpu(sim_cfg.api);
+    bsln = context->ptrWdConfig[widgetId].ptrSnsContext[sensorId].bsln;
+    if (bsln < baselineLowLimit)
+    {
+        return CY_CAPSENSE_BIST_LOW_LIMIT_E;
+    }
+    return (bsln > baselineHighLimit) ? CY_CAPSENSE_BIST_HIGH_LIMIT_E : CY_CAPSENSE_BIST_SUCCESS_E;
+}
+
+/*******************************************************************************
+ * Function Name: sim_capsense_report
+ ********************************************************************************
+ * Summary:
+ *  Prints frame rate, refresh interval and latency statistics.
+ *
+ *******************************************************************************/
+static void sim_latency_print(const char * name, const sim_latency_t * latency)
+{
+    if (0u == latency->count)
+    {
+        printf("%-21s n/a\n", name);
+        return;
+    }
+    printf("%-21s mean %.3f ms  min %.3f ms  max %.3f ms  (%llu samples)\n", name,
+           ((double)latency->sum / (double)latency->count) / (double)SIM_NS_PER_MS,
+           (double)latency->min / (double)SIM_NS_PER_MS, (double)latency->max / (double)SIM_NS_PER_MS,
+           (unsigned long long)latency->count);
+}
+
+void sim_capsense_report(void)
+{
+    double seconds = (double)((0u != sim_now) ? sim_now : 1u) / (double)SIM_NS_PER_S;
+    double frames = (double)sim_stats.processed / CY_CAPSENSE_WIDGET_COUNT;
+    double charge;
+    sim_ns_t max_refresh = 0u;
+    uint64_t expected = 0u;
+    uint64_t detected = 0u;
+    uint32_t false_touches = 0u;
+    uint32_t wd;
+
+    for (wd = 0u; wd < CY_CAPSENSE_WIDGET_COUNT; wd++)
+    {
+        sim_ns_t phase = sim_touch_phase(wd);
+
+        if (sim_wd_stats[wd].max_refresh > max_refresh)
+        {
+            max_refresh = sim_wd_stats[wd].max_refresh;
+        }
+        if (NULL != sim_cfg.replay)
+        {
+            /* Touches the target reported */
+            expected += sim_replay_touches(wd);
+            detected += (sim_wd_stats[wd].detections < sim_replay_touches(wd)) ?
+                sim_wd_stats[wd].detections : sim_replay_touches(wd);
+        }
+        else if ((wd < sim_touch_widgets()) && (0u != sim_cfg.touch_period) &&
+            (sim_now > (phase + sim_cfg.touch_duration)))
+        {
+            /* Touches that ended before the end of the run */
+            uint64_t ended = (sim_now - phase - sim_cfg.touch_duration) / sim_cfg.touch_period;
+            expected += ended;
+            detected += (sim_wd_stats[wd].detections < ended) ? sim_wd_stats[wd].detections : ended;
+        }
+        false_touches += sim_wd_stats[wd].false_touches;
+    }
+
+    printf("widgets               %u (%u slots, %u channels)\n", (unsigned)CY_CAPSENSE_WIDGET_COUNT,
+           (unsigned)CY_CAPSENSE_SLOT_COUNT, (unsigned)CY_CAPSENSE_TOTAL_CH_NUMBER);
+    printf("frames                %.1f (%.1f frames/s)\n",
+           frames, frames / seconds);
+    printf("scans                 %u (%u msc interrupts)\n", sim_stats.scans, sim_stats.msc_interrupts);
+    printf("first frame           %.3f ms\n", (double)sim_stats.first_frame / (double)SIM_NS_PER_MS);
+    {
+        const scan_schedule_stats_t * schedule = scan_schedule_get_stats();
+
+        printf("batches               %u (%u balanced tables, frame scan %u us, process %u us, period %u us)\n",
+               (unsigned)schedule->numGroups, (unsigned)schedule->balances, (unsigned)schedule->frameScanUs,
+               (unsigned)schedule->frameProcessUs, (unsigned)schedule->periodUs);
+    }
+
+    /* CPU charge in nC; the MSC current does not depend on the sleep mode */
+    charge = (((double)sim_stats.active * sim_cfg.active_ua) + ((double)sim_stats.sleep * sim_cfg.sleep_ua) +
+              ((double)sim_stats.deepsleep * sim_cfg.deepsleep_ua)) / 1000000.0;
+    printf("cpu charge            %.1f nC per frame (%.1f uA average)\n",
+           (frames > 0.0) ? (charge / frames) : 0.0, charge / (seconds * 1000.0));
+    printf("cpu busy              %.1f us per frame\n",
+           (frames > 0.0) ? (((double)sim_stats.active / (double)SIM_NS_PER_US) / frames) : 0.0);
+    printf("max refresh interval  %.3f ms\n", (double)max_refresh / (double)SIM_NS_PER_MS);
+    sim_latency_print("touch to detect", &sim_detect_latency);
+    sim_latency_print("touch to LED", &sim_led_latency);
+    sim_latency_print("active refresh", &sim_active_refresh);
+    sim_latency_print("sample interval", &sim_sample_interval);
+    printf("missed touches        %llu of %llu\n", (unsigned long long)(expected - detected),
+           (unsigned long long)expected);
+    printf("false touches         %u\n", false_touches);
+    if (NULL != sim_cfg.replay)
+    {
+        sim_replay_report(frames);
+    }
+    if (sim_cfg.tuner_host)
+    {
+        printf("tuner commands        %llu\n", (unsigned long long)sim_stats.tuner_commands);
+    }
+#if (0u != SELF_TEST_ENABLE)
+    {
+        const self_test_stats_t * selfTest = self_test_get_stats();
+
+        printf("self test passes      %u (coverage %u ms, max %u ms)\n", (unsigned)selfTest->passes,
+               (unsigned)selfTest->coverageMs, (unsigned)selfTest->maxCoverageMs);
+        printf("self test steps       %u (%u deferred, %u failed)\n", (unsigned)selfTest->steps,
+               (unsigned)selfTest->deferred, (unsigned)selfTest->failures);
+        if (0u != selfTest->failures)
+        {
+            printf("self test last fault  check %u widget %u index %u status 0x%x\n",
+                   (unsigned)selfTest->lastFault.check, (unsigned)selfTest->lastFault.widgetId,
+                   (unsigned)selfTest->lastFault.index, (unsigned)selfTest->lastFault.status);
+        }
+    }
+#endif /* SELF_TEST_ENABLE */
+#if (0u != WARM_START_ENABLE)
+    {
+        static const char * const result[] =
+        {
+            "restored", "no record", "config changed", "out of range", "drift", "scan failed"
+        };
+        const warm_start_stats_t * warmStart = warm_start_get_stats();
+
+        printf("warm start            %s (restore %u us)\n", result[warmStart->result],
+               (unsigned)warmStart->restoreUs);
+        printf("warm start saves      %u rows (%u errors)\n", (unsigned)warmStart->rowsWritten,
+               (unsigned)warmStart->writeErrors);
+    }
+#endif /* WARM_START_ENABLE */
+#if (0u != MULTI_FREQ_ENABLE)
+    {
+        const multi_freq_stats_t * multiFreq = multi_freq_get_stats();
+
+        printf("frequency channels    %u / %u / %u widget scans (%u results outvoted)\n",
+               (unsigned)multiFreq->scans[0u], (unsigned)multiFreq->scans[1u], (unsigned)multiFreq->scans[2u],
+               (unsigned)multiFreq->outvoted);
+    }
+#endif /* MULTI_FREQ_ENABLE */
+#if (0u != FRAME_GOVERNOR_ENABLE)
+    {
+        const frame_governor_stats_t * governor = frame_governor_get_stats();
+
+        printf("governed frames       %u (%u overruns, frame time mean %u us, max %u us)\n",
+               (unsigned)governor->frames, (unsigned)governor->overruns, (unsigned)governor->frameUs,
+               (unsigned)governor->maxFrameUs);
+        printf("frame period          mean %u us  min %u us  max %u us  (jitter %u us)\n",
+               (unsigned)governor->periodUs, (unsigned)governor->minPeriodUs, (unsigned)governor->maxPeriodUs,
+               (unsigned)governor->jitterUs);
+    }
+#endif /* FRAME_GOVERNOR_ENABLE */
+#if (0u != BENCH_ENABLE)
+    {
+        const bench_result_t * bench = bench_get_result();
+
+        printf("scan to result        mean %u us  max %u us  (last of %u windows)\n", (unsigned)bench->latencyUs,
+               (unsigned)bench->maxLatencyUs, (unsigned)bench->windows);
+    }
+#endif /* BENCH_ENABLE */
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,434 @@
+/******************************************************************************
+ * File Name: sim_core.c
+ *
+ * Description: Virtual clock, interrupt delivery model and run-time
+ * configuration of the host simulator. CPU work advances the clock in steps
+ * that stop at every pending hardware event, so interrupts preempt the main
+ * loop at the time they are raised. Low-power modes skip the clock forward to
+ * the next event.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sim.h"
+
+/*******************************************************************************
+ * Global Definitions
+ *******************************************************************************/
+sim_ns_t sim_now = 0u;
+sim_config_t sim_cfg;
+sim_stats_t sim_stats;
+
+static cy_israddress sim_isr_table[SIM_IRQ_COUNT];
+static bool sim_irq_enabled[SIM_IRQ_COUNT];
+static bool sim_irq_pending[SIM_IRQ_COUNT];
+static bool sim_irq_masked = true;
+static bool sim_in_isr = false;
+static uint32_t sim_rand_state = 1u;
+
+/*******************************************************************************
+ * Function Name: sim_env_u32
+ ********************************************************************************
+ * Summary:
+ *  Reads an unsigned integer from the environment.
+ *
+ *******************************************************************************/
+static uint32_t sim_env_u32(const char * name, uint32_t def)
+{
+    const char * value = getenv(name);
+    return ((NULL != value) && ('\0' != value[0])) ? (uint32_t)strtoul(value, NULL, 0) : def;
+}
+
+/*******************************************************************************
+ * Function Name: sim_env_us
+ ********************************************************************************
+ * Summary:
+ *  Reads a duration given in (fractional) microseconds from the environment.
+ *
+ *******************************************************************************/
+static sim_ns_t sim_env_us(const char * name, double def)
+{
+    const char * value = getenv(name);
+    double us = ((NULL != value) && ('\0' != value[0])) ? strtod(value, NULL) : def;
+    return (sim_ns_t)(us * (double)SIM_NS_PER_US);
+}
+
+/*******************************************************************************
+ * Function Name: sim_init
+ ********************************************************************************
+ * Summary:
+ *  Resets the virtual clock and reads the configuration. SIM_PROCESS_US
+ *  accepts a comma-separated list of per-widget costs; the last value is
+ *  repeated for the remaining widgets.
+ *
+ *******************************************************************************/
+void sim_init(void)
+{
+    const char * list;
+    double cost = 60.0;
+    uint32_t i;
+
+    sim_now = 0u;
+    memset(&sim_stats, 0, sizeof(sim_stats));
+    memset(&sim_cfg, 0, sizeof(sim_cfg));
+
+    sim_cfg.frames = sim_env_u32("SIM_FRAMES", 1000u);
+    sim_cfg.max_time = (sim_ns_t)sim_env_u32("SIM_MAX_TIME_MS", 60000u) * SIM_NS_PER_MS;
+    sim_cfg.slot_scan = sim_env_us("SIM_SLOT_SCAN_US", 250.0);
+    sim_cfg.scan_setup = sim_env_us("SIM_SCAN_SETUP_US", 25.0);
+    sim_cfg.irq_latency = sim_env_us("SIM_IRQ_LATENCY_US", 2.0);
+    sim_cfg.isr = sim_env_us("SIM_ISR_US", 8.0);
+    sim_cfg.api = sim_env_us("SIM_API_US", 0.5);
+    sim_cfg.ilo_hz = sim_env_u32("SIM_ILO_HZ", 40000u);
+    sim_cfg.wdt_match = sim_env_u32("SIM_WDT_MATCH", 4096u);
+    sim_cfg.ilo_meas = sim_env_us("SIM_ILO_MEAS_US", 100.0);
+    sim_cfg.deepsleep_wake = sim_env_us("SIM_DEEPSLEEP_WAKE_US", 35.0);
+    sim_cfg.sleep_wake = sim_env_us("SIM_SLEEP_WAKE_US", 1.0);
+    sim_cfg.uart_baud = sim_env_u32("SIM_UART_BAUD", 115200u);
+    sim_cfg.tuner_host = (0u != sim_env_u32("SIM_TUNER_HOST", 0u));
+    sim_cfg.tuner_suspended = (0u != sim_env_u32("SIM_TUNER_SUSPEND", 0u));
+    sim_cfg.active_ua = (double)sim_env_u32("SIM_ACTIVE_UA", 2500u);
+    sim_cfg.sleep_ua = (double)sim_env_u32("SIM_SLEEP_UA", 1200u);
+    sim_cfg.deepsleep_ua = (double)sim_env_u32("SIM_DEEPSLEEP_UA", 3u);
+    sim_cfg.touch_period = (sim_ns_t)sim_env_u32("SIM_TOUCH_PERIOD_MS", 100u) * SIM_NS_PER_MS;
+    sim_cfg.touch_duration = (sim_ns_t)sim_env_u32("SIM_TOUCH_MS", 40u) * SIM_NS_PER_MS;
+    sim_cfg.touch_widgets = sim_env_u32("SIM_TOUCH_WIDGETS", UINT32_MAX);
+    sim_cfg.noise = sim_env_u32("SIM_NOISE", 5u);
+    sim_cfg.emi_sns_clk = sim_env_u32("SIM_EMI_SNS_CLK", 0u);
+    sim_cfg.emi_noise = sim_env_u32("SIM_EMI_NOISE", 300u);
+    sim_cfg.seed = sim_env_u32("SIM_SEED", 1u);
+    sim_cfg.verbose = (0u != sim_env_u32("SIM_VERBOSE", 0u));
+    sim_cfg.uart_capture = getenv("SIM_UART_CAPTURE");
+    sim_cfg.replay = getenv("SIM_REPLAY");
+    if ((NULL != sim_cfg.replay) && ('\0' == sim_cfg.replay[0]))
+    {
+        sim_cfg.replay = NULL;
+    }
+
+    sim_cfg.bist_pins = sim_env_us("SIM_BIST_PINS_US", 20.0);
+    sim_cfg.bist_cap = sim_env_us("SIM_BIST_CAP_US", 300.0);
+    sim_cfg.bist_short = sim_env_u32("SIM_BIST_SHORT", UINT32_MAX);
+    sim_cfg.flash = getenv("SIM_FLASH");
+    sim_cfg.flash_row = sim_env_us("SIM_FLASH_ROW_US", 20000.0);
+
+    list = getenv("SIM_PROCESS_US");
+    for (i = 0u; i < (sizeof(sim_cfg.process) / sizeof(sim_cfg.process[0u])); i++)
+    {
+        if ((NULL != list) && ('\0' != *list))
+        {
+            char * end;
+            cost = strtod(list, &end);
+            list = (',' == *end) ? (end + 1) : end;
+        }
+        sim_cfg.process[i] = (sim_ns_t)(cost * (double)SIM_NS_PER_US);
+    }
+
+    sim_rand_state = (0u != sim_cfg.seed) ? sim_cfg.seed : 1u;
+    memset(sim_isr_table, 0, sizeof(sim_isr_table));
+    memset(sim_irq_enabled, 0, sizeof(sim_irq_enabled));
+    memset(sim_irq_pending, 0, sizeof(sim_irq_pending));
+    sim_irq_masked = true;
+    sim_in_isr = false;
+}
+
+/*******************************************************************************
+ * Function Name: sim_next_event
+ ********************************************************************************
+ * Summary:
+ *  Returns the time of the earliest scheduled hardware event.
+ *
+ *******************************************************************************/
+static sim_ns_t sim_next_event(void)
+{
+    sim_ns_t next = sim_msc_next_event();
+    sim_ns_t pdl = sim_pdl_next_event();
+    return (pdl < next) ? pdl : next;
+}
+
+/*******************************************************************************
+ * Function Name: sim_update
+ ********************************************************************************
+ * Summary:
+ *  Fires all hardware events that are due at the current time.
+ *
+ *******************************************************************************/
+static void sim_update(void)
+{
+    sim_msc_update();
+    sim_pdl_update();
+
+    if (sim_now > sim_cfg.max_time)
+    {
+        printf("simulation time limit reached\n");
+        sim_finish(EXIT_SUCCESS);
+    }
+}
+
+/*******************************************************************************
+ * Function Name: sim_account
+ ********************************************************************************
+ * Summary:
+ *  Advances the clock by the given time spent in the given power state.
+ *
+ *******************************************************************************/
+static void sim_account(sim_ns_t duration, sim_power_state_t state)
+{
+    sim_now += duration;
+    switch (state)
+    {
+        case SIM_STATE_SLEEP:
+            sim_stats.sleep += duration;
+            break;
+        case SIM_STATE_DEEPSLEEP:
+            sim_stats.deepsleep += duration;
+            break;
+        default:
+            sim_stats.active += duration;
+            break;
+    }
+}
+
+/*******************************************************************************
+ * Function Name: sim_cpu
+ ********************************************************************************
+ * Summary:
+ *  Spends active CPU time. The time is split at hardware events, and pending
+ *  interrupts are serviced at each split point.
+ *
+ *******************************************************************************/
+void sim_cpu(sim_ns_t duration)
+{
+    sim_ns_t end = sim_now + duration;
+
+    do
+    {
+        sim_ns_t next = sim_next_event();
+        sim_ns_t step = ((next > sim_now) && (next < end)) ? (next - sim_now) : (end - sim_now);
+
+        if (next <= sim_now)
+        {
+            step = 0u;
+        }
+        sim_account(step, SIM_STATE_ACTIVE);
+        sim_update();
+        sim_service_interrupts();
+    } while (sim_now < end);
+}
+
+static bool sim_irq_any_pending(void)
+{
+    uint32_t irq;
+
+    for (irq = 0u; irq < (uint32_t)SIM_IRQ_COUNT; irq++)
+    {
+        if (sim_irq_pending[irq] && sim_irq_enabled[irq])
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/*******************************************************************************
+ * Function Name: sim_idle
+ ********************************************************************************
+ * Summary:
+ *  Models WFI in CPU Sleep or Deep Sleep: the clock skips to the next hardware
+ *  event and the wake-up time is spent before the interrupt is serviced.
+ *
+ *******************************************************************************/
+void sim_idle(sim_power_state_t state)
+{
+    sim_ns_t next;
+
+    sim_update();
+
+    /* WFI returns at once on a pending interrupt, even with PRIMASK set */
+    if (sim_irq_any_pending())
+    {
+        return;
+    }
+    next = sim_next_event();
+
+    if (SIM_NEVER == next)
+    {
+        printf("simulation stalled: CPU sleeps with no wake-up source\n");
+        sim_finish(EXIT_FAILURE);
+    }
+
+    if (next > sim_now)
+    {
+        sim_account(next - sim_now, state);
+    }
+    sim_update();
+
+    /* Wake-up time is not available to the CPU */
+    sim_account((SIM_STATE_DEEPSLEEP == state) ? sim_cfg.deepsleep_wake : sim_cfg.sleep_wake,
+                SIM_STATE_ACTIVE);
+    sim_update();
+}
+
+/*******************************************************************************
+ * Function Name: sim_service_interrupts
+ ********************************************************************************
+ * Summary:
+ *  Runs the handlers of all pending and enabled interrupts. Interrupts are
+ *  not nested: events raised by a handler are serviced after it returns.
+ *
+ *******************************************************************************/
+void sim_service_interrupts(void)
+{
+    bool serviced;
+
+    if (sim_irq_masked || sim_in_isr)
+    {
+        return;
+    }
+
+    do
+    {
+        uint32_t irq;
+
+        serviced = false;
+        for (irq = 0u; irq < (uint32_t)SIM_IRQ_COUNT; irq++)
+        {
+            if (sim_irq_pending[irq] && sim_irq_enabled[irq] && (NULL != sim_isr_table[irq]))
+            {
+                sim_irq_pending[irq] = false;
+                sim_in_isr = true;
+                sim_isr_table[irq]();
+                sim_in_isr = false;
+                serviced = true;
+                sim_update();
+            }
+        }
+    } while (serviced && !sim_irq_masked);
+}
+
+void sim_set_pending(IRQn_Type irq)
+{
+    sim_irq_pending[irq] = true;
+}
+
+void sim_clear_pending(IRQn_Type irq)
+{
+    sim_irq_pending[irq] = false;
+}
+
+void sim_register_isr(IRQn_Type irq, cy_israddress isr)
+{
+    sim_isr_table[irq] = isr;
+}
+
+void sim_enable_irq(IRQn_Type irq, bool enable)
+{
+    sim_irq_enabled[irq] = enable;
+}
+
+void sim_mask_irqs(bool mask)
+{
+    sim_irq_masked = mask;
+    if (!mask)
+    {
+        sim_service_interrupts();
+    }
+}
+
+bool sim_irqs_masked(void)
+{
+    return sim_irq_masked;
+}
+
+/*******************************************************************************
+ * Function Name: sim_rand
+ ********************************************************************************
+ * Summary:
+ *  Deterministic pseudo-random generator (xorshift32).
+ *
+ *******************************************************************************/
+uint32_t sim_rand(void)
+{
+    sim_rand_state ^= sim_rand_state << 13;
+    sim_rand_state ^= sim_rand_state >> 17;
+    sim_rand_state ^= sim_rand_state << 5;
+    return sim_rand_state;
+}
+
+/*******************************************************************************
+ * Function Name: sim_finish
+ ********************************************************************************
+ * Summary:
+ *  Prints the report and terminates the simulated firmware.
+ *
+ *******************************************************************************/
+void sim_finish(int status)
+{
+    double seconds = (double)sim_now / (double)SIM_NS_PER_S;
+    double total = (double)((0u != sim_now) ? sim_now : 1u);
+
+    printf("time                  %.3f s\n", seconds);
+    printf("cpu active            %5.1f %%\n", 100.0 * (double)sim_stats.active / total);
+    printf("cpu sleep             %5.1f %%  (%u entries)\n", 100.0 * (double)sim_stats.sleep / total,
+           sim_stats.sleep_entries);
+    printf("cpu deep sleep        %5.1f %%  (%u entries, %u rejected)\n",
+           100.0 * (double)sim_stats.deepsleep / total, sim_stats.deepsleep_entries,
+           sim_stats.deepsleep_rejects);
+    printf("msc busy              %5.1f %%\n", 100.0 * (double)sim_stats.msc_busy / total);
+    sim_capsense_report();
+    sim_pdl_report();
+    fflush(stdout);
+    exit(status);
+}
+
+/*******************************************************************************
+ * Function Name: sim_assert_failed
+ ********************************************************************************
+ * Summary:
+ *  CY_ASSERT() handler.
+ *
+ *******************************************************************************/
+void sim_assert_failed(const char * file, int line)
+{
+    printf("CY_ASSERT failed at %s:%d\n", file, line);
+    sim_finish(EXIT_FAILURE);
+}
+
+/* [] END OF FILE */
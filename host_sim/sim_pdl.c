@@ -0,0 +1,914 @@
+/******************************************************************************
+ * File Name: sim_pdl.c
+ *
+ * Description: Simulated PDL drivers: interrupt controller, SysLib delays, WDT
+ * clocked by an ILO with configurable error, ILO measurement, power modes with
+ * Deep Sleep callbacks, GPIO ports and the SCB UART/EZI2C used by the tuner.
+ * cybsp_init() of the simulated board is also located here.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include "sim.h"
+#include "cybsp.h"
+#include "cycfg_capsense.h"
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+#define SIM_WDT_COUNTER_MASK             (0xFFFFu)
+#define SIM_SYSTICK_MASK                 (0x00FFFFFFu)
+#define SIM_UART_FIFO_DEPTH              (8u)
+#define SIM_UART_BITS_PER_BYTE           (10u)
+#define SIM_MAX_PM_CALLBACKS             (8u)
+
+/*******************************************************************************
+ * Global Definitions
+ *******************************************************************************/
+GPIO_PRT_Type sim_gpio_prt0;
+CySCB_Type sim_scb1 = {1u};
+MSC_Type sim_msc0 = {0u};
+MSC_Type sim_msc1 = {1u};
+const cy_stc_scb_uart_config_t scb_1_config = {115200u};
+const cy_stc_scb_ezi2c_config_t CYBSP_EZI2C_config = {8u};
+
+/* Flash of the simulated device: the CY_SECTION objects of the application,
+ * placed in one read-only section by the linker. Weak, since a build without
+ * such objects has no flash.
+ */
+extern uint8_t __start_sim_flash[] __attribute__((weak));
+extern uint8_t __stop_sim_flash[] __attribute__((weak));
+
+/* LED wiring of the simulated board, in widget order */
+static GPIO_PRT_Type * const sim_led_port[SIM_LED_COUNT] = {P0_5_PORT, P0_4_PORT};
+static const uint32_t sim_led_pin[SIM_LED_COUNT] = {P0_5_PIN, P0_4_PIN};
+static uint32_t sim_led_state;
+
+/* WDT state */
+static bool sim_wdt_enabled;
+static bool sim_wdt_unmasked;
+static uint32_t sim_wdt_match;
+static sim_ns_t sim_wdt_event;
+
+/* ILO measurement state */
+static bool sim_ilo_measuring;
+static sim_ns_t sim_ilo_meas_start;
+
+/* SysTick state */
+static uint32_t sim_systick_reload;
+static sim_ns_t sim_systick_start;
+
+/* Power mode callbacks */
+static cy_stc_syspm_callback_t * sim_pm_callbacks[SIM_MAX_PM_CALLBACKS];
+static uint32_t sim_pm_callback_count;
+
+/* UART state */
+static cy_stc_scb_uart_context_t * sim_uart_context;
+static sim_ns_t sim_uart_tx_end;
+
+/* Interrupt-driven transmit (Cy_SCB_UART_Transmit) */
+static bool sim_uart_tx_active;
+static uint32_t sim_uart_tx_left;
+static sim_ns_t sim_uart_tx_event;
+static bool sim_uart_tx_irq;
+static const uint8_t * sim_uart_tx_buf;
+static FILE * sim_uart_capture;
+
+/*******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+static size_t sim_flash_size(void);
+static void sim_flash_program(size_t offset, const void * data, size_t size);
+
+/*******************************************************************************
+ * Function Name: sim_pdl_init
+ ********************************************************************************
+ * Summary:
+ *  Resets all simulated peripherals.
+ *
+ *******************************************************************************/
+void sim_pdl_init(void)
+{
+    /* LEDs are active low and off after reset */
+    sim_gpio_prt0.DR = 0xFFu;
+    sim_led_state = 0u;
+
+    sim_wdt_enabled = false;
+    sim_wdt_unmasked = false;
+    sim_wdt_match = sim_cfg.wdt_match;
+    sim_wdt_event = SIM_NEVER;
+
+    sim_ilo_measuring = false;
+    sim_pm_callback_count = 0u;
+    sim_uart_context = NULL;
+    sim_uart_tx_end = 0u;
+    sim_uart_tx_active = false;
+    sim_uart_tx_left = 0u;
+    sim_uart_tx_event = SIM_NEVER;
+    sim_uart_tx_irq = false;
+    sim_uart_tx_buf = NULL;
+    sim_uart_capture = NULL;
+    if (NULL != sim_cfg.uart_capture)
+    {
+        sim_uart_capture = fopen(sim_cfg.uart_capture, "wb");
+        if (NULL == sim_uart_capture)
+        {
+            perror(sim_cfg.uart_capture);
+        }
+    }
+
+    if ((NULL != sim_cfg.flash) && (0u != sim_flash_size()))
+    {
+        /* A missing file is an erased flash */
+        FILE * file = fopen(sim_cfg.flash, "rb");
+        uint8_t * image = calloc(1u, sim_flash_size());
+        if ((NULL != file) && (NULL != image))
+        {
+            (void)fread(image, 1u, sim_flash_size(), file);
+            sim_flash_program(0u, image, sim_flash_size());
+        }
+        if (NULL != file)
+        {
+            fclose(file);
+        }
+        free(image);
+    }
+}
+
+/*******************************************************************************
+ * Function Name: cybsp_init
+ ********************************************************************************
+ * Summary:
+ *  Initializes the simulator in place of the board.
+ *
+ *******************************************************************************/
+cy_rslt_t cybsp_init(void)
+{
+    sim_init();
+    sim_pdl_init();
+    sim_capsense_init();
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+ * WDT
+ *******************************************************************************/
+static uint64_t sim_wdt_ticks(sim_ns_t time)
+{
+    return (uint64_t)(((__uint128_t)time * sim_cfg.ilo_hz) / SIM_NS_PER_S);
+}
+
+static void sim_wdt_schedule(void)
+{
+    uint64_t ticks;
+    uint64_t target;
+
+    if (!sim_wdt_enabled)
+    {
+        sim_wdt_event = SIM_NEVER;
+        return;
+    }
+
+    ticks = sim_wdt_ticks(sim_now);
+    target = (ticks & ~(uint64_t)SIM_WDT_COUNTER_MASK) | sim_wdt_match;
+    if (target <= ticks)
+    {
+        target += (uint64_t)SIM_WDT_COUNTER_MASK + 1u;
+    }
+    sim_wdt_event = (sim_ns_t)((((__uint128_t)target * SIM_NS_PER_S) + sim_cfg.ilo_hz - 1u) / sim_cfg.ilo_hz);
+}
+
+void Cy_WDT_Enable(void)
+{
+    sim_wdt_enabled = true;
+    sim_wdt_schedule();
+}
+
+void Cy_WDT_Disable(void)
+{
+    sim_wdt_enabled = false;
+    sim_wdt_schedule();
+}
+
+void Cy_WDT_Lock(void) {}
+void Cy_WDT_Unlock(void) {}
+void Cy_WDT_ClearWatchdog(void) {}
+
+void Cy_WDT_SetMatch(uint32_t match)
+{
+    sim_cpu(sim_cfg.api);
+    sim_wdt_match = match & SIM_WDT_COUNTER_MASK;
+    sim_wdt_schedule();
+}
+
+uint32_t Cy_WDT_GetMatch(void)
+{
+    return sim_wdt_match;
+}
+
+uint32_t Cy_WDT_GetCount(void)
+{
+    sim_cpu(sim_cfg.api);
+    return (uint32_t)(sim_wdt_ticks(sim_now) & SIM_WDT_COUNTER_MASK);
+}
+
+void Cy_WDT_ClearInterrupt(void)
+{
+    sim_cpu(sim_cfg.api);
+}
+
+void Cy_WDT_MaskInterrupt(void)
+{
+    sim_wdt_unmasked = false;
+}
+
+void Cy_WDT_UnmaskInterrupt(void)
+{
+    sim_wdt_unmasked = true;
+}
+
+/*******************************************************************************
+ * Flash
+ *******************************************************************************/
+static size_t sim_flash_size(void)
+{
+    return (size_t)(__stop_sim_flash - __start_sim_flash);
+}
+
+/* Programs the flash section, the way the flash controller does. The
+ * section may be read-only; its pages are made writable, never read-only
+ * again, since they may share a page with writable data.
+ */
+static void sim_flash_program(size_t offset, const void * data, size_t size)
+{
+    uintptr_t pageMask = (uintptr_t)sysconf(_SC_PAGESIZE) - 1u;
+    uintptr_t first = (uintptr_t)&__start_sim_flash[offset] & ~pageMask;
+    size_t length = (uintptr_t)&__start_sim_flash[offset + size] - first;
+
+    if (0 != mprotect((void *)first, length, PROT_READ | PROT_WRITE))
+    {
+        perror("mprotect");
+        exit(EXIT_FAILURE);
+    }
+    memcpy(&__start_sim_flash[offset], data, size);
+}
+
+cy_en_flashdrv_status_t Cy_Flash_WriteRow(uint32_t rowAddr, const uint32_t * data)
+{
+    /* Row addresses hold the low 32 bits of the host address */
+    uint32_t offset = rowAddr - (uint32_t)(uintptr_t)__start_sim_flash;
+    bool masked = sim_irqs_masked();
+    FILE * file;
+
+    if ((NULL == data) || ((offset + CY_FLASH_SIZEOF_ROW) > sim_flash_size()) ||
+        (0u != (offset % CY_FLASH_SIZEOF_ROW)))
+    {
+        return CY_FLASH_DRV_INVALID_INPUT_PARAMETERS;
+    }
+
+    /* The CPU stalls while the row is erased and programmed */
+    sim_mask_irqs(true);
+    sim_cpu(sim_cfg.flash_row);
+    sim_flash_program(offset, data, CY_FLASH_SIZEOF_ROW);
+    sim_stats.flash_rows++;
+    sim_mask_irqs(masked);
+
+    if (NULL != sim_cfg.flash)
+    {
+        file = fopen(sim_cfg.flash, "wb");
+        if (NULL == file)
+        {
+            perror(sim_cfg.flash);
+            return CY_FLASH_DRV_INV_PROT;
+        }
+        (void)fwrite(__start_sim_flash, 1u, sim_flash_size(), file);
+        fclose(file);
+    }
+    return CY_FLASH_DRV_SUCCESS;
+}
+
+/*******************************************************************************
+ * SysTick
+ *******************************************************************************/
+/* Down counter clocked by the CPU clock. Unlike the hardware, the simulated
+ * counter does not stop in Deep Sleep.
+ */
+void Cy_SysTick_Init(cy_en_systick_clock_source_t clockSource, uint32_t interval)
+{
+    (void)clockSource;
+    sim_systick_reload = interval & SIM_SYSTICK_MASK;
+    sim_systick_start = sim_now;
+}
+
+void Cy_SysTick_DisableInterrupt(void) {}
+
+uint32_t Cy_SysTick_GetValue(void)
+{
+    uint64_t cycles = ((sim_now - sim_systick_start) * (Cy_SysClk_ClkSysGetFrequency() / 1000000u)) / 1000u;
+
+    return sim_systick_reload - (uint32_t)(cycles % ((uint64_t)sim_systick_reload + 1u));
+}
+
+/*******************************************************************************
+ * SysClk
+ *******************************************************************************/
+void Cy_SysClk_IloStartMeasurement(void)
+{
+    sim_cpu(sim_cfg.api);
+    sim_ilo_measuring = true;
+    sim_ilo_meas_start = sim_now;
+}
+
+void Cy_SysClk_IloStopMeasurement(void)
+{
+    sim_cpu(sim_cfg.api);
+    sim_ilo_measuring = false;
+}
+
+cy_en_sysclk_status_t Cy_SysClk_IloCompensate(uint32_t desiredDelay, uint32_t * compensatedCycles)
+{
+    sim_cpu(sim_cfg.api);
+
+    if ((!sim_ilo_measuring) || (NULL == compensatedCycles))
+    {
+        return CY_SYSCLK_BAD_PARAM;
+    }
+    if ((sim_now - sim_ilo_meas_start) < sim_cfg.ilo_meas)
+    {
+        return CY_SYSCLK_STARTED;
+    }
+    *compensatedCycles = (uint32_t)(((uint64_t)desiredDelay * sim_cfg.ilo_hz) / 1000000u);
+    return CY_SYSCLK_SUCCESS;
+}
+
+uint32_t Cy_SysClk_ClkSysGetFrequency(void)
+{
+    return 24000000u;
+}
+
+cy_en_syspm_status_t Cy_SysClk_DeepSleepCallback(cy_stc_syspm_callback_params_t * callbackParams,
+                                                 cy_en_syspm_callback_mode_t mode)
+{
+    (void)callbackParams;
+    (void)mode;
+    return CY_SYSPM_SUCCESS;
+}
+
+/*******************************************************************************
+ * SysInt, NVIC and SysLib
+ *******************************************************************************/
+cy_en_sysint_status_t Cy_SysInt_Init(const cy_stc_sysint_t * config, cy_israddress userIsr)
+{
+    if ((NULL == config) || (NULL == userIsr) || (config->intrSrc >= SIM_IRQ_COUNT))
+    {
+        return CY_SYSINT_BAD_PARAM;
+    }
+    sim_register_isr(config->intrSrc, userIsr);
+    return CY_SYSINT_SUCCESS;
+}
+
+void __enable_irq(void)
+{
+    sim_mask_irqs(false);
+}
+
+void __disable_irq(void)
+{
+    sim_mask_irqs(true);
+}
+
+void __NOP(void)
+{
+    sim_cpu(sim_cfg.api / 10u);
+}
+
+void NVIC_EnableIRQ(IRQn_Type IRQn)
+{
+    sim_enable_irq(IRQn, true);
+}
+
+void NVIC_DisableIRQ(IRQn_Type IRQn)
+{
+    sim_enable_irq(IRQn, false);
+}
+
+void NVIC_ClearPendingIRQ(IRQn_Type IRQn)
+{
+    sim_clear_pending(IRQn);
+}
+
+void Cy_SysLib_Delay(uint32_t milliseconds)
+{
+    sim_cpu((sim_ns_t)milliseconds * SIM_NS_PER_MS);
+}
+
+void Cy_SysLib_DelayUs(uint16_t microseconds)
+{
+    sim_cpu((sim_ns_t)microseconds * SIM_NS_PER_US);
+}
+
+uint32_t Cy_SysLib_EnterCriticalSection(void)
+{
+    uint32_t saved = sim_irqs_masked() ? 1u : 0u;
+    sim_mask_irqs(true);
+    return saved;
+}
+
+void Cy_SysLib_ExitCriticalSection(uint32_t savedIntrStatus)
+{
+    sim_mask_irqs(0u != savedIntrStatus);
+}
+
+/*******************************************************************************
+ * SysPm
+ *******************************************************************************/
+bool Cy_SysPm_RegisterCallback(cy_stc_syspm_callback_t * handler)
+{
+    if ((NULL == handler) || (sim_pm_callback_count >= SIM_MAX_PM_CALLBACKS))
+    {
+        return false;
+    }
+    sim_pm_callbacks[sim_pm_callback_count++] = handler;
+    return true;
+}
+
+static bool sim_pm_run_callbacks(cy_en_syspm_callback_type_t type, cy_en_syspm_callback_mode_t mode)
+{
+    uint32_t i;
+
+    for (i = 0u; i < sim_pm_callback_count; i++)
+    {
+        cy_stc_syspm_callback_t * cb = sim_pm_callbacks[i];
+        if ((cb->type == type) && (0u == (cb->skipMode & (uint32_t)mode)))
+        {
+            if (CY_SYSPM_SUCCESS != cb->callback(cb->callbackParams, mode))
+            {
+                uint32_t j;
+                for (j = 0u; j < i; j++)
+                {
+                    cb = sim_pm_callbacks[j];
+                    if (cb->type == type)
+                    {
+                        (void)cb->callback(cb->callbackParams, CY_SYSPM_CHECK_FAIL);
+                    }
+                }
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+cy_en_syspm_status_t Cy_SysPm_CpuEnterSleep(void)
+{
+    sim_cpu(sim_cfg.api);
+    sim_stats.sleep_entries++;
+    sim_idle(SIM_STATE_SLEEP);
+    sim_service_interrupts();
+    return CY_SYSPM_SUCCESS;
+}
+
+cy_en_syspm_status_t Cy_SysPm_CpuEnterDeepSleep(void)
+{
+    sim_cpu(sim_cfg.api);
+    if (!sim_pm_run_callbacks(CY_SYSPM_DEEPSLEEP, CY_SYSPM_CHECK_READY))
+    {
+        sim_stats.deepsleep_rejects++;
+        return CY_SYSPM_FAIL;
+    }
+    (void)sim_pm_run_callbacks(CY_SYSPM_DEEPSLEEP, CY_SYSPM_BEFORE_TRANSITION);
+    sim_stats.deepsleep_entries++;
+    sim_idle(SIM_STATE_DEEPSLEEP);
+    if (sim_ilo_measuring)
+    {
+        /* The IMO reference is off in Deep Sleep: the measurement restarts */
+        sim_ilo_meas_start = sim_now;
+    }
+    (void)sim_pm_run_callbacks(CY_SYSPM_DEEPSLEEP, CY_SYSPM_AFTER_TRANSITION);
+    sim_service_interrupts();
+    return CY_SYSPM_SUCCESS;
+}
+
+/*******************************************************************************
+ * GPIO
+ *******************************************************************************/
+static void sim_gpio_sample(void)
+{
+    uint32_t led;
+
+    for (led = 0u; led < SIM_LED_COUNT; led++)
+    {
+        /* Active low */
+        bool on = (0u == ((sim_led_port[led]->DR >> sim_led_pin[led]) & 1u));
+        bool was = (0u != (sim_led_state & (1u << led)));
+        if (on != was)
+        {
+            sim_led_state ^= (1u << led);
+            sim_led_changed(led, on);
+        }
+    }
+}
+
+void Cy_GPIO_Write(GPIO_PRT_Type * base, uint32_t pinNum, uint32_t value)
+{
+    sim_cpu(sim_cfg.api);
+    if (NULL != base)
+    {
+        base->DR = (base->DR & ~(1u << pinNum)) | ((value & 1u) << pinNum);
+    }
+}
+
+uint32_t Cy_GPIO_ReadOut(GPIO_PRT_Type * base, uint32_t pinNum)
+{
+    return (base->DR >> pinNum) & 1u;
+}
+
+void Cy_GPIO_Inv(GPIO_PRT_Type * base, uint32_t pinNum)
+{
+    sim_cpu(sim_cfg.api);
+    base->DR ^= (1u << pinNum);
+}
+
+/*******************************************************************************
+ * SCB UART
+ *******************************************************************************/
+static sim_ns_t sim_uart_byte_time(void)
+{
+    return (SIM_UART_BITS_PER_BYTE * SIM_NS_PER_S) / sim_cfg.uart_baud;
+}
+
+/* Bytes enter the capture file when they are put into the TX FIFO */
+static void sim_uart_capture_write(const void * data, uint32_t size)
+{
+    if (NULL != sim_uart_capture)
+    {
+        (void)fwrite(data, 1u, size, sim_uart_capture);
+    }
+}
+
+cy_en_scb_uart_status_t Cy_SCB_UART_Init(CySCB_Type * base, const cy_stc_scb_uart_config_t * config,
+                                         cy_stc_scb_uart_context_t * context)
+{
+    (void)base;
+    if ((NULL == config) || (NULL == context))
+    {
+        return CY_SCB_UART_BAD_PARAM;
+    }
+    memset(context, 0, sizeof(*context));
+    sim_uart_context = context;
+    return CY_SCB_UART_SUCCESS;
+}
+
+void Cy_SCB_UART_Enable(CySCB_Type * base)
+{
+    (void)base;
+}
+
+void Cy_SCB_UART_StartRingBuffer(CySCB_Type * base, void * buffer, uint32_t size,
+                                 cy_stc_scb_uart_context_t * context)
+{
+    (void)base;
+    context->rxRingBuf = (uint8_t *)buffer;
+    context->rxRingBufSize = size;
+    context->rxRingBufHead = 0u;
+    context->rxRingBufTail = 0u;
+}
+
+uint32_t Cy_SCB_UART_GetNumInRingBuffer(CySCB_Type const * base, cy_stc_scb_uart_context_t const * context)
+{
+    (void)base;
+    sim_cpu(sim_cfg.api);
+    if (context->rxRingBufHead >= context->rxRingBufTail)
+    {
+        return context->rxRingBufHead - context->rxRingBufTail;
+    }
+    return (context->rxRingBufSize - context->rxRingBufTail) + context->rxRingBufHead;
+}
+
+cy_en_scb_uart_status_t Cy_SCB_UART_Receive(CySCB_Type * base, void * buffer, uint32_t size,
+                                            cy_stc_scb_uart_context_t * context)
+{
+    uint8_t * dst = (uint8_t *)buffer;
+
+    (void)base;
+    sim_cpu(sim_cfg.api);
+    while ((0u != size) && (context->rxRingBufTail != context->rxRingBufHead))
+    {
+        *dst++ = context->rxRingBuf[context->rxRingBufTail];
+        context->rxRingBufTail = (context->rxRingBufTail + 1u) % context->rxRingBufSize;
+        size--;
+    }
+    return CY_SCB_UART_SUCCESS;
+}
+
+void Cy_SCB_UART_PutArrayBlocking(CySCB_Type * base, void * buffer, uint32_t size)
+{
+    sim_ns_t start = (sim_uart_tx_end > sim_now) ? sim_uart_tx_end : sim_now;
+    sim_ns_t fifo = SIM_UART_FIFO_DEPTH * sim_uart_byte_time();
+
+    (void)base;
+    sim_uart_capture_write(buffer, size);
+    sim_stats.tx_bytes += size;
+    sim_uart_tx_end = start + ((sim_ns_t)size * sim_uart_byte_time());
+
+    /* Returns when the last byte has been put into the TX FIFO */
+    if ((sim_uart_tx_end - fifo) > sim_now)
+    {
+        sim_cpu((sim_uart_tx_end - fifo) - sim_now);
+    }
+}
+
+/*******************************************************************************
+ * Function Name: sim_uart_tx_fill
+ ********************************************************************************
+ * Summary:
+ *  Moves up to the given number of bytes of the transmit buffer into the TX
+ *  FIFO and schedules the next TX interrupt: FIFO half empty while data is
+ *  left, transmit done otherwise.
+ *
+ *******************************************************************************/
+static void sim_uart_tx_fill(uint32_t space)
+{
+    uint32_t n = (sim_uart_tx_left < space) ? sim_uart_tx_left : space;
+    sim_ns_t start = (sim_uart_tx_end > sim_now) ? sim_uart_tx_end : sim_now;
+
+    sim_uart_tx_end = start + ((sim_ns_t)n * sim_uart_byte_time());
+    sim_uart_capture_write(sim_uart_tx_buf, n);
+    sim_uart_tx_buf += n;
+    sim_uart_tx_left -= n;
+    sim_stats.tx_bytes += n;
+
+    if (0u != sim_uart_tx_left)
+    {
+        sim_uart_tx_event = sim_uart_tx_end - ((SIM_UART_FIFO_DEPTH / 2u) * sim_uart_byte_time());
+    }
+    else
+    {
+        sim_uart_tx_event = sim_uart_tx_end;
+    }
+}
+
+cy_en_scb_uart_status_t Cy_SCB_UART_Transmit(CySCB_Type * base, void * buffer, uint32_t size,
+                                             cy_stc_scb_uart_context_t * context)
+{
+    (void)base;
+    (void)context;
+    sim_cpu(sim_cfg.api);
+    if (sim_uart_tx_active)
+    {
+        return CY_SCB_UART_TRANSMIT_BUSY;
+    }
+    sim_uart_tx_active = true;
+    sim_uart_tx_buf = (const uint8_t *)buffer;
+    sim_uart_tx_left = size;
+    sim_uart_tx_fill(SIM_UART_FIFO_DEPTH);
+    return CY_SCB_UART_SUCCESS;
+}
+
+uint32_t Cy_SCB_UART_GetTransmitStatus(CySCB_Type const * base, cy_stc_scb_uart_context_t const * context)
+{
+    (void)base;
+    (void)context;
+    return sim_uart_tx_active ? CY_SCB_UART_TRANSMIT_ACTIVE : 0u;
+}
+
+void Cy_SCB_UART_RegisterCallback(CySCB_Type const * base, cy_cb_scb_uart_handle_events_t callback,
+                                  cy_stc_scb_uart_context_t * context)
+{
+    (void)base;
+    context->cbEvents = callback;
+}
+
+bool Cy_SCB_UART_IsTxComplete(CySCB_Type const * base)
+{
+    (void)base;
+    sim_cpu(sim_cfg.api);
+    return (sim_now >= sim_uart_tx_end);
+}
+
+void Cy_SCB_UART_Interrupt(CySCB_Type * base, cy_stc_scb_uart_context_t * context)
+{
+    (void)base;
+    sim_cpu(sim_cfg.api);
+
+    if (!sim_uart_tx_irq)
+    {
+        return;
+    }
+    sim_uart_tx_irq = false;
+
+    if (0u != sim_uart_tx_left)
+    {
+        sim_uart_tx_fill(SIM_UART_FIFO_DEPTH / 2u);
+        if ((0u == sim_uart_tx_left) && (NULL != context->cbEvents))
+        {
+            context->cbEvents(CY_SCB_UART_TRANSMIT_IN_FIFO_EVENT);
+        }
+    }
+    else
+    {
+        sim_uart_tx_active = false;
+        if (NULL != context->cbEvents)
+        {
+            context->cbEvents(CY_SCB_UART_TRANSMIT_DONE_EVENT);
+        }
+    }
+}
+
+cy_en_syspm_status_t Cy_SCB_UART_DeepSleepCallback(cy_stc_syspm_callback_params_t * callbackParams,
+                                                   cy_en_syspm_callback_mode_t mode)
+{
+    (void)callbackParams;
+    /* The transmitter must be idle before the SCB is put into Deep Sleep */
+    if ((CY_SYSPM_CHECK_READY == mode) && (sim_uart_tx_active || (sim_now < sim_uart_tx_end)))
+    {
+        return CY_SYSPM_FAIL;
+    }
+    return CY_SYSPM_SUCCESS;
+}
+
+/*******************************************************************************
+ * Function Name: sim_uart_host_inject
+ ********************************************************************************
+ * Summary:
+ *  Puts bytes sent by the host into the UART RX ring buffer and raises the
+ *  SCB interrupt.
+ *
+ *******************************************************************************/
+void sim_uart_host_inject(const uint8_t * data, uint32_t size)
+{
+    cy_stc_scb_uart_context_t * context = sim_uart_context;
+
+    if ((NULL == context) || (NULL == context->rxRingBuf))
+    {
+        return;
+    }
+    while (0u != size)
+    {
+        uint32_t next = (context->rxRingBufHead + 1u) % context->rxRingBufSize;
+        if (next == context->rxRingBufTail)
+        {
+            /* Ring buffer overflow: the byte is lost */
+            break;
+        }
+        context->rxRingBuf[context->rxRingBufHead] = *data++;
+        context->rxRingBufHead = next;
+        size--;
+    }
+    sim_set_pending(scb_1_IRQ);
+}
+
+/*******************************************************************************
+ * SCB EZI2C
+ *******************************************************************************/
+cy_en_scb_ezi2c_status_t Cy_SCB_EZI2C_Init(CySCB_Type * base, const cy_stc_scb_ezi2c_config_t * config,
+                                           cy_stc_scb_ezi2c_context_t * context)
+{
+    (void)base;
+    if ((NULL == config) || (NULL == context))
+    {
+        return CY_SCB_EZI2C_BAD_PARAM;
+    }
+    memset(context, 0, sizeof(*context));
+    return CY_SCB_EZI2C_SUCCESS;
+}
+
+void Cy_SCB_EZI2C_Enable(CySCB_Type * base)
+{
+    (void)base;
+}
+
+void Cy_SCB_EZI2C_SetBuffer1(CySCB_Type const * base, uint8_t * buffer, uint32_t size,
+                             uint32_t rwBoundary, cy_stc_scb_ezi2c_context_t * context)
+{
+    (void)base;
+    context->buf1 = buffer;
+    context->buf1Size = size;
+    context->buf1rwBondary = rwBoundary;
+}
+
+uint32_t Cy_SCB_EZI2C_GetActivity(CySCB_Type const * base, cy_stc_scb_ezi2c_context_t * context)
+{
+    uint32_t status = context->status;
+    (void)base;
+    context->status &= CY_SCB_EZI2C_STATUS_BUSY;
+    return status;
+}
+
+void Cy_SCB_EZI2C_Interrupt(CySCB_Type * base, cy_stc_scb_ezi2c_context_t * context)
+{
+    (void)base;
+    (void)context;
+    sim_cpu(sim_cfg.api);
+}
+
+cy_en_syspm_status_t Cy_SCB_EZI2C_DeepSleepCallback(cy_stc_syspm_callback_params_t * callbackParams,
+                                                    cy_en_syspm_callback_mode_t mode)
+{
+    (void)callbackParams;
+    (void)mode;
+    return CY_SYSPM_SUCCESS;
+}
+
+/*******************************************************************************
+ * Function Name: sim_pdl_next_event
+ ********************************************************************************
+ * Summary:
+ *  Returns the time of the next WDT match or UART TX interrupt.
+ *
+ *******************************************************************************/
+sim_ns_t sim_pdl_next_event(void)
+{
+    return (sim_uart_tx_event < sim_wdt_event) ? sim_uart_tx_event : sim_wdt_event;
+}
+
+/*******************************************************************************
+ * Function Name: sim_pdl_update
+ ********************************************************************************
+ * Summary:
+ *  Raises the WDT interrupt on a match and the UART TX interrupt, and samples
+ *  the LED outputs.
+ *
+ *******************************************************************************/
+void sim_pdl_update(void)
+{
+    if (sim_now >= sim_uart_tx_event)
+    {
+        sim_uart_tx_event = SIM_NEVER;
+        sim_uart_tx_irq = true;
+        sim_set_pending(scb_1_interrupt_IRQn);
+    }
+
+    if (sim_now >= sim_wdt_event)
+    {
+        if (sim_wdt_unmasked)
+        {
+            sim_stats.wdt_interrupts++;
+            sim_set_pending(srss_wdt_irq_IRQn);
+        }
+        /* The counter keeps running; the next match is one full period away
+         * unless the match value is updated.
+         */
+        sim_wdt_schedule();
+    }
+    sim_gpio_sample();
+}
+
+/*******************************************************************************
+ * Function Name: sim_pdl_report
+ ********************************************************************************
+ * Summary:
+ *  Prints peripheral statistics.
+ *
+ *******************************************************************************/
+void sim_pdl_report(void)
+{
+    printf("wdt interrupts        %u\n", sim_stats.wdt_interrupts);
+    printf("uart tx bytes         %llu\n", (unsigned long long)sim_stats.tx_bytes);
+    if (0u != sim_stats.flash_rows)
+    {
+        printf("flash rows written    %u\n", sim_stats.flash_rows);
+    }
+}
+
+/* [] END OF FILE */
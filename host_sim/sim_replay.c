@@ -0,0 +1,360 @@
+/******************************************************************************
+ * File Name: sim_replay.c
+ *
+ * Description: Raw count replay for the host simulation. Loads a trace file
+ * written by tuner_dump -r from the raw count dumps of RAW_TRACE_ENABLE and
+ * feeds the recorded raw counts to the simulated MSC block in place of the
+ * touch script. The widget status recorded on the target is the reference
+ * for the touch statistics, so that a change of the processing can be
+ * compared with the decisions taken on the target for the same raw counts.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "sim.h"
+#include "cycfg_capsense.h"
+#include "../tuner_telemetry.h"
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+/* Records of each widget at the start of the trace in which the target may
+ * still report a touch that began before the trace. Covers the on-debounce
+ * count of the simulated widgets.
+ */
+#define SIM_REPLAY_WARMUP_RECORDS        (4u)
+
+/*******************************************************************************
+ * Data types
+ *******************************************************************************/
+typedef struct
+{
+    sim_ns_t time;                   /* Trace time, from the first record */
+    const uint8_t * raw;             /* Raw counts, 16 bits little-endian */
+    uint32_t touch;                  /* Index (starting from 1) of the recorded touch, 0 if inactive */
+} sim_replay_record_t;
+
+typedef struct
+{
+    sim_replay_record_t * records;
+    uint32_t count;
+    sim_ns_t * onsets;               /* Trace time of each recorded touch */
+    uint32_t touches;
+} sim_replay_widget_t;
+
+/*******************************************************************************
+ * Global Definitions
+ *******************************************************************************/
+static uint8_t * sim_replay_data;
+static uint32_t sim_replay_records;
+static sim_replay_widget_t sim_replay_wd[CY_CAPSENSE_WIDGET_COUNT];
+static sim_ns_t sim_replay_end;
+static sim_ns_t sim_replay_origin = SIM_NEVER;
+static clock_t sim_replay_clock;
+
+static uint32_t sim_replay_u32(const uint8_t * data)
+{
+    return (uint32_t)data[0u] | ((uint32_t)data[1u] << 8u) | ((uint32_t)data[2u] << 16u) |
+           ((uint32_t)data[3u] << 24u);
+}
+
+static void sim_replay_fail(const char * reason)
+{
+    fprintf(stderr, "%s: %s\n", sim_cfg.replay, reason);
+    exit(EXIT_FAILURE);
+}
+
+/*******************************************************************************
+ * Function Name: sim_replay_find
+ ********************************************************************************
+ * Summary:
+ *  Returns the last record of a widget at or before the given simulation
+ *  time, or the first record before the trace starts.
+ *
+ *******************************************************************************/
+static const sim_replay_record_t * sim_replay_find(uint32_t widgetId, sim_ns_t time)
+{
+    const sim_replay_widget_t * wd = &sim_replay_wd[widgetId];
+    sim_ns_t traceTime;
+    uint32_t lo = 0u;
+    uint32_t hi;
+    uint32_t mid;
+
+    if ((SIM_NEVER == sim_replay_origin) || (time < sim_replay_origin))
+    {
+        return &wd->records[0u];
+    }
+    traceTime = time - sim_replay_origin;
+    hi = wd->count;
+    while ((hi - lo) > 1u)
+    {
+        mid = lo + ((hi - lo) / 2u);
+        if (wd->records[mid].time <= traceTime)
+        {
+            lo = mid;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+    return &wd->records[lo];
+}
+
+/*******************************************************************************
+ * Function Name: sim_replay_load
+ ********************************************************************************
+ * Summary:
+ *  Loads the trace file named by SIM_REPLAY. The records must match the
+ *  simulated widget layout. The 16-bit WDT time stamps are unwrapped, which
+ *  assumes that consecutive records are less than one counter wrap apart.
+ *  Terminates the simulation if the file cannot be used.
+ *
+ *******************************************************************************/
+void sim_replay_load(void)
+{
+    FILE * in;
+    long fileSize;
+    uint32_t usPerWrap;
+    uint32_t numRecords;
+    uint32_t size;
+    uint32_t pos;
+    uint32_t i;
+    uint32_t wd;
+    uint32_t prevCount = 0u;
+    uint64_t ticks = 0u;
+    bool prevActive[CY_CAPSENSE_WIDGET_COUNT];
+    bool active;
+
+    memset(sim_replay_wd, 0, sizeof(sim_replay_wd));
+    memset(prevActive, 0, sizeof(prevActive));
+    sim_replay_origin = SIM_NEVER;
+
+    if ((NULL == (in = fopen(sim_cfg.replay, "rb"))) || (0 != fseek(in, 0, SEEK_END)) ||
+        ((fileSize = ftell(in)) < (long)TUNER_TELEMETRY_RAW_FILE_HEADER_SIZE) || (0 != fseek(in, 0, SEEK_SET)))
+    {
+        sim_replay_fail("cannot read the trace file");
+    }
+    sim_replay_data = malloc((size_t)fileSize);
+    if ((NULL == sim_replay_data) || (1u != fread(sim_replay_data, (size_t)fileSize, 1u, in)))
+    {
+        sim_replay_fail("cannot read the trace file");
+    }
+    fclose(in);
+
+    usPerWrap = sim_replay_u32(&sim_replay_data[4u]);
+    numRecords = sim_replay_u32(&sim_replay_data[8u]);
+    size = sim_replay_u32(&sim_replay_data[12u]);
+    if ((0 != memcmp(sim_replay_data, TUNER_TELEMETRY_RAW_FILE_MAGIC, 4u)) || (0u == numRecords) ||
+        ((uint64_t)size != ((uint64_t)fileSize - TUNER_TELEMETRY_RAW_FILE_HEADER_SIZE)))
+    {
+        sim_replay_fail("not a raw count trace");
+    }
+
+    /* First pass validates the layout and counts the records per widget */
+    for (i = 0u, pos = 0u; i < numRecords; i++)
+    {
+        const uint8_t * rec = &sim_replay_data[TUNER_TELEMETRY_RAW_FILE_HEADER_SIZE + pos];
+
+        if ((size - pos) < TUNER_TELEMETRY_RAW_RECORD_HEADER_SIZE)
+        {
+            sim_replay_fail("truncated record");
+        }
+        if ((rec[0u] >= CY_CAPSENSE_WIDGET_COUNT) ||
+            ((rec[1u] & TUNER_TELEMETRY_RAW_SNS_MASK) != SIM_SNS_PER_WIDGET))
+        {
+            sim_replay_fail("records do not match the simulated widgets, check WIDGETS, SLOTS_PER_WIDGET and CHANNELS");
+        }
+        pos += TUNER_TELEMETRY_RAW_RECORD_HEADER_SIZE + (2u * SIM_SNS_PER_WIDGET);
+        if (pos > size)
+        {
+            sim_replay_fail("truncated record");
+        }
+        sim_replay_wd[rec[0u]].count++;
+    }
+
+    for (wd = 0u; wd < CY_CAPSENSE_WIDGET_COUNT; wd++)
+    {
+        if (0u == sim_replay_wd[wd].count)
+        {
+            sim_replay_fail("no records for some of the widgets");
+        }
+        sim_replay_wd[wd].records = calloc(sim_replay_wd[wd].count, sizeof(sim_replay_record_t));
+        sim_replay_wd[wd].onsets = calloc(sim_replay_wd[wd].count, sizeof(sim_ns_t));
+        if ((NULL == sim_replay_wd[wd].records) || (NULL == sim_replay_wd[wd].onsets))
+        {
+            sim_replay_fail("out of memory");
+        }
+        sim_replay_wd[wd].count = 0u;
+    }
+
+    for (i = 0u, pos = 0u; i < numRecords; i++)
+    {
+        const uint8_t * rec = &sim_replay_data[TUNER_TELEMETRY_RAW_FILE_HEADER_SIZE + pos];
+        uint32_t count = (uint32_t)rec[2u] | ((uint32_t)rec[3u] << 8u);
+        sim_replay_widget_t * ptrWd = &sim_replay_wd[rec[0u]];
+        sim_replay_record_t * ptrRec = &ptrWd->records[ptrWd->count];
+
+        /* A touch in progress at the start of the trace began before the
+         * recorded raw counts and is not part of the reference
+         */
+        active = (0u != (rec[1u] & TUNER_TELEMETRY_RAW_ACTIVE_MASK));
+        if (ptrWd->count < SIM_REPLAY_WARMUP_RECORDS)
+        {
+            prevActive[rec[0u]] = active;
+        }
+        ptrWd->count++;
+
+        if (0u != i)
+        {
+            ticks += (count - prevCount) & 0xFFFFu;
+        }
+        prevCount = count;
+
+        ptrRec->time = (sim_ns_t)((ticks * usPerWrap * SIM_NS_PER_US) >> 16u);
+        ptrRec->raw = &rec[TUNER_TELEMETRY_RAW_RECORD_HEADER_SIZE];
+        if (active && !prevActive[rec[0u]])
+        {
+            ptrWd->onsets[ptrWd->touches++] = ptrRec->time;
+        }
+        ptrRec->touch = (active && (0u != ptrWd->touches)) ? ptrWd->touches : 0u;
+        prevActive[rec[0u]] = active;
+        sim_replay_end = ptrRec->time;
+        pos += TUNER_TELEMETRY_RAW_RECORD_HEADER_SIZE + (2u * SIM_SNS_PER_WIDGET);
+    }
+    sim_replay_records = numRecords;
+}
+
+/*******************************************************************************
+ * Function Name: sim_replay_start
+ ********************************************************************************
+ * Summary:
+ *  Aligns the start of the trace with the current simulation time.
+ *
+ *******************************************************************************/
+void sim_replay_start(void)
+{
+    sim_replay_origin = sim_now;
+    sim_replay_clock = clock();
+}
+
+/*******************************************************************************
+ * Function Name: sim_replay_done
+ ********************************************************************************
+ * Summary:
+ *  Returns true once the given sample time is past the last record.
+ *
+ *******************************************************************************/
+bool sim_replay_done(sim_ns_t time)
+{
+    return (SIM_NEVER != sim_replay_origin) && (time > sim_replay_origin) &&
+           ((time - sim_replay_origin) > sim_replay_end);
+}
+
+/*******************************************************************************
+ * Function Name: sim_replay_raw
+ ********************************************************************************
+ * Summary:
+ *  Returns the raw count of a sensor recorded last before the given time.
+ *
+ *******************************************************************************/
+uint16_t sim_replay_raw(uint32_t widgetId, uint32_t snsId, sim_ns_t time)
+{
+    const uint8_t * raw = sim_replay_find(widgetId, time)->raw;
+    return (uint16_t)((uint32_t)raw[2u * snsId] | ((uint32_t)raw[(2u * snsId) + 1u] << 8u));
+}
+
+/*******************************************************************************
+ * Function Name: sim_replay_touch_index
+ ********************************************************************************
+ * Summary:
+ *  Returns the index (starting from 1) of the touch the target reported for
+ *  the raw counts sampled at the given time, 0 if the widget was inactive.
+ *
+ *******************************************************************************/
+uint64_t sim_replay_touch_index(uint32_t widgetId, sim_ns_t time)
+{
+    return (SIM_NEVER == sim_replay_origin) ? 0u : sim_replay_find(widgetId, time)->touch;
+}
+
+/*******************************************************************************
+ * Function Name: sim_replay_touch_onset
+ ********************************************************************************
+ * Summary:
+ *  Returns the simulation time of the record at which the target reported a
+ *  touch. Latencies are therefore relative to the detection on the target.
+ *
+ *******************************************************************************/
+sim_ns_t sim_replay_touch_onset(uint32_t widgetId, uint64_t index)
+{
+    return sim_replay_origin + sim_replay_wd[widgetId].onsets[index - 1u];
+}
+
+/*******************************************************************************
+ * Function Name: sim_replay_touches
+ ********************************************************************************
+ * Summary:
+ *  Returns the number of touches the target reported on a widget.
+ *
+ *******************************************************************************/
+uint32_t sim_replay_touches(uint32_t widgetId)
+{
+    return sim_replay_wd[widgetId].touches;
+}
+
+/*******************************************************************************
+ * Function Name: sim_replay_report
+ ********************************************************************************
+ * Summary:
+ *  Prints the size of the trace and the replay speed in frames per second of
+ *  host time.
+ *
+ *******************************************************************************/
+void sim_replay_report(double frames)
+{
+    double seconds = (double)(clock() - sim_replay_clock) / (double)CLOCKS_PER_SEC;
+
+    printf("replay                %u records, %.3f s traced, %.0f frames/s host time\n", sim_replay_records,
+           (double)sim_replay_end / (double)SIM_NS_PER_S, (seconds > 0.0) ? (frames / seconds) : 0.0);
+}
+
+/* [] END OF FILE */
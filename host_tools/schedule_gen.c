@@ -0,0 +1,490 @@
+/******************************************************************************
+ * File Name: schedule_gen.c
+ *
+ * Description: Generates the static scan schedule of each kit from the widget
+ * and slot layout of its design.cycapsense. The batches are split with the
+ * rule of scan_schedule_init() and written as a const table per kit into
+ * scan_schedule_table.h.
+ *
+ *
+ *******************************************************************************
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+#define GEN_MAX_WIDGETS                  (256u)
+#define GEN_MAX_NAME                     (64u)
+
+/* Defaults of scan_schedule.h */
+#define GEN_BATCH_WIDGETS                (0u)
+#define GEN_BATCH_MIN_SLOTS              (4u)
+
+/*******************************************************************************
+ * Types
+ *******************************************************************************/
+typedef struct
+{
+    char name[GEN_MAX_NAME];
+    uint32_t firstSlot;
+    uint32_t lastSlot;
+    uint32_t numSlots;
+} gen_widget_t;
+
+typedef struct
+{
+    uint32_t firstWidget;
+    uint32_t numWidgets;
+    uint32_t firstSlot;
+    uint32_t numSlots;
+} gen_group_t;
+
+typedef struct
+{
+    char kit[GEN_MAX_NAME];
+    gen_widget_t widgets[GEN_MAX_WIDGETS];
+    uint32_t numWidgets;
+    uint32_t numSlots;
+    gen_group_t groups[GEN_MAX_WIDGETS];
+    uint32_t numGroups;
+} gen_design_t;
+
+/*******************************************************************************
+ * Global Definitions
+ *******************************************************************************/
+/* License block of the generated header, the same as in every source file */
+static const char * const gen_license[] =
+{
+    " * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or",
+    " * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.",
+    " *",
+    " * This software, including source code, documentation and related",
+    " * materials (\"Software\") is owned by Cypress Semiconductor Corporation",
+    " * or one of its affiliates (\"Cypress\") and is protected by and subject to",
+    " * worldwide patent protection (United States and foreign),",
+    " * United States copyright laws and international treaty provisions.",
+    " * Therefore, you may use this Software only as provided in the license",
+    " * agreement accompanying the software package from which you",
+    " * obtained this Software (\"EULA\").",
+    " * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,",
+    " * non-transferable license to copy, modify, and compile the Software",
+    " * source code solely for use in connection with Cypress's",
+    " * integrated circuit products.  Any reproduction, modification, translation,",
+    " * compilation, or representation of this Software except as specified",
+    " * above is prohibited without the express written permission of Cypress.",
+    " *",
+    " * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,",
+    " * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED",
+    " * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress",
+    " * reserves the right to make changes to the Software without notice. Cypress",
+    " * does not assume any liability arising out of the application or use of the",
+    " * Software or any product or circuit described in the Software. Cypress does",
+    " * not authorize its products for use in any products where a malfunction or",
+    " * failure of the Cypress product may reasonably be expected to result in",
+    " * significant property damage, injury or death (\"High Risk Product\"). By",
+    " * including Cypress's product in a High Risk Product, the manufacturer",
+    " * of such system or application assumes all risk of such use and in doing",
+    " * so agrees to indemnify Cypress against all liability.",
+};
+
+/*******************************************************************************
+ * Function Name: gen_read_file
+ ********************************************************************************
+ * Summary:
+ *  Reads a whole file into a NUL-terminated buffer.
+ *
+ *******************************************************************************/
+static char * gen_read_file(const char * path)
+{
+    FILE * in = fopen(path, "rb");
+    char * text = NULL;
+    long size;
+
+    if (NULL == in)
+    {
+        perror(path);
+        return NULL;
+    }
+    if ((0 == fseek(in, 0, SEEK_END)) && ((size = ftell(in)) >= 0) && (0 == fseek(in, 0, SEEK_SET)))
+    {
+        text = (char *)malloc((size_t)size + 1u);
+        if ((NULL != text) && ((size_t)size != fread(text, 1u, (size_t)size, in)))
+        {
+            free(text);
+            text = NULL;
+        }
+        if (NULL != text)
+        {
+            text[size] = '\0';
+        }
+    }
+    fclose(in);
+    return text;
+}
+
+/* Copies the value of attribute attr of the element that starts at tag */
+static bool gen_attribute(const char * tag, const char * attr, char * value, size_t size)
+{
+    const char * end = strchr(tag, '>');
+    char key[GEN_MAX_NAME];
+    const char * pos;
+    size_t len;
+
+    snprintf(key, sizeof(key), " %s=\"", attr);
+    pos = strstr(tag, key);
+    if ((NULL == pos) || (NULL == end) || (pos > end))
+    {
+        return false;
+    }
+    pos += strlen(key);
+    len = strcspn(pos, "\"");
+    if (len >= size)
+    {
+        return false;
+    }
+    memcpy(value, pos, len);
+    value[len] = '\0';
+    return true;
+}
+
+/*******************************************************************************
+ * Function Name: gen_kit_name
+ ********************************************************************************
+ * Summary:
+ *  Returns the kit of a design from the TARGET_ directory in its path, with
+ *  '-' replaced by '_' as in the TARGET_ defines of the build system.
+ *
+ *******************************************************************************/
+static bool gen_kit_name(const char * path, char * kit, size_t size)
+{
+    const char * pos = strstr(path, "TARGET_");
+    size_t len;
+    size_t i;
+
+    if (NULL == pos)
+    {
+        return false;
+    }
+    pos += strlen("TARGET_");
+    len = strcspn(pos, "/\\");
+    if ((0u == len) || (len >= size))
+    {
+        return false;
+    }
+    for (i = 0u; i < len; i++)
+    {
+        kit[i] = ('-' == pos[i]) ? '_' : pos[i];
+    }
+    kit[len] = '\0';
+    return true;
+}
+
+/*******************************************************************************
+ * Function Name: gen_parse
+ ********************************************************************************
+ * Summary:
+ *  Reads the widgets in configuration order and the slots of their sensors
+ *  from the scan order. A sensor belongs to the widget whose name prefixes
+ *  the sensor name. The slots of a widget must be contiguous.
+ *
+ *******************************************************************************/
+static bool gen_parse(const char * path, gen_design_t * design)
+{
+    char * text = gen_read_file(path);
+    const char * pos;
+    const char * scanOrder;
+    char value[GEN_MAX_NAME];
+    uint32_t wd;
+
+    if (NULL == text)
+    {
+        return false;
+    }
+    design->numWidgets = 0u;
+    design->numSlots = 0u;
+
+    scanOrder = strstr(text, "<ScanOrder>");
+    for (pos = strstr(text, "<Widget "); (NULL != pos) && ((NULL == scanOrder) || (pos < scanOrder));
+         pos = strstr(pos + 1, "<Widget "))
+    {
+        gen_widget_t * widget = &design->widgets[design->numWidgets];
+
+        if ((design->numWidgets >= GEN_MAX_WIDGETS) ||
+            !gen_attribute(pos, "id", widget->name, sizeof(widget->name)))
+        {
+            fprintf(stderr, "%s: bad widget list\n", path);
+            free(text);
+            return false;
+        }
+        widget->firstSlot = UINT32_MAX;
+        widget->lastSlot = 0u;
+        widget->numSlots = 0u;
+        design->numWidgets++;
+    }
+
+    for (pos = (NULL != scanOrder) ? strstr(scanOrder, "<Sensor ") : NULL; NULL != pos;
+         pos = strstr(pos + 1, "<Sensor "))
+    {
+        char name[GEN_MAX_NAME];
+        uint32_t slot;
+
+        if (!gen_attribute(pos, "name", name, sizeof(name)) || !gen_attribute(pos, "slot", value, sizeof(value)))
+        {
+            fprintf(stderr, "%s: bad scan order\n", path);
+            free(text);
+            return false;
+        }
+        slot = (uint32_t)strtoul(value, NULL, 10);
+        for (wd = 0u; wd < design->numWidgets; wd++)
+        {
+            size_t len = strlen(design->widgets[wd].name);
+            if ((0 == strncmp(name, design->widgets[wd].name, len)) && ('_' == name[len]))
+            {
+                break;
+            }
+        }
+        if (wd == design->numWidgets)
+        {
+            fprintf(stderr, "%s: sensor %s has no widget\n", path, name);
+            free(text);
+            return false;
+        }
+        if (slot < design->widgets[wd].firstSlot)
+        {
+            design->widgets[wd].firstSlot = slot;
+        }
+        if (slot > design->widgets[wd].lastSlot)
+        {
+            design->widgets[wd].lastSlot = slot;
+        }
+        design->widgets[wd].numSlots++;
+        if (slot >= design->numSlots)
+        {
+            design->numSlots = slot + 1u;
+        }
+    }
+    free(text);
+
+    for (wd = 0u; wd < design->numWidgets; wd++)
+    {
+        const gen_widget_t * widget = &design->widgets[wd];
+
+        if ((0u == widget->numSlots) || ((widget->lastSlot - widget->firstSlot + 1u) != widget->numSlots))
+        {
+            fprintf(stderr, "%s: slots of widget %s are not contiguous\n", path, widget->name);
+            return false;
+        }
+    }
+    return (0u != design->numWidgets);
+}
+
+/*******************************************************************************
+ * Function Name: gen_batch
+ ********************************************************************************
+ * Summary:
+ *  Splits the widgets into batches with the rule of scan_schedule_init().
+ *
+ *******************************************************************************/
+static void gen_batch(gen_design_t * design, uint32_t batchWidgets, uint32_t minSlots)
+{
+    uint32_t batchSlots = design->numSlots;
+    uint32_t totalSlots = 0u;
+    gen_group_t * group = NULL;
+    uint32_t wd;
+
+    for (wd = 0u; wd < design->numWidgets; wd++)
+    {
+        totalSlots += design->widgets[wd].numSlots;
+    }
+    if (0u == batchWidgets)
+    {
+        batchWidgets = design->numWidgets;
+        batchSlots = (minSlots > (totalSlots / 2u)) ? (totalSlots / 2u) : minSlots;
+        batchSlots = (0u != batchSlots) ? batchSlots : 1u;
+    }
+
+    design->numGroups = 0u;
+    for (wd = 0u; wd < design->numWidgets; wd++)
+    {
+        const gen_widget_t * widget = &design->widgets[wd];
+        bool full = (NULL == group) ||
+                    (group->numWidgets >= batchWidgets) || (group->numSlots >= batchSlots);
+
+        if (full || ((group->firstSlot + group->numSlots) != widget->firstSlot))
+        {
+            group = &design->groups[design->numGroups++];
+            group->firstWidget = wd;
+            group->numWidgets = 0u;
+            group->firstSlot = widget->firstSlot;
+            group->numSlots = 0u;
+        }
+        group->numWidgets++;
+        group->numSlots += widget->numSlots;
+    }
+}
+
+/*******************************************************************************
+ * Function Name: gen_write
+ ********************************************************************************
+ * Summary:
+ *  Writes the table of one kit as a branch of the #if chain over the kits.
+ *
+ *******************************************************************************/
+static void gen_write(FILE * out, const gen_design_t * design, const char * path, bool first)
+{
+    uint32_t i;
+
+    while (0 == strncmp(path, "../", 3u))
+    {
+        path += 3;
+    }
+    fprintf(out, "%s defined(TARGET_APP_%s) || defined(TARGET_%s)\n", first ? "#if" : "#elif", design->kit,
+            design->kit);
+    fprintf(out, "/* %s */\n", path);
+    fprintf(out, "#define SCAN_SCHEDULE_TABLE_WIDGETS      (%uu)\n", design->numWidgets);
+    fprintf(out, "#define SCAN_SCHEDULE_TABLE_SLOTS        (%uu)\n", design->numSlots);
+    fprintf(out, "#define SCAN_SCHEDULE_TABLE_NUM_GROUPS   (%uu)\n", design->numGroups);
+    fprintf(out, "/* firstWidgetId, numWidgets, firstSlotId, numSlots */\n");
+    fprintf(out, "#define SCAN_SCHEDULE_TABLE_GROUPS \\\n");
+    fprintf(out, "{ \\\n");
+    for (i = 0u; i < design->numGroups; i++)
+    {
+        const gen_group_t * group = &design->groups[i];
+        fprintf(out, "    {%uu, %uu, %uu, %uu}, /* %s */ \\\n", group->firstWidget, group->numWidgets,
+                group->firstSlot, group->numSlots, design->widgets[group->firstWidget].name);
+    }
+    fprintf(out, "}\n");
+}
+
+int main(int argc, char * argv[])
+{
+    static gen_design_t design;
+    uint32_t batchWidgets = GEN_BATCH_WIDGETS;
+    uint32_t minSlots = GEN_BATCH_MIN_SLOTS;
+    const char * outPath = NULL;
+    FILE * out;
+    int first;
+    int i;
+    uint32_t line;
+
+    for (i = 1; (i < argc) && ('-' == argv[i][0]); i += 2)
+    {
+        if (i + 1 >= argc)
+        {
+            break;
+        }
+        if (0 == strcmp(argv[i], "-w"))
+        {
+            batchWidgets = (uint32_t)strtoul(argv[i + 1], NULL, 0);
+        }
+        else if (0 == strcmp(argv[i], "-s"))
+        {
+            minSlots = (uint32_t)strtoul(argv[i + 1], NULL, 0);
+        }
+        else if (0 == strcmp(argv[i], "-o"))
+        {
+            outPath = argv[i + 1];
+        }
+        else
+        {
+            break;
+        }
+    }
+    first = i;
+    if ((NULL == outPath) || (first >= argc))
+    {
+        fprintf(stderr, "usage: %s [-w batch widgets] [-s batch min slots] -o out.h design.cycapsense...\n",
+                argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    out = fopen(outPath, "w");
+    if (NULL == out)
+    {
+        perror(outPath);
+        return EXIT_FAILURE;
+    }
+    fprintf(out, "/******************************************************************************\n");
+    fprintf(out, " * File Name: scan_schedule_table.h\n");
+    fprintf(out, " *\n");
+    fprintf(out, " * Description: Static scan schedule of each kit. Generated from the\n");
+    fprintf(out, " * design.cycapsense of the kit by host_tools/schedule_gen; do not edit.\n");
+    fprintf(out, " * Regenerate with \"make -C host_tools schedule\" after a layout change.\n");
+    fprintf(out, " *\n");
+    fprintf(out, " * Related Document: See README.md\n");
+    fprintf(out, " *\n");
+    fprintf(out, " *******************************************************************************\n");
+    for (line = 0u; line < (sizeof(gen_license) / sizeof(gen_license[0u])); line++)
+    {
+        fprintf(out, "%s\n", gen_license[line]);
+    }
+    fprintf(out, " *******************************************************************************/\n\n");
+    fprintf(out, "#ifndef SCAN_SCHEDULE_TABLE_H\n#define SCAN_SCHEDULE_TABLE_H\n\n");
+    fprintf(out, "/* Batching the tables were generated for */\n");
+    fprintf(out, "#define SCAN_SCHEDULE_TABLE_BATCH_WIDGETS (%uu)\n", batchWidgets);
+    fprintf(out, "#define SCAN_SCHEDULE_TABLE_BATCH_MIN_SLOTS (%uu)\n\n", minSlots);
+
+    for (i = first; i < argc; i++)
+    {
+        if (!gen_kit_name(argv[i], design.kit, sizeof(design.kit)))
+        {
+            fprintf(stderr, "%s: no TARGET_ directory in the path\n", argv[i]);
+            fclose(out);
+            return EXIT_FAILURE;
+        }
+        if (!gen_parse(argv[i], &design))
+        {
+            fclose(out);
+            return EXIT_FAILURE;
+        }
+        gen_batch(&design, batchWidgets, minSlots);
+        gen_write(out, &design, argv[i], (i == first));
+        printf("%s: %u widgets, %u slots, %u batches\n", design.kit, design.numWidgets, design.numSlots,
+               design.numGroups);
+    }
+
+    fprintf(out, "#endif\n\n#endif /* SCAN_SCHEDULE_TABLE_H */\n\n/* [] END OF FILE */\n");
+    fclose(out);
+    return EXIT_SUCCESS;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,778 @@
+/******************************************************************************
+ * File Name: tuner_decoder.c
+ *
+ * Description: Host decoder of the delta-encoded tuner telemetry. The parser
+ * consumes the stream byte by byte and knows the length of a frame from its
+ * header and the record layout, so frames of any length are found without
+ * scanning for the tail. Malformed frames are dropped and the parser hunts for
+ * the next frame header. Delta frames are applied only in sequence; after a
+ * gap the decoder waits for the next keyframe.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include <stdlib.h>
+#include <string.h>
+#include "tuner_decoder.h"
+#include "tuner_telemetry.h"
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+#define DECODER_FRAME_HEADER0            (0x0Du)
+#define DECODER_FRAME_HEADER1            (0x0Au)
+#define DECODER_TAIL_SIZE                (3u)
+
+/* Sanity limit of a keyframe image, rejects layouts from corrupted headers */
+#define DECODER_MAX_IMAGE_SIZE           (1024u * 1024u)
+#define DECODER_MIN_FRAME_CAP            (64u)
+
+/* Parser states */
+#define DECODER_HUNT_HEADER0             (0u)
+#define DECODER_HUNT_HEADER1             (1u)
+#define DECODER_PAYLOAD_HEADER           (2u)
+#define DECODER_KEYFRAME_LAYOUT          (3u)
+#define DECODER_KEYFRAME_IMAGE           (4u)
+#define DECODER_RECORD_INDEX             (5u)
+#define DECODER_RECORD_DATA              (6u)
+#define DECODER_TAIL                     (7u)
+#define DECODER_TRACE_HEADER             (8u)
+#define DECODER_TRACE_RECORDS            (9u)
+#define DECODER_RAW_HEADER               (10u)
+#define DECODER_RAW_RECORDS              (11u)
+
+/* Fields of a trace statistics record (stage_trace_stats_t) */
+#define DECODER_TRACE_SUM                (0u)
+#define DECODER_TRACE_COUNT              (8u)
+#define DECODER_TRACE_MIN                (12u)
+#define DECODER_TRACE_MAX                (16u)
+#define DECODER_TRACE_HISTOGRAM          (20u)
+
+/*******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+static uint32_t decoder_get_u16(const uint8_t * src);
+static uint32_t decoder_get_u32(const uint8_t * src);
+static bool decoder_record_span(const tuner_decoder_layout_t * layout, uint32_t index,
+                                uint32_t * offset, uint32_t * size);
+static bool decoder_reserve(tuner_decoder_t * decoder, uint32_t size);
+static bool decoder_step(tuner_decoder_t * decoder);
+static void decoder_parse(tuner_decoder_t * decoder, const uint8_t * data, size_t size);
+static void decoder_resync(tuner_decoder_t * decoder);
+static void decoder_apply(tuner_decoder_t * decoder);
+static void decoder_apply_trace(tuner_decoder_t * decoder);
+static void decoder_apply_raw(tuner_decoder_t * decoder);
+
+/*******************************************************************************
+ * Function Name: tuner_decoder_init
+ ********************************************************************************
+ * Summary:
+ *  Initializes a decoder. No image is available before the first keyframe.
+ *
+ * Parameters:
+ *  decoder - decoder
+ *  callback - called after each applied frame, may be NULL
+ *  user - passed to the callback
+ *
+ *******************************************************************************/
+void tuner_decoder_init(tuner_decoder_t * decoder, tuner_decoder_frame_cb_t callback, void * user)
+{
+    memset(decoder, 0, sizeof(*decoder));
+    decoder->state = DECODER_HUNT_HEADER0;
+    decoder->callback = callback;
+    decoder->user = user;
+}
+
+/*******************************************************************************
+ * Function Name: tuner_decoder_free
+ ********************************************************************************
+ * Summary:
+ *  Releases the image and frame buffers.
+ *
+ *******************************************************************************/
+void tuner_decoder_free(tuner_decoder_t * decoder)
+{
+    free(decoder->image);
+    free(decoder->frame);
+    free(decoder->trace.records);
+    free(decoder->raw.records);
+    decoder->image = NULL;
+    decoder->frame = NULL;
+    decoder->trace.records = NULL;
+    decoder->raw.records = NULL;
+    decoder->frameCap = 0u;
+}
+
+/*******************************************************************************
+ * Function Name: tuner_decoder_feed
+ ********************************************************************************
+ * Summary:
+ *  Parses received bytes. Frames are applied and reported through the
+ *  callback as soon as their last byte is received.
+ *
+ * Parameters:
+ *  decoder - decoder
+ *  data - received bytes
+ *  size - number of bytes
+ *
+ *******************************************************************************/
+void tuner_decoder_feed(tuner_decoder_t * decoder, const uint8_t * data, size_t size)
+{
+    decoder->stats.bytes += size;
+    decoder_parse(decoder, data, size);
+}
+
+/*******************************************************************************
+ * Function Name: tuner_decoder_record
+ ********************************************************************************
+ * Summary:
+ *  Returns a record of the rebuilt image.
+ *
+ * Return:
+ *  Record data, NULL if there is no image or the index is out of range
+ *
+ * Parameters:
+ *  decoder - decoder
+ *  index - record index, see tuner_telemetry.h
+ *  size - receives the record size, may be NULL
+ *
+ *******************************************************************************/
+const uint8_t * tuner_decoder_record(const tuner_decoder_t * decoder, uint32_t index, uint32_t * size)
+{
+    uint32_t offset;
+    uint32_t recordSize;
+
+    if ((NULL == decoder->image) || !decoder_record_span(&decoder->layout, index, &offset, &recordSize))
+    {
+        return NULL;
+    }
+    if (NULL != size)
+    {
+        *size = recordSize;
+    }
+    return &decoder->image[offset];
+}
+
+/* Widget context of the rebuilt image, NULL if not available */
+const uint8_t * tuner_decoder_widget(const tuner_decoder_t * decoder, uint32_t widgetId)
+{
+    if (widgetId >= decoder->layout.numWidgets)
+    {
+        return NULL;
+    }
+    return tuner_decoder_record(decoder, 1u + widgetId, NULL);
+}
+
+/* Sensor context of the rebuilt image, NULL if not available */
+const uint8_t * tuner_decoder_sensor(const tuner_decoder_t * decoder, uint32_t sensorId)
+{
+    if (sensorId >= decoder->layout.numSensors)
+    {
+        return NULL;
+    }
+    return tuner_decoder_record(decoder, 1u + decoder->layout.numWidgets + sensorId, NULL);
+}
+
+/*******************************************************************************
+ * Function Name: tuner_decoder_trace_stats
+ ********************************************************************************
+ * Summary:
+ *  Returns a stage statistics record of the last trace frames. Durations are
+ *  in CPU cycles of trace.clockHz.
+ *
+ * Return:
+ *  false if no trace frame carried the record yet
+ *
+ * Parameters:
+ *  decoder - decoder
+ *  index - record, stages first, then widgets
+ *  count, min, max, sum - receive the statistics
+ *
+ *******************************************************************************/
+bool tuner_decoder_trace_stats(const tuner_decoder_t * decoder, uint32_t index, uint32_t * count,
+                               uint32_t * min, uint32_t * max, uint64_t * sum)
+{
+    const uint8_t * rec;
+
+    if ((NULL == decoder->trace.records) || (index >= decoder->trace.numRecords))
+    {
+        return false;
+    }
+    rec = &decoder->trace.records[index * decoder->trace.recordSize];
+    *count = decoder_get_u32(&rec[DECODER_TRACE_COUNT]);
+    *min = decoder_get_u32(&rec[DECODER_TRACE_MIN]);
+    *max = decoder_get_u32(&rec[DECODER_TRACE_MAX]);
+    *sum = (uint64_t)decoder_get_u32(&rec[DECODER_TRACE_SUM]) |
+           ((uint64_t)decoder_get_u32(&rec[DECODER_TRACE_SUM + 4u]) << 32u);
+    return (0u != *count);
+}
+
+/* Histogram bin of a stage statistics record, 0 if not available */
+uint32_t tuner_decoder_trace_histogram(const tuner_decoder_t * decoder, uint32_t index, uint32_t bin)
+{
+    if ((NULL == decoder->trace.records) || (index >= decoder->trace.numRecords) ||
+        (bin >= decoder->trace.histogramBins))
+    {
+        return 0u;
+    }
+    return decoder_get_u16(&decoder->trace.records[(index * decoder->trace.recordSize) +
+                                                   DECODER_TRACE_HISTOGRAM + (2u * bin)]);
+}
+
+/*******************************************************************************
+ * Function Name: decoder_parse
+ ********************************************************************************
+ * Summary:
+ *  Runs the frame parser over a block of bytes.
+ *
+ *******************************************************************************/
+static void decoder_parse(tuner_decoder_t * decoder, const uint8_t * data, size_t size)
+{
+    size_t i;
+
+    for (i = 0u; i < size; i++)
+    {
+        uint8_t byte = data[i];
+
+        switch (decoder->state)
+        {
+            case DECODER_HUNT_HEADER0:
+                if (DECODER_FRAME_HEADER0 == byte)
+                {
+                    decoder->state = DECODER_HUNT_HEADER1;
+                }
+                break;
+
+            case DECODER_HUNT_HEADER1:
+                if (DECODER_FRAME_HEADER1 == byte)
+                {
+                    decoder->frameLen = 0u;
+                    decoder->need = TUNER_TELEMETRY_HEADER_SIZE;
+                    decoder->state = DECODER_PAYLOAD_HEADER;
+                    if (!decoder_reserve(decoder, DECODER_MIN_FRAME_CAP))
+                    {
+                        decoder->state = DECODER_HUNT_HEADER0;
+                    }
+                }
+                else if (DECODER_FRAME_HEADER0 != byte)
+                {
+                    decoder->state = DECODER_HUNT_HEADER0;
+                }
+                break;
+
+            default:
+                decoder->frame[decoder->frameLen++] = byte;
+                if (decoder->frameLen == decoder->need)
+                {
+                    if (!decoder_step(decoder))
+                    {
+                        decoder->stats.errors++;
+                        decoder_resync(decoder);
+                    }
+                }
+                break;
+        }
+    }
+}
+
+/*******************************************************************************
+ * Function Name: decoder_resync
+ ********************************************************************************
+ * Summary:
+ *  Drops a malformed frame. Its bytes are parsed again from the byte after
+ *  its header, so that a valid frame starting inside it is not lost, for
+ *  example after a header received from line noise. Each pass starts later in
+ *  the stream, so the recursion ends.
+ *
+ *******************************************************************************/
+static void decoder_resync(tuner_decoder_t * decoder)
+{
+    uint32_t size = decoder->frameLen;
+    uint8_t * bytes = (uint8_t *)malloc(size);
+
+    decoder->state = DECODER_HUNT_HEADER0;
+    if (NULL != bytes)
+    {
+        memcpy(bytes, decoder->frame, size);
+        decoder_parse(decoder, bytes, size);
+        free(bytes);
+    }
+}
+
+static uint32_t decoder_get_u16(const uint8_t * src)
+{
+    return (uint32_t)src[0u] | ((uint32_t)src[1u] << 8u);
+}
+
+static uint32_t decoder_get_u32(const uint8_t * src)
+{
+    return decoder_get_u16(&src[0u]) | (decoder_get_u16(&src[2u]) << 16u);
+}
+
+/*******************************************************************************
+ * Function Name: decoder_record_span
+ ********************************************************************************
+ * Summary:
+ *  Returns the offset of a record in the image and its size.
+ *
+ *******************************************************************************/
+static bool decoder_record_span(const tuner_decoder_layout_t * layout, uint32_t index,
+                                uint32_t * offset, uint32_t * size)
+{
+    uint32_t sensorsEnd = layout->commonSize + (layout->numWidgets * layout->widgetSize) +
+                          (layout->numSensors * layout->sensorSize);
+
+    if (index >= layout->numRecords)
+    {
+        return false;
+    }
+    if (0u == index)
+    {
+        *offset = 0u;
+        *size = layout->commonSize;
+    }
+    else if (index <= layout->numWidgets)
+    {
+        *offset = layout->commonSize + ((index - 1u) * layout->widgetSize);
+        *size = layout->widgetSize;
+    }
+    else if (index <= (layout->numWidgets + layout->numSensors))
+    {
+        *offset = layout->commonSize + (layout->numWidgets * layout->widgetSize) +
+                  ((index - 1u - layout->numWidgets) * layout->sensorSize);
+        *size = layout->sensorSize;
+    }
+    else
+    {
+        *offset = sensorsEnd;
+        *size = layout->extraSize;
+    }
+    return true;
+}
+
+static bool decoder_reserve(tuner_decoder_t * decoder, uint32_t size)
+{
+    uint8_t * frame;
+
+    if (size <= decoder->frameCap)
+    {
+        return true;
+    }
+    frame = (uint8_t *)realloc(decoder->frame, size);
+    if (NULL == frame)
+    {
+        return false;
+    }
+    decoder->frame = frame;
+    decoder->frameCap = size;
+    return true;
+}
+
+/*******************************************************************************
+ * Function Name: decoder_step
+ ********************************************************************************
+ * Summary:
+ *  Called when the bytes needed by the current parser state are received.
+ *  Selects the next state and the number of bytes it needs.
+ *
+ * Return:
+ *  false if the frame is malformed
+ *
+ *******************************************************************************/
+static bool decoder_step(tuner_decoder_t * decoder)
+{
+    const uint8_t * frame = decoder->frame;
+    tuner_decoder_layout_t * layout = &decoder->frameLayout;
+    uint32_t offset;
+    uint32_t size;
+
+    switch (decoder->state)
+    {
+        case DECODER_PAYLOAD_HEADER:
+            decoder->recordsLeft = decoder_get_u16(&frame[2u]);
+            if (TUNER_TELEMETRY_KEYFRAME == frame[0u])
+            {
+                decoder->need = TUNER_TELEMETRY_KEYFRAME_HEADER_SIZE;
+                decoder->state = DECODER_KEYFRAME_LAYOUT;
+            }
+            else if (TUNER_TELEMETRY_DELTA_FRAME == frame[0u])
+            {
+                /* Delta frames are parsed with the layout of the last keyframe */
+                if ((NULL == decoder->image) || (decoder->recordsLeft > decoder->layout.numRecords))
+                {
+                    return false;
+                }
+                *layout = decoder->layout;
+                if (0u == decoder->recordsLeft)
+                {
+                    decoder->need += DECODER_TAIL_SIZE;
+                    decoder->state = DECODER_TAIL;
+                }
+                else
+                {
+                    decoder->need += TUNER_TELEMETRY_INDEX_SIZE;
+                    decoder->state = DECODER_RECORD_INDEX;
+                }
+            }
+            else if (TUNER_TELEMETRY_TRACE_FRAME == frame[0u])
+            {
+                decoder->need = TUNER_TELEMETRY_TRACE_HEADER_SIZE;
+                decoder->state = DECODER_TRACE_HEADER;
+            }
+            else if (TUNER_TELEMETRY_RAW_FRAME == frame[0u])
+            {
+                decoder->need = TUNER_TELEMETRY_RAW_HEADER_SIZE;
+                decoder->state = DECODER_RAW_HEADER;
+            }
+            else
+            {
+                return false;
+            }
+            break;
+
+        case DECODER_TRACE_HEADER:
+            /* frame[4] first record, [5] total records, [6..7] record size, [9] bins */
+            size = decoder_get_u16(&frame[6u]);
+            if ((0u == decoder->recordsLeft) || ((frame[4u] + decoder->recordsLeft) > frame[5u]) ||
+                (size < (DECODER_TRACE_HISTOGRAM + (2u * frame[9u]))))
+            {
+                return false;
+            }
+            if (!decoder_reserve(decoder, TUNER_TELEMETRY_TRACE_HEADER_SIZE + (decoder->recordsLeft * size) +
+                                 DECODER_TAIL_SIZE))
+            {
+                return false;
+            }
+            decoder->need += decoder->recordsLeft * size;
+            decoder->state = DECODER_TRACE_RECORDS;
+            break;
+
+        case DECODER_RAW_HEADER:
+            /* frame[12..13] record bytes */
+            size = decoder_get_u16(&frame[12u]);
+            if (!decoder_reserve(decoder, TUNER_TELEMETRY_RAW_HEADER_SIZE + size + DECODER_TAIL_SIZE))
+            {
+                return false;
+            }
+            decoder->need += size;
+            decoder->state = DECODER_RAW_RECORDS;
+            if (0u == size)
+            {
+                decoder->need += DECODER_TAIL_SIZE;
+                decoder->state = DECODER_TAIL;
+            }
+            break;
+
+        case DECODER_KEYFRAME_LAYOUT:
+            layout->numWidgets = decoder_get_u16(&frame[4u]);
+            layout->numSensors = decoder_get_u16(&frame[6u]);
+            layout->commonSize = decoder_get_u16(&frame[8u]);
+            layout->widgetSize = decoder_get_u16(&frame[10u]);
+            layout->sensorSize = decoder_get_u16(&frame[12u]);
+            layout->extraSize = decoder_get_u16(&frame[14u]);
+            layout->numRecords = 1u + layout->numWidgets + layout->numSensors +
+                                 ((0u != layout->extraSize) ? 1u : 0u);
+            layout->imageSize = layout->commonSize + (layout->numWidgets * layout->widgetSize) +
+                                (layout->numSensors * layout->sensorSize) + layout->extraSize;
+            if ((layout->numRecords != decoder->recordsLeft) || (0u == layout->imageSize) ||
+                (layout->imageSize > DECODER_MAX_IMAGE_SIZE))
+            {
+                return false;
+            }
+            /* Room for a keyframe and for the largest delta frame */
+            if (!decoder_reserve(decoder, TUNER_TELEMETRY_KEYFRAME_HEADER_SIZE + layout->imageSize +
+                                 (layout->numRecords * TUNER_TELEMETRY_INDEX_SIZE) + DECODER_TAIL_SIZE))
+            {
+                return false;
+            }
+            decoder->need += layout->imageSize;
+            decoder->state = DECODER_KEYFRAME_IMAGE;
+            break;
+
+        case DECODER_KEYFRAME_IMAGE:
+        case DECODER_TRACE_RECORDS:
+        case DECODER_RAW_RECORDS:
+        case DECODER_RECORD_DATA:
+            if ((DECODER_RECORD_DATA == decoder->state) && (0u != --decoder->recordsLeft))
+            {
+                decoder->need += TUNER_TELEMETRY_INDEX_SIZE;
+                decoder->state = DECODER_RECORD_INDEX;
+            }
+            else
+            {
+                decoder->need += DECODER_TAIL_SIZE;
+                decoder->state = DECODER_TAIL;
+            }
+            break;
+
+        case DECODER_RECORD_INDEX:
+            if (!decoder_record_span(layout, decoder_get_u16(&frame[decoder->frameLen - 2u]), &offset, &size))
+            {
+                return false;
+            }
+            if ((decoder->need + size + DECODER_TAIL_SIZE) > decoder->frameCap)
+            {
+                return false;
+            }
+            decoder->need += size;
+            decoder->state = DECODER_RECORD_DATA;
+            break;
+
+        case DECODER_TAIL:
+            frame = &frame[decoder->frameLen - DECODER_TAIL_SIZE];
+            if ((0x00u != frame[0u]) || (0xFFu != frame[1u]) || (0xFFu != frame[2u]))
+            {
+                return false;
+            }
+            decoder_apply(decoder);
+            decoder->state = DECODER_HUNT_HEADER0;
+            break;
+
+        default:
+            return false;
+    }
+    return true;
+}
+
+/*******************************************************************************
+ * Function Name: decoder_apply
+ ********************************************************************************
+ * Summary:
+ *  Applies a complete frame to the image.
+ *
+ *******************************************************************************/
+static void decoder_apply(tuner_decoder_t * decoder)
+{
+    const uint8_t * frame = decoder->frame;
+    uint8_t frameType = frame[0u];
+    uint8_t seq = frame[1u];
+
+    if (TUNER_TELEMETRY_TRACE_FRAME == frameType)
+    {
+        decoder_apply_trace(decoder);
+        return;
+    }
+    if (TUNER_TELEMETRY_RAW_FRAME == frameType)
+    {
+        decoder_apply_raw(decoder);
+        return;
+    }
+
+    if (TUNER_TELEMETRY_KEYFRAME == frameType)
+    {
+        if ((NULL == decoder->image) || (decoder->layout.imageSize != decoder->frameLayout.imageSize))
+        {
+            uint8_t * image = (uint8_t *)realloc(decoder->image, decoder->frameLayout.imageSize);
+            if (NULL == image)
+            {
+                decoder->stats.errors++;
+                return;
+            }
+            decoder->image = image;
+        }
+        if (decoder->synced && (seq != (uint8_t)(decoder->seq + 1u)))
+        {
+            decoder->stats.lost++;
+        }
+        decoder->layout = decoder->frameLayout;
+        memcpy(decoder->image, &frame[TUNER_TELEMETRY_KEYFRAME_HEADER_SIZE], decoder->layout.imageSize);
+        decoder->stats.keyframes++;
+    }
+    else
+    {
+        uint32_t count = decoder_get_u16(&frame[2u]);
+        uint32_t pos = TUNER_TELEMETRY_HEADER_SIZE;
+
+        if (!decoder->synced)
+        {
+            decoder->stats.dropped++;
+            return;
+        }
+        if (seq != (uint8_t)(decoder->seq + 1u))
+        {
+            decoder->stats.lost++;
+            decoder->stats.dropped++;
+            decoder->synced = false;
+            return;
+        }
+        while (0u != count--)
+        {
+            uint32_t offset;
+            uint32_t size;
+
+            (void)decoder_record_span(&decoder->layout, decoder_get_u16(&frame[pos]), &offset, &size);
+            pos += TUNER_TELEMETRY_INDEX_SIZE;
+            memcpy(&decoder->image[offset], &frame[pos], size);
+            pos += size;
+        }
+        decoder->stats.deltas++;
+    }
+
+    decoder->synced = true;
+    decoder->seq = seq;
+    if (NULL != decoder->callback)
+    {
+        decoder->callback(decoder, frameType, decoder->user);
+    }
+}
+
+/*******************************************************************************
+ * Function Name: decoder_apply_trace
+ ********************************************************************************
+ * Summary:
+ *  Stores the stage statistics records of a trace frame. Trace frames have
+ *  their own sequence and do not affect the image.
+ *
+ *******************************************************************************/
+static void decoder_apply_trace(tuner_decoder_t * decoder)
+{
+    const uint8_t * frame = decoder->frame;
+    tuner_decoder_trace_t * trace = &decoder->trace;
+    uint32_t count = decoder_get_u16(&frame[2u]);
+    uint32_t first = frame[4u];
+    uint32_t numRecords = frame[5u];
+    uint32_t recordSize = decoder_get_u16(&frame[6u]);
+
+    if ((NULL == trace->records) || (numRecords != trace->numRecords) || (recordSize != trace->recordSize))
+    {
+        uint8_t * records = (uint8_t *)calloc(numRecords, recordSize);
+        if (NULL == records)
+        {
+            decoder->stats.errors++;
+            return;
+        }
+        free(trace->records);
+        trace->records = records;
+        trace->numRecords = numRecords;
+        trace->recordSize = recordSize;
+    }
+    trace->numStages = frame[8u];
+    trace->histogramBins = frame[9u];
+    trace->histogramShift = frame[10u];
+    trace->clockHz = decoder_get_u32(&frame[12u]);
+    memcpy(&trace->records[first * recordSize], &frame[TUNER_TELEMETRY_TRACE_HEADER_SIZE], count * recordSize);
+    decoder->stats.traces++;
+
+    if (NULL != decoder->callback)
+    {
+        decoder->callback(decoder, TUNER_TELEMETRY_TRACE_FRAME, decoder->user);
+    }
+}
+
+/*******************************************************************************
+ * Function Name: decoder_apply_raw
+ ********************************************************************************
+ * Summary:
+ *  Appends the records of a raw trace frame to the dump being received. The
+ *  first frame of a dump starts a new one. A dump with a missing frame is
+ *  marked damaged, since the replay needs every record.
+ *
+ *******************************************************************************/
+static void decoder_apply_raw(tuner_decoder_t * decoder)
+{
+    const uint8_t * frame = decoder->frame;
+    tuner_decoder_raw_t * raw = &decoder->raw;
+    uint32_t count = decoder_get_u16(&frame[2u]);
+    uint32_t dump = decoder_get_u16(&frame[4u]);
+    uint32_t size = decoder_get_u16(&frame[12u]);
+    uint32_t frameNumber = decoder_get_u16(&frame[14u]);
+    const uint8_t * records = &frame[TUNER_TELEMETRY_RAW_HEADER_SIZE];
+    uint32_t pos = 0u;
+    uint32_t i;
+
+    /* The records must fill the frame exactly */
+    for (i = 0u; (i < count) && ((pos + TUNER_TELEMETRY_RAW_RECORD_HEADER_SIZE) <= size); i++)
+    {
+        pos += TUNER_TELEMETRY_RAW_RECORD_HEADER_SIZE + (2u * (records[pos + 1u] & TUNER_TELEMETRY_RAW_SNS_MASK));
+    }
+    if ((i != count) || (pos != size))
+    {
+        decoder->stats.errors++;
+        return;
+    }
+
+    if (0u == frameNumber)
+    {
+        raw->dump = dump;
+        raw->numRecords = 0u;
+        raw->size = 0u;
+        raw->complete = false;
+        raw->damaged = false;
+    }
+    else if ((dump != raw->dump) || (frameNumber != raw->nextFrame) || raw->complete)
+    {
+        /* The start of the dump or a frame in between was lost */
+        decoder->stats.lost++;
+        raw->dump = dump;
+        raw->complete = false;
+        raw->damaged = true;
+    }
+    raw->nextFrame = frameNumber + 1u;
+
+    if ((raw->size + size) > raw->cap)
+    {
+        uint32_t cap = (raw->size + size) * 2u;
+        uint8_t * grown = (uint8_t *)realloc(raw->records, cap);
+        if (NULL == grown)
+        {
+            decoder->stats.errors++;
+            raw->damaged = true;
+            return;
+        }
+        raw->records = grown;
+        raw->cap = cap;
+    }
+    memcpy(&raw->records[raw->size], records, size);
+    raw->size += size;
+    raw->numRecords += count;
+    raw->usPerWrap = decoder_get_u32(&frame[8u]);
+    raw->complete = (0u != (frame[6u] & TUNER_TELEMETRY_RAW_LAST));
+    if (raw->complete && !raw->damaged)
+    {
+        decoder->stats.rawDumps++;
+    }
+    decoder->stats.raws++;
+    decoder->stats.rawBytes += TUNER_TELEMETRY_RAW_HEADER_SIZE + size;
+
+    if (NULL != decoder->callback)
+    {
+        decoder->callback(decoder, TUNER_TELEMETRY_RAW_FRAME, decoder->user);
+    }
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,154 @@
+/******************************************************************************
+ * File Name: tuner_decoder.h
+ *
+ * Description: Host decoder of the delta-encoded tuner telemetry (see
+ * tuner_telemetry.h). Parses the UART byte stream, applies keyframes and delta
+ * frames, and keeps the rebuilt tuner data image. Builds with any C99 host
+ * compiler.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+
+#ifndef TUNER_DECODER_H
+#define TUNER_DECODER_H
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/*******************************************************************************
+ * Types
+ *******************************************************************************/
+/* Record layout announced by the last keyframe */
+typedef struct
+{
+    uint32_t numWidgets;
+    uint32_t numSensors;
+    uint32_t commonSize;
+    uint32_t widgetSize;
+    uint32_t sensorSize;
+    uint32_t extraSize;
+    uint32_t numRecords;
+    uint32_t imageSize;
+} tuner_decoder_layout_t;
+
+/* Stage statistics announced by the last trace frame, see stage_trace.h */
+typedef struct
+{
+    uint32_t numRecords;              /* stages, then widgets */
+    uint32_t numStages;
+    uint32_t recordSize;
+    uint32_t histogramBins;
+    uint32_t histogramShift;
+    uint32_t clockHz;
+    uint8_t * records;                /* numRecords records of recordSize bytes */
+} tuner_decoder_trace_t;
+
+/* Raw count dump being received, see tuner_telemetry.h */
+typedef struct
+{
+    uint32_t dump;                    /* dump number */
+    uint32_t usPerWrap;               /* microseconds per 65536 WDT ticks */
+    uint32_t numRecords;
+    uint32_t size;                    /* record bytes */
+    uint32_t cap;
+    uint8_t * records;
+    uint32_t nextFrame;               /* expected frame number within the dump */
+    bool complete;                    /* last frame received */
+    bool damaged;                     /* a frame of the dump was lost */
+} tuner_decoder_raw_t;
+
+typedef struct
+{
+    uint64_t bytes;                   /* bytes fed */
+    uint64_t keyframes;               /* keyframes applied */
+    uint64_t deltas;                  /* delta frames applied */
+    uint64_t traces;                  /* trace frames applied */
+    uint64_t raws;                    /* raw trace frames applied */
+    uint64_t rawDumps;                /* raw count dumps completed without loss */
+    uint64_t rawBytes;                /* payload bytes of the raw trace frames */
+    uint64_t dropped;                 /* delta frames dropped while out of sync */
+    uint64_t lost;                    /* sequence gaps */
+    uint64_t errors;                  /* malformed frames */
+} tuner_decoder_stats_t;
+
+typedef struct tuner_decoder tuner_decoder_t;
+
+/* Called after each applied frame */
+typedef void (* tuner_decoder_frame_cb_t)(const tuner_decoder_t * decoder, uint8_t frameType, void * user);
+
+struct tuner_decoder
+{
+    tuner_decoder_layout_t layout;
+    uint8_t * image;                  /* records in index order */
+    bool synced;                      /* image is current */
+    uint8_t seq;                      /* sequence number of the image */
+    tuner_decoder_stats_t stats;
+    tuner_decoder_trace_t trace;
+    tuner_decoder_raw_t raw;
+
+    /* Frame parser */
+    uint32_t state;
+    uint8_t * frame;
+    uint32_t frameCap;
+    uint32_t frameLen;
+    uint32_t need;
+    uint32_t recordsLeft;
+    tuner_decoder_layout_t frameLayout;
+
+    tuner_decoder_frame_cb_t callback;
+    void * user;
+};
+
+/*******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+void tuner_decoder_init(tuner_decoder_t * decoder, tuner_decoder_frame_cb_t callback, void * user);
+void tuner_decoder_free(tuner_decoder_t * decoder);
+void tuner_decoder_feed(tuner_decoder_t * decoder, const uint8_t * data, size_t size);
+const uint8_t * tuner_decoder_record(const tuner_decoder_t * decoder, uint32_t index, uint32_t * size);
+const uint8_t * tuner_decoder_widget(const tuner_decoder_t * decoder, uint32_t widgetId);
+const uint8_t * tuner_decoder_sensor(const tuner_decoder_t * decoder, uint32_t sensorId);
+bool tuner_decoder_trace_stats(const tuner_decoder_t * decoder, uint32_t index, uint32_t * count,
+                               uint32_t * min, uint32_t * max, uint64_t * sum);
+uint32_t tuner_decoder_trace_histogram(const tuner_decoder_t * decoder, uint32_t index, uint32_t bin);
+
+#endif /* TUNER_DECODER_H */
+
+/* [] END OF FILE */
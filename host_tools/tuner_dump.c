@@ -0,0 +1,292 @@
+/******************************************************************************
+ * File Name: tuner_dump.c
+ *
+ * Description: Command-line dump of a delta-encoded tuner telemetry stream,
+ * for example a capture of the tuner UART or the SIM_UART_CAPTURE output of
+ * the host simulation. Prints the rebuilt sensor data of every frame on
+ * request and a summary of the stream, and writes the raw count dumps to a
+ * trace file for the replay in the host simulation.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "tuner_decoder.h"
+#include "tuner_telemetry.h"
+#include "stage_trace.h"
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+#define DUMP_READ_SIZE                   (4096u)
+/* Frame header and tail of the full tuner frame */
+#define DUMP_FULL_FRAME_OVERHEAD         (5u)
+
+/*******************************************************************************
+ * Types
+ *******************************************************************************/
+typedef struct
+{
+    bool verbose;                     /* print every frame */
+    const char * rawPath;             /* trace file of the raw count dumps, or NULL */
+    uint32_t rawWritten;              /* dumps written */
+} dump_options_t;
+
+/*******************************************************************************
+ * Global Definitions
+ *******************************************************************************/
+/* Names of the pipeline stages, in stage_trace_stage_t order */
+static const char * const dump_stage_names[STAGE_TRACE_STAGE_COUNT] =
+{
+    "scan", "process", "led", "tuner", "wdt", "sleep", "deepsleep", "wake"
+};
+
+/*******************************************************************************
+ * Function Name: dump_trace
+ ********************************************************************************
+ * Summary:
+ *  Prints the stage statistics of the last trace frames in microseconds, with
+ *  the histogram bins in CPU cycles.
+ *
+ *******************************************************************************/
+static void dump_trace(const tuner_decoder_t * decoder)
+{
+    const tuner_decoder_trace_t * trace = &decoder->trace;
+    double usPerCycle = (0u != trace->clockHz) ? (1.0e6 / (double)trace->clockHz) : 0.0;
+    uint32_t index;
+    uint32_t bin;
+
+    printf("trace        %u records, CPU clock %u Hz\n", trace->numRecords, trace->clockHz);
+    printf("  %-12s %10s %10s %10s %10s  histogram from %u cycles\n", "stage", "count", "min us",
+           "mean us", "max us", 1u << trace->histogramShift);
+    for (index = 0u; index < trace->numRecords; index++)
+    {
+        char name[16];
+        uint32_t count;
+        uint32_t min;
+        uint32_t max;
+        uint64_t sum;
+
+        if (!tuner_decoder_trace_stats(decoder, index, &count, &min, &max, &sum))
+        {
+            continue;
+        }
+        if ((index < trace->numStages) && (index < STAGE_TRACE_STAGE_COUNT))
+        {
+            snprintf(name, sizeof(name), "%s", dump_stage_names[index]);
+        }
+        else
+        {
+            snprintf(name, sizeof(name), "widget %u", index - trace->numStages);
+        }
+        printf("  %-12s %10u %10.1f %10.1f %10.1f ", name, count, min * usPerCycle,
+               ((double)sum / (double)count) * usPerCycle, max * usPerCycle);
+        for (bin = 0u; bin < trace->histogramBins; bin++)
+        {
+            printf(" %u", tuner_decoder_trace_histogram(decoder, index, bin));
+        }
+        printf("\n");
+    }
+}
+
+/*******************************************************************************
+ * Function Name: dump_write_raw
+ ********************************************************************************
+ * Summary:
+ *  Writes a complete raw count dump as a trace file, replacing the previous
+ *  dump, so that the file holds the last dump of the stream.
+ *
+ *******************************************************************************/
+static void dump_write_raw(const tuner_decoder_raw_t * raw, dump_options_t * options)
+{
+    uint8_t header[TUNER_TELEMETRY_RAW_FILE_HEADER_SIZE];
+    uint32_t fields[3u] = { raw->usPerWrap, raw->numRecords, raw->size };
+    uint32_t i;
+    FILE * out;
+
+    memcpy(header, TUNER_TELEMETRY_RAW_FILE_MAGIC, 4u);
+    for (i = 0u; i < 3u; i++)
+    {
+        header[4u + (4u * i)] = (uint8_t)fields[i];
+        header[5u + (4u * i)] = (uint8_t)(fields[i] >> 8u);
+        header[6u + (4u * i)] = (uint8_t)(fields[i] >> 16u);
+        header[7u + (4u * i)] = (uint8_t)(fields[i] >> 24u);
+    }
+
+    if (NULL == (out = fopen(options->rawPath, "wb")))
+    {
+        perror(options->rawPath);
+        return;
+    }
+    if ((1u != fwrite(header, sizeof(header), 1u, out)) ||
+        ((0u != raw->size) && (1u != fwrite(raw->records, raw->size, 1u, out))))
+    {
+        perror(options->rawPath);
+    }
+    fclose(out);
+    options->rawWritten++;
+}
+
+/*******************************************************************************
+ * Function Name: dump_frame
+ ********************************************************************************
+ * Summary:
+ *  Prints raw count, baseline and difference of every sensor. The sensor
+ *  context of the CAPSENSE middleware starts with these three 16-bit fields.
+ *  Writes each complete raw count dump.
+ *
+ *******************************************************************************/
+static void dump_frame(const tuner_decoder_t * decoder, uint8_t frameType, void * user)
+{
+    dump_options_t * options = (dump_options_t *)user;
+    uint32_t sns;
+
+    if (TUNER_TELEMETRY_RAW_FRAME == frameType)
+    {
+        if (decoder->raw.complete && !decoder->raw.damaged && (NULL != options->rawPath))
+        {
+            dump_write_raw(&decoder->raw, options);
+        }
+        return;
+    }
+    if ((TUNER_TELEMETRY_TRACE_FRAME == frameType) || !options->verbose)
+    {
+        return;
+    }
+    printf("%c %3u", (char)frameType, decoder->seq);
+    for (sns = 0u; sns < decoder->layout.numSensors; sns++)
+    {
+        const uint8_t * rec = tuner_decoder_sensor(decoder, sns);
+        printf("  %u/%u/%d",
+               (unsigned)(rec[0] | (rec[1] << 8)),
+               (unsigned)(rec[2] | (rec[3] << 8)),
+               (int)(int16_t)(rec[4] | (rec[5] << 8)));
+    }
+    printf("\n");
+}
+
+int main(int argc, char * argv[])
+{
+    tuner_decoder_t decoder;
+    uint8_t buf[DUMP_READ_SIZE];
+    FILE * in = stdin;
+    dump_options_t options = { false, NULL, 0u };
+    const char * path = NULL;
+    size_t n;
+    int i;
+
+    for (i = 1; i < argc; i++)
+    {
+        if (0 == strcmp(argv[i], "-v"))
+        {
+            options.verbose = true;
+        }
+        else if ((0 == strcmp(argv[i], "-r")) && ((i + 1) < argc))
+        {
+            options.rawPath = argv[++i];
+        }
+        else if ((NULL == path) && ('-' != argv[i][0]))
+        {
+            path = argv[i];
+        }
+        else
+        {
+            fprintf(stderr, "usage: %s [-v] [-r trace file] [capture file]\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    if ((NULL != path) && (NULL == (in = fopen(path, "rb"))))
+    {
+        perror(path);
+        return EXIT_FAILURE;
+    }
+
+    tuner_decoder_init(&decoder, dump_frame, &options);
+    while (0u != (n = fread(buf, 1u, sizeof(buf), in)))
+    {
+        tuner_decoder_feed(&decoder, buf, n);
+    }
+
+    {
+        const tuner_decoder_stats_t * st = &decoder.stats;
+        uint64_t frames = st->keyframes + st->deltas;
+
+        printf("bytes        %llu\n", (unsigned long long)st->bytes);
+        printf("frames       %llu (%llu keyframes, %llu deltas)\n", (unsigned long long)frames,
+               (unsigned long long)st->keyframes, (unsigned long long)st->deltas);
+        printf("lost         %llu (%llu deltas dropped)\n", (unsigned long long)st->lost,
+               (unsigned long long)st->dropped);
+        printf("errors       %llu\n", (unsigned long long)st->errors);
+        if (0u != st->traces)
+        {
+            printf("trace frames %llu\n", (unsigned long long)st->traces);
+        }
+        if (0u != st->raws)
+        {
+            printf("raw dumps    %llu complete (%llu frames), %u written\n", (unsigned long long)st->rawDumps,
+                   (unsigned long long)st->raws, options.rawWritten);
+        }
+        if ((0u != frames) && (0u != decoder.layout.imageSize))
+        {
+            double full = (double)(decoder.layout.imageSize + DUMP_FULL_FRAME_OVERHEAD);
+            /* Raw count dumps are not part of the sensor data stream */
+            double mean = (double)(st->bytes - st->rawBytes - (st->raws * DUMP_FULL_FRAME_OVERHEAD)) /
+                          (double)frames;
+            printf("layout       %u widgets, %u sensors, %u bytes\n", decoder.layout.numWidgets,
+                   decoder.layout.numSensors, decoder.layout.imageSize);
+            printf("frame size   %.1f bytes (full frame %.0f bytes, %.1f%%)\n", mean, full,
+                   (100.0 * mean) / full);
+        }
+    }
+
+    if (0u != decoder.stats.traces)
+    {
+        dump_trace(&decoder);
+    }
+
+    tuner_decoder_free(&decoder);
+    if (stdin != in)
+    {
+        fclose(in);
+    }
+    return EXIT_SUCCESS;
+}
+
+/* [] END OF FILE */
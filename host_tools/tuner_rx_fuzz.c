@@ -0,0 +1,545 @@
+/******************************************************************************
+ * File Name: tuner_rx_fuzz.c
+ *
+ * Description: Fuzz and benchmark harness of the tuner command receiver
+ * (tuner_rx.c). Builds tuner_rx.c for the host against a stub UART ring buffer
+ * and feeds it corrupted command streams: random noise, bit errors, truncated
+ * packets, and packets with a valid header and tail but a wrong CRC. Every
+ * packet found is compared with the previous shift-based receiver, which is
+ * kept here as the reference. Reports the time per received byte and the worst
+ * time of a single receive call with one new byte.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "tuner_rx.h"
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+#define FUZZ_DEFAULT_BYTES               (200000u)
+#define FUZZ_MAX_PACKETS                 (65536u)
+#define FUZZ_PACKET_SIZE                 (CY_CAPSENSE_COMMAND_PACKET_SIZE)
+
+/*******************************************************************************
+ * Types
+ *******************************************************************************/
+typedef struct
+{
+    const char * name;
+    void (* generate)(void);
+} fuzz_scenario_t;
+
+typedef struct
+{
+    uint32_t count;
+    uint8_t packets[FUZZ_MAX_PACKETS][FUZZ_PACKET_SIZE];
+} fuzz_result_t;
+
+typedef struct
+{
+    double nsPerByte;
+    double maxNs;
+    double p99Ns;
+    uint64_t crcChecks;
+    uint64_t uartCalls;
+} fuzz_timing_t;
+
+/*******************************************************************************
+ * Global Definitions
+ *******************************************************************************/
+/* Stream under test and the stub UART ring buffer state */
+static uint8_t * fuzz_stream;
+static uint32_t fuzz_len;
+static uint32_t fuzz_cap;
+static uint32_t fuzz_arrived;
+static uint32_t fuzz_read;
+
+static uint32_t fuzz_inserted;
+static uint64_t fuzz_crc_checks;
+static uint64_t fuzz_uart_calls;
+static uint32_t fuzz_rng = 1u;
+
+static fuzz_result_t fuzz_new;
+static fuzz_result_t fuzz_ref;
+
+/*******************************************************************************
+ * Stub UART and CAPSENSE functions used by tuner_rx.c
+ *******************************************************************************/
+uint32_t Cy_SCB_UART_GetNumInRingBuffer(CySCB_Type const * base, cy_stc_scb_uart_context_t const * context)
+{
+    (void)base;
+    (void)context;
+    fuzz_uart_calls++;
+    return fuzz_arrived - fuzz_read;
+}
+
+cy_en_scb_uart_status_t Cy_SCB_UART_Receive(CySCB_Type * base, void * buffer, uint32_t size,
+                                            cy_stc_scb_uart_context_t * context)
+{
+    (void)base;
+    (void)context;
+    fuzz_uart_calls++;
+    if (size > (fuzz_arrived - fuzz_read))
+    {
+        size = fuzz_arrived - fuzz_read;
+    }
+    memcpy(buffer, &fuzz_stream[fuzz_read], size);
+    fuzz_read += size;
+    return CY_SCB_UART_SUCCESS;
+}
+
+static uint16_t fuzz_crc16(const uint8_t * data, uint32_t size)
+{
+    uint16_t crc = 0xFFFFu;
+    uint32_t i;
+
+    while (0u != size--)
+    {
+        crc ^= (uint16_t)((uint16_t)*data++ << 8u);
+        for (i = 0u; i < 8u; i++)
+        {
+            crc = (0u != (crc & 0x8000u)) ? (uint16_t)((crc << 1u) ^ 0x1021u) : (uint16_t)(crc << 1u);
+        }
+    }
+    return crc;
+}
+
+uint32_t Cy_CapSense_CheckTunerCmdIntegrity(const uint8_t * commandPacket)
+{
+    uint16_t crc;
+
+    fuzz_crc_checks++;
+    if ((CY_CAPSENSE_COMMAND_HEAD_0 != commandPacket[CY_CAPSENSE_COMMAND_HEAD_0_IDX]) ||
+        (CY_CAPSENSE_COMMAND_HEAD_1 != commandPacket[CY_CAPSENSE_COMMAND_HEAD_1_IDX]))
+    {
+        return CY_CAPSENSE_WRONG_HEADER;
+    }
+    if ((CY_CAPSENSE_COMMAND_TAIL_0 != commandPacket[CY_CAPSENSE_COMMAND_TAIL_0_IDX]) ||
+        (CY_CAPSENSE_COMMAND_TAIL_1 != commandPacket[CY_CAPSENSE_COMMAND_TAIL_1_IDX]) ||
+        (CY_CAPSENSE_COMMAND_TAIL_2 != commandPacket[CY_CAPSENSE_COMMAND_TAIL_2_IDX]))
+    {
+        return CY_CAPSENSE_WRONG_TAIL;
+    }
+    crc = fuzz_crc16(commandPacket, CY_CAPSENSE_COMMAND_CRC_0_IDX);
+    if ((commandPacket[CY_CAPSENSE_COMMAND_CRC_0_IDX] != (uint8_t)(crc >> 8u)) ||
+        (commandPacket[CY_CAPSENSE_COMMAND_CRC_1_IDX] != (uint8_t)crc))
+    {
+        return CY_CAPSENSE_WRONG_CRC;
+    }
+    return CY_CAPSENSE_COMMAND_OK;
+}
+
+/*******************************************************************************
+ * Function Name: reference_receive
+ ********************************************************************************
+ * Summary:
+ *  The previous tuner_receive() of main.c: fills a packet buffer and, when the
+ *  integrity check fails, drops the first byte by shifting the buffer.
+ *
+ *******************************************************************************/
+static uint8_t * reference_receive(void)
+{
+    static uint32_t dataIndex = 0u;
+    static uint8_t commandPacket[CY_CAPSENSE_COMMAND_PACKET_SIZE] = {0u};
+    uint32_t numBytes;
+    uint32_t i;
+
+    while (0u != Cy_SCB_UART_GetNumInRingBuffer(NULL, NULL))
+    {
+        numBytes = Cy_SCB_UART_GetNumInRingBuffer(NULL, NULL);
+        if ((CY_CAPSENSE_COMMAND_PACKET_SIZE - dataIndex) < numBytes)
+        {
+            numBytes = CY_CAPSENSE_COMMAND_PACKET_SIZE - dataIndex;
+        }
+        Cy_SCB_UART_Receive(NULL, &commandPacket[dataIndex], numBytes, NULL);
+        dataIndex += numBytes;
+        if (CY_CAPSENSE_COMMAND_PACKET_SIZE <= dataIndex)
+        {
+            if (CY_CAPSENSE_COMMAND_OK == Cy_CapSense_CheckTunerCmdIntegrity(&commandPacket[0u]))
+            {
+                dataIndex = 0u;
+                return &commandPacket[0u];
+            }
+            dataIndex--;
+            for (i = 0u; i < (CY_CAPSENSE_COMMAND_PACKET_SIZE - 1u); i++)
+            {
+                commandPacket[i] = commandPacket[i + 1u];
+            }
+        }
+    }
+    return NULL;
+}
+
+/*******************************************************************************
+ * Stream generators
+ *******************************************************************************/
+static uint32_t fuzz_rand(void)
+{
+    /* xorshift32 */
+    fuzz_rng ^= fuzz_rng << 13u;
+    fuzz_rng ^= fuzz_rng >> 17u;
+    fuzz_rng ^= fuzz_rng << 5u;
+    return fuzz_rng;
+}
+
+static void fuzz_put(uint8_t byte)
+{
+    fuzz_stream[fuzz_len++] = byte;
+}
+
+static void fuzz_packet(uint8_t * packet, bool validCrc)
+{
+    uint16_t crc;
+    uint32_t i;
+
+    packet[CY_CAPSENSE_COMMAND_HEAD_0_IDX] = CY_CAPSENSE_COMMAND_HEAD_0;
+    packet[CY_CAPSENSE_COMMAND_HEAD_1_IDX] = CY_CAPSENSE_COMMAND_HEAD_1;
+    for (i = CY_CAPSENSE_COMMAND_CODE_0_IDX; i < CY_CAPSENSE_COMMAND_CRC_0_IDX; i++)
+    {
+        packet[i] = (uint8_t)fuzz_rand();
+    }
+    crc = fuzz_crc16(packet, CY_CAPSENSE_COMMAND_CRC_0_IDX);
+    if (!validCrc)
+    {
+        crc ^= (uint16_t)(1u + (fuzz_rand() % 0xFFFEu));
+    }
+    packet[CY_CAPSENSE_COMMAND_CRC_0_IDX] = (uint8_t)(crc >> 8u);
+    packet[CY_CAPSENSE_COMMAND_CRC_1_IDX] = (uint8_t)crc;
+    packet[CY_CAPSENSE_COMMAND_TAIL_0_IDX] = CY_CAPSENSE_COMMAND_TAIL_0;
+    packet[CY_CAPSENSE_COMMAND_TAIL_1_IDX] = CY_CAPSENSE_COMMAND_TAIL_1;
+    packet[CY_CAPSENSE_COMMAND_TAIL_2_IDX] = CY_CAPSENSE_COMMAND_TAIL_2;
+}
+
+static void fuzz_put_packet(uint32_t length, bool validCrc)
+{
+    uint8_t packet[FUZZ_PACKET_SIZE];
+    uint32_t i;
+
+    if ((fuzz_cap - fuzz_len) < length)
+    {
+        length = fuzz_cap - fuzz_len;
+    }
+    fuzz_packet(packet, validCrc);
+    for (i = 0u; i < length; i++)
+    {
+        fuzz_put(packet[i]);
+    }
+    if (validCrc && (FUZZ_PACKET_SIZE == length))
+    {
+        fuzz_inserted++;
+    }
+}
+
+/* Valid packets back to back */
+static void gen_clean(void)
+{
+    while (fuzz_len < fuzz_cap)
+    {
+        fuzz_put_packet(FUZZ_PACKET_SIZE, true);
+    }
+}
+
+/* Valid packets separated by bursts of random bytes */
+static void gen_noise(void)
+{
+    while (fuzz_len < fuzz_cap)
+    {
+        uint32_t n = fuzz_rand() % 64u;
+        while ((0u != n--) && (fuzz_len < fuzz_cap))
+        {
+            fuzz_put((uint8_t)fuzz_rand());
+        }
+        fuzz_put_packet(FUZZ_PACKET_SIZE, true);
+    }
+}
+
+/* Valid packets with random bit errors, one byte in 64 on average */
+static void gen_bitflip(void)
+{
+    uint32_t i;
+
+    gen_clean();
+    for (i = 0u; i < fuzz_len; i++)
+    {
+        if (0u == (fuzz_rand() % 64u))
+        {
+            fuzz_stream[i] ^= (uint8_t)(1u << (fuzz_rand() % 8u));
+        }
+    }
+    /* Not known which packets survived; compared with the reference only */
+    fuzz_inserted = 0u;
+}
+
+/* Packets cut at random lengths, each followed by a valid packet */
+static void gen_truncated(void)
+{
+    while (fuzz_len < fuzz_cap)
+    {
+        fuzz_put_packet(1u + (fuzz_rand() % (FUZZ_PACKET_SIZE - 1u)), true);
+        fuzz_put_packet(FUZZ_PACKET_SIZE, true);
+    }
+}
+
+/* Worst case of the framer: packets with valid header and tail but a wrong
+ * CRC, so that the CRC is computed as often as possible
+ */
+static void gen_bad_crc(void)
+{
+    while (fuzz_len < fuzz_cap)
+    {
+        fuzz_put_packet(FUZZ_PACKET_SIZE, (0u == (fuzz_rand() % 16u)));
+    }
+}
+
+/* Line noise made of header and tail bytes only */
+static void gen_header_storm(void)
+{
+    static const uint8_t symbols[] = {0x0Du, 0x0Au, 0x00u, 0xFFu};
+
+    while (fuzz_len < fuzz_cap)
+    {
+        if (0u == (fuzz_rand() % 32u))
+        {
+            fuzz_put_packet(FUZZ_PACKET_SIZE, true);
+        }
+        else
+        {
+            fuzz_put(symbols[fuzz_rand() % sizeof(symbols)]);
+        }
+    }
+}
+
+static const fuzz_scenario_t fuzz_scenarios[] =
+{
+    {"clean", gen_clean},
+    {"noise", gen_noise},
+    {"bitflip", gen_bitflip},
+    {"truncated", gen_truncated},
+    {"bad-crc", gen_bad_crc},
+    {"header-storm", gen_header_storm},
+};
+
+/*******************************************************************************
+ * Harness
+ *******************************************************************************/
+static double fuzz_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((double)ts.tv_sec * 1e9) + (double)ts.tv_nsec;
+}
+
+static int fuzz_cmp_double(const void * a, const void * b)
+{
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+    return (x < y) ? -1 : ((x > y) ? 1 : 0);
+}
+
+/*******************************************************************************
+ * Function Name: fuzz_run
+ ********************************************************************************
+ * Summary:
+ *  Feeds the stream to a receiver in random chunks, as bytes arrive between
+ *  two main loop passes, and collects the packets found.
+ *
+ *******************************************************************************/
+static void fuzz_run(uint8_t * (* receive)(void), fuzz_result_t * result)
+{
+    uint8_t * packet;
+
+    fuzz_arrived = 0u;
+    fuzz_read = 0u;
+    result->count = 0u;
+    while (fuzz_arrived < fuzz_len)
+    {
+        fuzz_arrived += 1u + (fuzz_rand() % 24u);
+        if (fuzz_arrived > fuzz_len)
+        {
+            fuzz_arrived = fuzz_len;
+        }
+        while (NULL != (packet = receive()))
+        {
+            if (result->count < FUZZ_MAX_PACKETS)
+            {
+                memcpy(result->packets[result->count], packet, FUZZ_PACKET_SIZE);
+            }
+            result->count++;
+        }
+    }
+}
+
+/*******************************************************************************
+ * Function Name: fuzz_time
+ ********************************************************************************
+ * Summary:
+ *  The first pass delivers the stream in the same bursts for both receivers
+ *  and measures the mean time per byte. The second pass delivers one byte at
+ *  a time and times every receive call on its own.
+ *
+ *******************************************************************************/
+static void fuzz_time(uint8_t * (* receive)(void), uint32_t seed, fuzz_timing_t * timing, double * samples)
+{
+    double start;
+    uint32_t i;
+
+    fuzz_rng = seed;
+    fuzz_arrived = 0u;
+    fuzz_read = 0u;
+    fuzz_crc_checks = 0u;
+    fuzz_uart_calls = 0u;
+    start = fuzz_now_ns();
+    while (fuzz_arrived < fuzz_len)
+    {
+        fuzz_arrived += 1u + (fuzz_rand() % 24u);
+        if (fuzz_arrived > fuzz_len)
+        {
+            fuzz_arrived = fuzz_len;
+        }
+        while (NULL != receive())
+        {
+        }
+    }
+    timing->nsPerByte = (fuzz_now_ns() - start) / (double)fuzz_len;
+    timing->crcChecks = fuzz_crc_checks;
+    timing->uartCalls = fuzz_uart_calls;
+
+    fuzz_arrived = 0u;
+    fuzz_read = 0u;
+    for (i = 0u; i < fuzz_len; i++)
+    {
+        fuzz_arrived++;
+        start = fuzz_now_ns();
+        while (NULL != receive())
+        {
+        }
+        samples[i] = fuzz_now_ns() - start;
+    }
+    qsort(samples, fuzz_len, sizeof(double), fuzz_cmp_double);
+    timing->p99Ns = samples[(fuzz_len * 99u) / 100u];
+    timing->maxNs = samples[fuzz_len - 1u];
+}
+
+int main(int argc, char * argv[])
+{
+    uint32_t bytes = FUZZ_DEFAULT_BYTES;
+    uint32_t seed = 1u;
+    double * samples;
+    int failures = 0;
+    uint32_t s;
+    int i;
+
+    for (i = 1; i < argc; i++)
+    {
+        if ((0 == strcmp(argv[i], "-s")) && ((i + 1) < argc))
+        {
+            seed = (uint32_t)strtoul(argv[++i], NULL, 0);
+        }
+        else if ((0 == strcmp(argv[i], "-n")) && ((i + 1) < argc))
+        {
+            bytes = (uint32_t)strtoul(argv[++i], NULL, 0);
+        }
+        else
+        {
+            fprintf(stderr, "usage: %s [-s seed] [-n bytes per scenario]\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    fuzz_cap = (0u != bytes) ? bytes : 1u;
+    fuzz_stream = (uint8_t *)malloc(fuzz_cap);
+    samples = (double *)malloc(fuzz_cap * sizeof(double));
+    if ((NULL == fuzz_stream) || (NULL == samples))
+    {
+        return EXIT_FAILURE;
+    }
+
+    printf("%-13s %8s %8s %8s | %7s %6s %7s %7s %7s | %7s %6s %7s %7s %7s\n", "scenario", "packets", "inserted",
+           "ref", "ns/B", "p99", "max", "chk/B", "uart/B", "ref ns/B", "p99", "max", "chk/B", "uart/B");
+
+    for (s = 0u; s < (sizeof(fuzz_scenarios) / sizeof(fuzz_scenarios[0u])); s++)
+    {
+        fuzz_timing_t newTiming;
+        fuzz_timing_t refTiming;
+        bool match;
+
+        fuzz_rng = seed + s;
+        fuzz_len = 0u;
+        fuzz_inserted = 0u;
+        fuzz_scenarios[s].generate();
+
+        tuner_rx_init(NULL, NULL);
+        fuzz_run(tuner_rx_poll, &fuzz_new);
+        fuzz_run(reference_receive, &fuzz_ref);
+
+        match = (fuzz_new.count == fuzz_ref.count);
+        for (i = 0; match && ((uint32_t)i < fuzz_new.count) && ((uint32_t)i < FUZZ_MAX_PACKETS); i++)
+        {
+            match = (0 == memcmp(fuzz_new.packets[i], fuzz_ref.packets[i], FUZZ_PACKET_SIZE));
+        }
+        if (!match || ((0u != fuzz_inserted) && (fuzz_new.count < fuzz_inserted)))
+        {
+            failures++;
+        }
+
+        tuner_rx_init(NULL, NULL);
+        fuzz_time(tuner_rx_poll, seed, &newTiming, samples);
+        fuzz_time(reference_receive, seed, &refTiming, samples);
+
+        printf("%-13s %8u %8u %8u | %7.1f %6.0f %7.0f %7.3f %7.3f | %7.1f %6.0f %7.0f %7.3f %7.3f%s\n",
+               fuzz_scenarios[s].name, fuzz_new.count, fuzz_inserted, fuzz_ref.count,
+               newTiming.nsPerByte, newTiming.p99Ns, newTiming.maxNs,
+               (double)newTiming.crcChecks / (double)fuzz_len,
+               (double)newTiming.uartCalls / (double)fuzz_len,
+               refTiming.nsPerByte, refTiming.p99Ns, refTiming.maxNs,
+               (double)refTiming.crcChecks / (double)fuzz_len,
+               (double)refTiming.uartCalls / (double)fuzz_len,
+               match ? "" : "  MISMATCH");
+    }
+
+    free(samples);
+    free(fuzz_stream);
+    return (0 == failures) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/* [] END OF FILE */
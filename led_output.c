@@ -0,0 +1,216 @@
+/******************************************************************************
+ * File Name: led_output.c
+ *
+ * Description: Mapping of CAPSENSE widgets to LED outputs. The mapping table
+ * is indexed by widget ID and filled at compile time for the widgets of the
+ * CAPSENSE configuration. led_output_set() only updates the bitmask of the
+ * port; led_output_apply() writes the data register of each changed port
+ * once, so the output cost does not grow with the number of widgets.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "led_output.h"
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+#define LED_OUTPUT_NO_PORT               (0xFFu)
+
+/*******************************************************************************
+ * Global Definitions
+ *******************************************************************************/
+/* LED of each widget. The LEDs are active low. */
+static const led_output_pin_t led_output_map[CY_CAPSENSE_WIDGET_COUNT] =
+{
+#ifdef CY_CAPSENSE_BUTTON0_WDGT_ID
+    [CY_CAPSENSE_BUTTON0_WDGT_ID] = {P0_5_PORT, P0_5_PIN},
+#endif
+#ifdef CY_CAPSENSE_BUTTON1_WDGT_ID
+    [CY_CAPSENSE_BUTTON1_WDGT_ID] = {P0_4_PORT, P0_4_PIN},
+#endif
+};
+
+/* Port slot of each widget, LED_OUTPUT_NO_PORT if the widget has no LED */
+static uint8_t led_output_slot[CY_CAPSENSE_WIDGET_COUNT];
+
+/* Ports with LEDs, the pins of all their LEDs and of the LEDs that are on */
+static GPIO_PRT_Type * led_output_ports[LED_OUTPUT_MAX_PORTS];
+static uint32_t led_output_port_mask[LED_OUTPUT_MAX_PORTS];
+static uint32_t led_output_port_on[LED_OUTPUT_MAX_PORTS];
+static uint32_t led_output_num_ports = 0u;
+
+/* Ports whose LEDs changed since the last led_output_apply() */
+static uint32_t led_output_dirty = 0u;
+
+/*******************************************************************************
+ * Function Name: led_output_init
+ ********************************************************************************
+ * Summary:
+ *  Groups the LEDs of the mapping table by port. All LEDs are turned off by
+ *  the next led_output_apply().
+ *
+ * Return:
+ *  void
+ *
+ * Parameters:
+ *  void
+ *******************************************************************************/
+void led_output_init(void)
+{
+    uint32_t widgetId;
+    uint32_t slot;
+
+    led_output_num_ports = 0u;
+    for (widgetId = 0u; widgetId < CY_CAPSENSE_WIDGET_COUNT; widgetId++)
+    {
+        led_output_slot[widgetId] = LED_OUTPUT_NO_PORT;
+        if (NULL == led_output_map[widgetId].port)
+        {
+            continue;
+        }
+        for (slot = 0u; slot < led_output_num_ports; slot++)
+        {
+            if (led_output_ports[slot] == led_output_map[widgetId].port)
+            {
+                break;
+            }
+        }
+        if (slot == led_output_num_ports)
+        {
+            CY_ASSERT(slot < LED_OUTPUT_MAX_PORTS);
+            if (slot >= LED_OUTPUT_MAX_PORTS)
+            {
+                continue;
+            }
+            led_output_ports[slot] = led_output_map[widgetId].port;
+            led_output_port_mask[slot] = 0u;
+            led_output_num_ports++;
+        }
+        led_output_port_mask[slot] |= (1uL << led_output_map[widgetId].pin);
+        led_output_slot[widgetId] = (uint8_t)slot;
+    }
+
+    for (slot = 0u; slot < led_output_num_ports; slot++)
+    {
+        led_output_port_on[slot] = 0u;
+    }
+    led_output_dirty = (1uL << led_output_num_ports) - 1u;
+}
+
+/*******************************************************************************
+ * Function Name: led_output_set
+ ********************************************************************************
+ * Summary:
+ *  Records the state of a widget. The LED is updated by led_output_apply().
+ *
+ * Return:
+ *  void
+ *
+ * Parameters:
+ *  widgetId - widget
+ *  active - widget status
+ *******************************************************************************/
+void led_output_set(uint32_t widgetId, bool active)
+{
+    uint32_t slot;
+    uint32_t on;
+
+    if (widgetId >= CY_CAPSENSE_WIDGET_COUNT)
+    {
+        return;
+    }
+    slot = led_output_slot[widgetId];
+    if (LED_OUTPUT_NO_PORT == slot)
+    {
+        return;
+    }
+
+    on = led_output_port_on[slot];
+    if (active)
+    {
+        on |= (1uL << led_output_map[widgetId].pin);
+    }
+    else
+    {
+        on &= ~(1uL << led_output_map[widgetId].pin);
+    }
+    if (on != led_output_port_on[slot])
+    {
+        led_output_port_on[slot] = on;
+        led_output_dirty |= (1uL << slot);
+    }
+}
+
+/*******************************************************************************
+ * Function Name: led_output_apply
+ ********************************************************************************
+ * Summary:
+ *  Writes the LED states of each changed port with one write of its data
+ *  register. The other pins of the port keep their output value.
+ *
+ * Return:
+ *  void
+ *
+ * Parameters:
+ *  void
+ *******************************************************************************/
+void led_output_apply(void)
+{
+    uint32_t interruptState;
+    uint32_t slot;
+    uint32_t mask;
+
+    for (slot = 0u; 0u != led_output_dirty; slot++)
+    {
+        if (0u != (led_output_dirty & (1uL << slot)))
+        {
+            mask = led_output_port_mask[slot];
+
+            /* Active low: the pins of the LEDs that are on are driven low */
+            interruptState = Cy_SysLib_EnterCriticalSection();
+            GPIO_PRT_DR(led_output_ports[slot]) = (GPIO_PRT_DR(led_output_ports[slot]) & ~mask) |
+                                                  (mask & ~led_output_port_on[slot]);
+            Cy_SysLib_ExitCriticalSection(interruptState);
+
+            led_output_dirty &= ~(1uL << slot);
+        }
+    }
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,302 @@
+/******************************************************************************
+ * File Name: low_power.c
+ *
+ * Description: Two-tier scan mode. Counts the WDT interrupts without an
+ * active widget, switches the WDT to the low-power interval when the timeout
+ * expires, and measures the time from the start of a wake group scan to the
+ * touch detection that returns the device to the full pipeline. The scans
+ * themselves are started by main.c.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "wdt_timer.h"
+#include "stage_trace.h"
+#include "low_power.h"
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+#define LOW_POWER_WDT_MASK               (0xFFFFu)
+
+/*******************************************************************************
+ * Global Definitions
+ *******************************************************************************/
+/* Read by start_next_scan() in the end-of-scan interrupt */
+static volatile bool low_power_on = false;
+
+static scan_group_t low_power_group;
+static uint32_t low_power_full_interval_us = 0u;
+static uint32_t low_power_idle_ticks = 0u;
+static uint32_t low_power_timeout_ticks = 0u;
+static uint32_t low_power_scan_start = 0u;
+static low_power_stats_t low_power_stats;
+
+/*******************************************************************************
+ * Function Name: low_power_init
+ ********************************************************************************
+ * Summary:
+ *  Builds the wake group from PIPELINE_WAKE_FIRST_WIDGET and
+ *  PIPELINE_WAKE_NUM_WIDGETS. The device starts in the full pipeline.
+ *
+ * Return:
+ *  void
+ *
+ * Parameters:
+ *  context - CAPSENSE context
+ *  fullIntervalUs - WDT interrupt interval of the full pipeline
+ *******************************************************************************/
+void low_power_init(const cy_stc_capsense_context_t * context, uint32_t fullIntervalUs)
+{
+    const cy_stc_capsense_widget_config_t * ptrWdCfg = context->ptrWdConfig;
+    uint32_t firstWd = PIPELINE_WAKE_FIRST_WIDGET;
+    uint32_t numWd = PIPELINE_WAKE_NUM_WIDGETS;
+    uint32_t wdId;
+
+    if (0u == numWd)
+    {
+        firstWd = 0u;
+        numWd = context->ptrCommonConfig->numWd;
+    }
+    CY_ASSERT((firstWd + numWd) <= context->ptrCommonConfig->numWd);
+
+    low_power_group.firstWidgetId = (uint8_t)firstWd;
+    low_power_group.numWidgets = (uint8_t)numWd;
+    low_power_group.firstSlotId = ptrWdCfg[firstWd].firstSlotId;
+    low_power_group.numSlots = 0u;
+    for (wdId = firstWd; wdId < (firstWd + numWd); wdId++)
+    {
+        /* One Cy_CapSense_ScanSlots() call needs contiguous slots */
+        CY_ASSERT(ptrWdCfg[wdId].firstSlotId == (low_power_group.firstSlotId + low_power_group.numSlots));
+        low_power_group.numSlots += ptrWdCfg[wdId].numSlots;
+    }
+
+    low_power_full_interval_us = fullIntervalUs;
+    low_power_timeout_ticks = (PIPELINE_LOW_POWER_TIMEOUT_MS * 1000u) / fullIntervalUs;
+    low_power_idle_ticks = 0u;
+    low_power_on = false;
+}
+
+/*******************************************************************************
+ * Function Name: low_power_is_on
+ ********************************************************************************
+ * Summary:
+ *  Checks whether the device is in low-power mode, where the pipeline does not
+ *  chain scans. Can be called from interrupts.
+ *
+ * Return:
+ *  bool
+ *
+ * Parameters:
+ *  void
+ *******************************************************************************/
+bool low_power_is_on(void)
+{
+    return low_power_on;
+}
+
+/*******************************************************************************
+ * Function Name: low_power_wake_group
+ ********************************************************************************
+ * Summary:
+ *  Returns the batch of the wake group widgets, scanned in low-power mode.
+ *
+ * Return:
+ *  const scan_group_t * - wake group batch
+ *
+ * Parameters:
+ *  void
+ *******************************************************************************/
+const scan_group_t * low_power_wake_group(void)
+{
+    return &low_power_group;
+}
+
+/*******************************************************************************
+ * Function Name: low_power_activity
+ ********************************************************************************
+ * Summary:
+ *  Restarts the inactivity timeout. Called for each processed active widget.
+ *
+ * Return:
+ *  void
+ *
+ * Parameters:
+ *  void
+ *******************************************************************************/
+void low_power_activity(void)
+{
+    low_power_idle_ticks = 0u;
+}
+
+/*******************************************************************************
+ * Function Name: low_power_wdt_tick
+ ********************************************************************************
+ * Summary:
+ *  Counts a WDT interrupt of the full pipeline without activity.
+ *
+ * Return:
+ *  bool - true when the inactivity timeout has expired
+ *
+ * Parameters:
+ *  void
+ *******************************************************************************/
+bool low_power_wdt_tick(void)
+{
+#if (0u != PIPELINE_LOW_POWER)
+    if (low_power_idle_ticks < low_power_timeout_ticks)
+    {
+        low_power_idle_ticks++;
+    }
+    return (low_power_idle_ticks >= low_power_timeout_ticks);
+#else
+    return false;
+#endif
+}
+
+/*******************************************************************************
+ * Function Name: low_power_enter
+ ********************************************************************************
+ * Summary:
+ *  Stops the scan chaining of the pipeline and switches the WDT to the
+ *  low-power interval. The batches in flight finish normally.
+ *
+ * Return:
+ *  void
+ *
+ * Parameters:
+ *  void
+ *******************************************************************************/
+void low_power_enter(void)
+{
+    low_power_on = true;
+    low_power_stats.entries++;
+    wdt_timer_set_interval(PIPELINE_LOW_POWER_INTERVAL_MS * 1000u);
+}
+
+/*******************************************************************************
+ * Function Name: low_power_wake_scan_started
+ ********************************************************************************
+ * Summary:
+ *  Records the start of a wake group scan, from which the wake-up latency is
+ *  measured. Call with interrupts disabled, just before the scan is started.
+ *
+ * Return:
+ *  void
+ *
+ * Parameters:
+ *  void
+ *******************************************************************************/
+void low_power_wake_scan_started(void)
+{
+    low_power_scan_start = Cy_WDT_GetCount();
+    low_power_stats.wakeScans++;
+}
+
+/*******************************************************************************
+ * Function Name: low_power_exit
+ ********************************************************************************
+ * Summary:
+ *  Returns to the full pipeline after a touch on the wake group, restores the
+ *  WDT interval and records the time since the start of the wake scan. The
+ *  caller restarts the scan chaining.
+ *
+ * Return:
+ *  void
+ *
+ * Parameters:
+ *  void
+ *******************************************************************************/
+void low_power_exit(void)
+{
+    uint32_t ticks = (Cy_WDT_GetCount() - low_power_scan_start) & LOW_POWER_WDT_MASK;
+    uint32_t wakeUs;
+
+    wdt_timer_set_interval(low_power_full_interval_us);
+    low_power_idle_ticks = 0u;
+    low_power_on = false;
+
+    wakeUs = wdt_timer_ticks_to_us(ticks);
+    low_power_stats.wakeups++;
+    low_power_stats.lastWakeUs = wakeUs;
+    if (wakeUs > low_power_stats.maxWakeUs)
+    {
+        low_power_stats.maxWakeUs = wakeUs;
+    }
+#if (0u != STAGE_TRACE_ENABLE)
+    stage_trace_record(STAGE_TRACE_WAKE, 0u, wakeUs * (stage_trace_clock_hz() / 1000000u));
+#endif /* STAGE_TRACE_ENABLE */
+}
+
+/*******************************************************************************
+ * Function Name: low_power_latency_budget_us
+ ********************************************************************************
+ * Summary:
+ *  Returns the worst first-touch latency measured so far in low-power mode: a
+ *  touch just after the start of a wake scan is seen by the next one, one
+ *  low-power interval later.
+ *
+ * Return:
+ *  uint32_t - latency in microseconds
+ *
+ * Parameters:
+ *  void
+ *******************************************************************************/
+uint32_t low_power_latency_budget_us(void)
+{
+    return (PIPELINE_LOW_POWER_INTERVAL_MS * 1000u) + low_power_stats.maxWakeUs;
+}
+
+/*******************************************************************************
+ * Function Name: low_power_get_stats
+ ********************************************************************************
+ * Summary:
+ *  Returns the counters and wake-up latencies of the low-power mode.
+ *
+ * Return:
+ *  const low_power_stats_t * - statistics
+ *
+ * Parameters:
+ *  void
+ *******************************************************************************/
+const low_power_stats_t * low_power_get_stats(void)
+{
+    return &low_power_stats;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,118 @@
+/******************************************************************************
+ * File Name: low_power.h
+ *
+ * Description: Two-tier scan mode. Without touch activity for
+ * PIPELINE_LOW_POWER_TIMEOUT_MS, the pipeline stops and only the wake group is
+ * scanned, once per WDT interrupt at PIPELINE_LOW_POWER_INTERVAL_MS. A touch
+ * on the wake group returns the device to the full pipeline at once.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+
+#ifndef LOW_POWER_H
+#define LOW_POWER_H
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "cy_pdl.h"
+#include "cycfg_capsense.h"
+#include "scan_schedule.h"
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+/* 1 = drop to the wake group scan after the inactivity timeout,
+ * 0 = always run the full pipeline
+ */
+#ifndef PIPELINE_LOW_POWER
+#define PIPELINE_LOW_POWER               (1u)
+#endif
+
+/* Time without an active widget before the wake group scan starts */
+#ifndef PIPELINE_LOW_POWER_TIMEOUT_MS
+#define PIPELINE_LOW_POWER_TIMEOUT_MS    (5000u)
+#endif
+
+/* WDT interrupt interval, and so the wake group scan period, in low-power
+ * mode. Max limit is 1698 ms.
+ */
+#ifndef PIPELINE_LOW_POWER_INTERVAL_MS
+#define PIPELINE_LOW_POWER_INTERVAL_MS   (100u)
+#endif
+
+/* Widgets of the wake group. Their slots must be contiguous so that the group
+ * is scanned by one Cy_CapSense_ScanSlots() call. 0 widgets selects all
+ * widgets; a ganged proximity widget covering all electrodes is the cheapest
+ * wake group.
+ */
+#ifndef PIPELINE_WAKE_FIRST_WIDGET
+#define PIPELINE_WAKE_FIRST_WIDGET       (0u)
+#endif
+
+#ifndef PIPELINE_WAKE_NUM_WIDGETS
+#define PIPELINE_WAKE_NUM_WIDGETS        (0u)
+#endif
+
+/*******************************************************************************
+ * Data types
+ *******************************************************************************/
+typedef struct
+{
+    uint32_t entries;                /* switches to low-power mode */
+    uint32_t wakeScans;              /* wake group scans */
+    uint32_t wakeups;                /* returns to the full pipeline on a touch */
+    uint32_t lastWakeUs;             /* start of the wake scan to the touch detection */
+    uint32_t maxWakeUs;
+} low_power_stats_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+void low_power_init(const cy_stc_capsense_context_t * context, uint32_t fullIntervalUs);
+bool low_power_is_on(void);
+const scan_group_t * low_power_wake_group(void);
+void low_power_activity(void);
+bool low_power_wdt_tick(void);
+void low_power_enter(void);
+void low_power_wake_scan_started(void);
+void low_power_exit(void);
+uint32_t low_power_latency_budget_us(void);
+const low_power_stats_t * low_power_get_stats(void);
+
+#endif /* LOW_POWER_H */
+
+/* [] END OF FILE */
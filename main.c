@@ -46,11 +46,31 @@
 #include "cybsp.h"
 #include "cycfg.h"
 #include "cycfg_capsense.h"
+#include "scan_schedule.h"
+#include "scan_queue.h"
+#include "wdt_timer.h"
+#include "tuner_tx.h"
+#include "tuner_telemetry.h"
+#include "tuner_rx.h"
+#include "tuner_snapshot.h"
+#include "host_regmap.h"
+#include "touch_event.h"
+#include "stage_trace.h"
+#include "raw_trace.h"
+#include "bench.h"
+#include "led_output.h"
+#include "low_power.h"
+#include "sleep_policy.h"
+#include "self_test.h"
+#include "warm_start.h"
+#include "multi_freq.h"
+#include "frame_governor.h"
 
 /*******************************************************************************
  * Macros
  *******************************************************************************/
 #define CAPSENSE_MSC0_INTR_PRIORITY      (3u)
+#define CAPSENSE_MSC1_INTR_PRIORITY      (3u)
 #define CY_ASSERT_FAILED                 (0u)
 
 /* CapSense tuner interface settings */
@@ -58,7 +78,10 @@
 #define TUNER_I2C                        (2u) // Enabling CapSense Tuner with I2C
 #define TUNER_PROTOCOL                   TUNER_UART // Selecting Tuner interface
 
-#define NUMBER_OF_BUTTONS                (2u)
+/* Every MSC channel scans its slots concurrently and interrupts on its own */
+#if (CY_CAPSENSE_TOTAL_CH_NUMBER > 2u)
+#error "Only designs with up to two MSC channels are supported"
+#endif
 
 /* ILO Frequency in Hz */
 #define ILO_FREQUENCY_HZ                 (40000U)
@@ -69,12 +92,21 @@
 /* WDT interrupt priority */
 #define WDT_INTERRUPT_PRIORITY           (3u)
 
-/* Define desired delay in microseconds */
+/* Define desired delay in microseconds. The frame governor starts a frame
+ * on every WDT interrupt.
+ */
+#if (0u != FRAME_GOVERNOR_ENABLE)
+#define DESIRED_WDT_INTERVAL             (FRAME_GOVERNOR_PERIOD_US)
+#else
 #define DESIRED_WDT_INTERVAL             (WDT_INTERRUPT_INTERVAL_MS  * 1000U)
+#endif
 
-/* LED STATE TOGGLE MACROS */
-#define LED_STATE_ON    (0u)
-#define LED_STATE_OFF   (1u)
+/* Without the example event consumer, the LEDs follow the widget status */
+#if (0u != TOUCH_EVENT_EXAMPLE_CONSUMER)
+#define LED_OUTPUT_STATUS(widgetId, active)
+#else
+#define LED_OUTPUT_STATUS(widgetId, active) led_output_set((widgetId), (active))
+#endif
 
 /*******************************************************************************
  * Global Definitions
@@ -95,10 +127,6 @@
     #define UART_RINGBUFFER_SIZE (CY_CAPSENSE_COMMAND_PACKET_SIZE * 2u + 1u)
 #endif /*TUNER PROTOCOL SELECTION*/
 
-/* Variables to hold LED Port and Pins for Buttons */
-GPIO_PRT_Type * LED_PORT_BUTT[NUMBER_OF_BUTTONS] = {P0_5_PORT, P0_4_PORT};
-uint8_t LED_PIN_BUTT[NUMBER_OF_BUTTONS] = {P0_5_PIN, P0_4_PIN};
-
 /* WDT interrupt service routine configuration */
 const cy_stc_sysint_t wdt_isr_cfg =
 {
@@ -109,9 +137,8 @@ const cy_stc_sysint_t wdt_isr_cfg =
 /* Variable to check whether WDT interrupt is triggered */
 volatile bool interrupt_flag = false;
 
-/* Variable to store the counts required after ILO compensation */
-static uint32_t ilo_compensated_counts = 0U;
-static uint32_t ilo_cycles  = 0U;
+/* Batch being scanned by the MSC block, NULL when the scan is stopped */
+static const scan_group_t * volatile scanningGroup = NULL;
 
 /*******************************************************************************
  * Function Prototypes
@@ -124,11 +151,19 @@ void wdt_trigger(void);
 
 static void initialize_capsense(void);
 static void capsense_msc0_isr(void);
+#if (CY_CAPSENSE_TOTAL_CH_NUMBER > 1u)
+static void capsense_msc1_isr(void);
+#endif
+static void capsense_eos_callback(cy_stc_active_scan_sns_t * ptrActiveScan);
+static void start_next_scan(void);
+static void start_wake_scan(void);
+static bool process_wake_group(void);
+#if (0u != TOUCH_EVENT_EXAMPLE_CONSUMER)
+static void process_touch_events(void);
+#endif
 static void initialize_capsense_tuner(void);
 static void tuner_isr(void);
 
-static void led_control(uint8_t WidgetID);
-
 #if(TUNER_PROTOCOL == TUNER_UART)
 
 void tuner_send(void * context);
@@ -179,6 +214,14 @@ int main(void)
     /* Unmask the WDT interrupt */
     Cy_WDT_UnmaskInterrupt();
 
+    /* Compensate the ILO and program the first WDT match */
+    wdt_timer_init(DESIRED_WDT_INTERVAL);
+
+#if (0u != STAGE_TRACE_ENABLE)
+    /* Start the cycle counter of the stage measurements */
+    stage_trace_init();
+#endif /* STAGE_TRACE_ENABLE */
+
     /* Enable WDT */
     Cy_WDT_Unlock();
     Cy_WDT_Enable();
@@ -190,26 +233,76 @@ int main(void)
     /* Initialize CAPSENSE */
     initialize_capsense();
 
+    /* Publish the first frame to the tuner interface */
+    tuner_snapshot_init();
+
     /* Delay to allow the device to receive the command from the Tuner Tool.
     *  The delay time depends on the CAPSENSE&trade; configuration
-    *  and the device initialization time.
+    *  and the device initialization time. A warm start goes straight to
+    *  scanning; the Tuner Tool connects through the main loop.
     */
-    Cy_SysLib_Delay(100u);
+    if (!WARM_START_RESTORED())
+    {
+        Cy_SysLib_Delay(100u);
+    }
 
     /* Process first received command, if available */
     (void)Cy_CapSense_RunTuner(&cy_capsense_context);
 
-    uint8_t currentWidgetID, previousWidgetID;
+    const scan_group_t * finishedGroup;
+    uint8_t widgetID;
+    bool groupActive;
+    bool frameProcessed;
+    bool widgetActive;
+    uint32_t interruptState;
+    uint32_t traceStart;
+
+    /* Split the widgets into batches scanned by one Cy_CapSense_ScanSlots() call */
+    scan_schedule_init(&cy_capsense_context);
+    scan_queue_init();
+
+    /* Group the widget LEDs by port */
+    led_output_init();
+
+    /* Build the wake group scanned in low-power mode */
+    low_power_init(&cy_capsense_context, DESIRED_WDT_INTERVAL);
+
+    /* Learn the scan durations that select the sleep mode */
+    sleep_policy_init(&cy_capsense_context);
+
+    /* Queue the touch events of the processed widgets for the application */
+    touch_event_init();
+
+#if (0u != RAW_TRACE_ENABLE)
+    /* Record the raw counts of the processed widgets */
+    raw_trace_init();
+#endif /* RAW_TRACE_ENABLE */
 
-    currentWidgetID = 0u;
-    previousWidgetID = 0u;
-    uint8_t numWgt = cy_capsense_context.ptrCommonConfig->numWd;
+#if (0u != BENCH_ENABLE)
+    /* Measure the frame rate, CPU and MSC time of the scan strategy */
+    bench_init();
+#endif /* BENCH_ENABLE */
+
+#if (0u != SELF_TEST_ENABLE)
+    /* Run the self-test checks between the scans */
+    self_test_init(&cy_capsense_context);
+#endif /* SELF_TEST_ENABLE */
+
+#if (0u != MULTI_FREQ_ENABLE)
+    /* Hop the sense clock frequency of the widgets from scan to scan */
+    multi_freq_init(&cy_capsense_context);
+#endif /* MULTI_FREQ_ENABLE */
+
+#if (0u != FRAME_GOVERNOR_ENABLE)
+    /* Run the frames at a fixed rate and start the first one */
+    frame_governor_init();
+#endif /* FRAME_GOVERNOR_ENABLE */
 
 #if(TUNER_PROTOCOL == TUNER_I2C)
     cy_stc_syspm_callback_params_t ezi2cCallbackParams =
     {
         .base       = CYBSP_EZI2C_HW,
-        .context    = &ezi2c_context
+        .context    = &i2c_context
     };
 
     cy_stc_syspm_callback_t ezi2cCallback =
@@ -271,35 +364,136 @@ int main(void)
     /* Register Deep Sleep callback */
     Cy_SysPm_RegisterCallback(&sysClkCallback);
 
-    /* Start the first scan of Previous Widget */
-    Cy_CapSense_ScanSlots(cy_capsense_context.ptrWdConfig[previousWidgetID].firstSlotId,
-        cy_capsense_context.ptrWdConfig[previousWidgetID].numSlots, &cy_capsense_context);
+    /* Start the first scan. The following scans are started by the end-of-scan
+     * callback, which queues each scanned batch for processing.
+     */
+    start_next_scan();
 
     for (;;)
     {
-        wdt_trigger();
-
-        if(CY_CAPSENSE_NOT_BUSY == Cy_CapSense_IsBusy(&cy_capsense_context))
+        /* Process the batches whose scan has completed */
+        frameProcessed = false;
+        touch_event_pass_start();
+        BENCH_PASS();
+        while (NULL != (finishedGroup = scan_queue_pop()))
         {
-            /* Increase the currentWidgetID by 1 i.e, point to the next Widget */
-            currentWidgetID = (currentWidgetID < (numWgt - 1u))?(currentWidgetID + 1u):0;
+            SELF_TEST_PROCESSED(finishedGroup->numWidgets);
+            if (low_power_wake_group() == finishedGroup)
+            {
+                /* A touch on the wake group restarts the full pipeline */
+                if (process_wake_group())
+                {
+                    low_power_exit();
+                    FRAME_GOVERNOR_RESTART();
+                }
+                BENCH_BATCH_PROCESSED();
+                continue;
+            }
 
-            Cy_CapSense_ScanSlots(cy_capsense_context.ptrWdConfig[currentWidgetID].firstSlotId,
-                cy_capsense_context.ptrWdConfig[currentWidgetID].numSlots, &cy_capsense_context);
+            groupActive = false;
+            SCAN_SCHEDULE_PROCESS_BEGIN();
+            for (widgetID = finishedGroup->firstWidgetId;
+                 widgetID < (finishedGroup->firstWidgetId + finishedGroup->numWidgets); widgetID++)
+            {
+                MULTI_FREQ_VOTE(widgetID);
+                RAW_TRACE_RECORD(widgetID, &cy_capsense_context);
+                traceStart = STAGE_TRACE_BEGIN();
+                Cy_CapSense_ProcessWidget(widgetID, &cy_capsense_context);
+                STAGE_TRACE_END(STAGE_TRACE_PROCESS, widgetID, traceStart);
+                BENCH_PROCESSED();
+
+                widgetActive = (0u != Cy_CapSense_IsWidgetActive(widgetID, &cy_capsense_context));
+                RAW_TRACE_STATUS(widgetID, widgetActive);
+                LED_OUTPUT_STATUS(widgetID, widgetActive);
+                touch_event_update(widgetID, widgetActive);
+                if(widgetActive)
+                {
+                    groupActive = true;
+                    low_power_activity();
+                }
 
-            /* Process the Previous Widget */
-            Cy_CapSense_ProcessWidget(previousWidgetID,&cy_capsense_context);
+                /* Time the processing to balance the batches */
+                SCAN_SCHEDULE_PROCESSED(widgetID);
+            }
 
-            /* Turning ON/OFF based on widget status */
-            led_control(previousWidgetID);
+            /* Active batches are rescanned at full rate. The batch can be
+             * scanned again from now on.
+             */
+            scan_schedule_update(finishedGroup, groupActive);
+            FRAME_GOVERNOR_PROCESSED(finishedGroup->numWidgets);
+            BENCH_BATCH_PROCESSED();
+            frameProcessed = true;
+        }
 
-            /* Set the previous widget as current widget */
-            previousWidgetID = currentWidgetID;
+        /* Turning ON/OFF the LEDs from the touch events of the processed
+         * widgets, one write per port
+         */
+        traceStart = STAGE_TRACE_BEGIN();
+#if (0u != TOUCH_EVENT_EXAMPLE_CONSUMER)
+        process_touch_events();
+#endif
+        led_output_apply();
+        STAGE_TRACE_END(STAGE_TRACE_LED, 0u, traceStart);
+
+        /* Run the self-test steps of this frame. The steps that need the MSC
+         * block run while the end-of-scan callback has left it idle.
+         */
+        SELF_TEST_RUN(NULL == scanningGroup);
 
-            /* Establishes synchronized communication with the CAPSENSE Tuner tool */
-            Cy_CapSense_RunTuner(&cy_capsense_context);
+        /* Save the calibration and the baselines for the next warm start */
+        WARM_START_SERVICE();
 
+        /* Rebalance the batches from the measured scan and processing times */
+        SCAN_SCHEDULE_BALANCE_SERVICE();
+
+        /* In low-power mode, scan the wake group once per WDT interrupt.
+         * Otherwise drop to low-power mode after the inactivity timeout; the
+         * batches in flight still complete and are processed.
+         */
+        if (interrupt_flag)
+        {
+            if (low_power_is_on())
+            {
+                start_wake_scan();
+            }
+            else if (low_power_wdt_tick())
+            {
+                low_power_enter();
+            }
         }
+
+        /* Restart the scan if it stopped because every batch was waiting for
+         * processing, for a self-test step, to install a balanced batch
+         * table, or after the return from low-power mode
+         */
+        interruptState = Cy_SysLib_EnterCriticalSection();
+        if((NULL == scanningGroup) && !low_power_is_on())
+        {
+            start_next_scan();
+        }
+        Cy_SysLib_ExitCriticalSection(interruptState);
+
+        /* Publish the processed frame, then establish synchronized
+         * communication with the CAPSENSE Tuner tool
+         */
+        traceStart = STAGE_TRACE_BEGIN();
+#if((TUNER_PROTOCOL == TUNER_I2C) && (0u != HOST_REGMAP_ENABLE))
+        if (frameProcessed)
+        {
+            host_regmap_update(&cy_capsense_context);
+        }
+        host_regmap_publish();
+#else
+        /* A pass without processed widgets has nothing new to publish */
+        if (frameProcessed || tuner_snapshot_pending())
+        {
+            tuner_snapshot_publish();
+        }
+#endif
+        Cy_CapSense_RunTuner(&cy_capsense_context);
+        STAGE_TRACE_END(STAGE_TRACE_TUNER, 0u, traceStart);
+
+        wdt_trigger();
     }
 }
 
@@ -307,8 +501,10 @@ int main(void)
  * Function Name: wdt_trigger
  ********************************************************************************
  * Summary:
- *  - Updates the set match value to the WDT block.
- *  - Enters into deep sleep mode.
+ *  - Recompensates the ILO when due, without waiting for the measurement.
+ *  - Enters into deep sleep mode or sleep mode, or returns at once, depending
+ *    on the predicted end of the scan in flight. Sleep mode is used while the
+ *    ILO is measured or a tuner frame is sent.
  *
  * Return:
  *  void
@@ -318,35 +514,74 @@ int main(void)
  *******************************************************************************/
 void wdt_trigger(void)
 {
+    uint32_t interruptState;
+    uint32_t traceStart;
+    uint32_t benchStart;
+    bool hfClkNeeded;
+
+    traceStart = STAGE_TRACE_BEGIN();
+
     if (interrupt_flag)
     {
         /* Clear the interrupt flag */
         interrupt_flag = false;
     }
 
-    /* Start ILO measurement */
-    Cy_SysClk_IloStartMeasurement();
+    /* The WDT match is updated in wdt_isr with the cached ILO compensated
+     * counts. The ILO measurement is only repeated on schedule.
+     */
+    hfClkNeeded = wdt_timer_service();
 
-    /* Get the ILO compensated counts i.e. the actual counts for the
-     desired ILO frequency. ILO default accuracy is +/- 60%.
-     Note that DESIRED_WDT_INTERVAL should be less than the total
-     count time */
-    while (CY_SYSCLK_SUCCESS != Cy_SysClk_IloCompensate(DESIRED_WDT_INTERVAL, &ilo_cycles));
-    ilo_compensated_counts = (uint32_t)ilo_cycles;
+#if(TUNER_PROTOCOL == TUNER_UART)
+    /* The tuner frame is sent by the UART interrupt */
+    hfClkNeeded = hfClkNeeded || tuner_tx_is_busy();
+#endif /* TUNER_UART */
 
-    /* Stop ILO measurement before entering deep sleep mode */
-    Cy_SysClk_IloStopMeasurement();
-    /* Enter deep sleep mode */
-    Cy_SysPm_CpuEnterDeepSleep();
-}
+    /* Sleep unless a scanned batch waits for processing. An end-of-scan
+     * interrupt between the check and WFI stays pending and wakes the CPU at
+     * once. The ILO measurement and the UART transmit need the high-frequency
+     * clock, which is off in deep sleep mode. A scan that ends too soon to pay
+     * for the entry into deep sleep mode, or sleep mode, is waited for awake.
+     */
+    interruptState = Cy_SysLib_EnterCriticalSection();
+    STAGE_TRACE_END(STAGE_TRACE_WDT, 0u, traceStart);
+    if(scan_queue_is_empty())
+    {
+        switch(sleep_policy_select(hfClkNeeded))
+        {
+            case SLEEP_POLICY_SLEEP:
+                benchStart = BENCH_SLEEP_BEGIN();
+                traceStart = STAGE_TRACE_BEGIN();
+                Cy_SysPm_CpuEnterSleep();
+                STAGE_TRACE_END(STAGE_TRACE_SLEEP, 0u, traceStart);
+                BENCH_SLEEP_END(false, benchStart);
+                break;
 
+            case SLEEP_POLICY_DEEPSLEEP:
+                benchStart = BENCH_SLEEP_BEGIN();
+                traceStart = STAGE_TRACE_DEEPSLEEP_BEGIN();
+                Cy_SysPm_CpuEnterDeepSleep();
+                STAGE_TRACE_DEEPSLEEP_END(traceStart);
+                BENCH_SLEEP_END(true, benchStart);
+                break;
+
+            default:
+                /* The scan ends within a few microseconds */
+                break;
+        }
+    }
+    Cy_SysLib_ExitCriticalSection(interruptState);
+}
 
 /*******************************************************************************
  * Function Name: initialize_capsense
  ********************************************************************************
  * Summary:
- *  This function initializes the CAPSENSE and configures the CAPSENSE
- *  interrupt.
+ *  This function initializes the CAPSENSE and configures the interrupt of
+ *  every MSC channel. The channels scan their slots concurrently; the end of
+ *  scan callback runs once all of them have completed. A warm start restores
+ *  the saved calibration in place of the calibration of
+ *  Cy_CapSense_Enable().
  *
  * Return:
  *  void
@@ -357,12 +592,28 @@ void wdt_trigger(void)
 static void initialize_capsense(void)
 {
     cy_capsense_status_t status = CY_CAPSENSE_STATUS_SUCCESS;
+    uint32_t ch;
 
-    /* CAPSENSE interrupt configuration MSC 0 */
-    const cy_stc_sysint_t capsense_msc0_interrupt_config =
+    /* CAPSENSE interrupt configuration, one entry per MSC channel */
+    const cy_stc_sysint_t capsense_msc_interrupt_config[CY_CAPSENSE_TOTAL_CH_NUMBER] =
     {
-        .intrSrc = CY_MSC0_IRQ,
-        .intrPriority = CAPSENSE_MSC0_INTR_PRIORITY,
+        {
+            .intrSrc = CY_MSC0_IRQ,
+            .intrPriority = CAPSENSE_MSC0_INTR_PRIORITY,
+        },
+#if (CY_CAPSENSE_TOTAL_CH_NUMBER > 1u)
+        {
+            .intrSrc = CY_MSC1_IRQ,
+            .intrPriority = CAPSENSE_MSC1_INTR_PRIORITY,
+        },
+#endif
+    };
+    const cy_israddress capsense_msc_isr[CY_CAPSENSE_TOTAL_CH_NUMBER] =
+    {
+        capsense_msc0_isr,
+#if (CY_CAPSENSE_TOTAL_CH_NUMBER > 1u)
+        capsense_msc1_isr,
+#endif
     };
 
     /* Capture the CSD HW block and initialize it to the default state */
@@ -370,13 +621,28 @@ static void initialize_capsense(void)
 
     if (CY_CAPSENSE_STATUS_SUCCESS == status)
     {
-        /* Initialize CAPSENSE interrupt for MSC 0 */
-        Cy_SysInt_Init(&capsense_msc0_interrupt_config, capsense_msc0_isr);
-        NVIC_ClearPendingIRQ(capsense_msc0_interrupt_config.intrSrc);
-        NVIC_EnableIRQ(capsense_msc0_interrupt_config.intrSrc);
+        /* Initialize the CAPSENSE interrupt of each MSC channel */
+        for (ch = 0u; ch < CY_CAPSENSE_TOTAL_CH_NUMBER; ch++)
+        {
+            Cy_SysInt_Init(&capsense_msc_interrupt_config[ch], capsense_msc_isr[ch]);
+            NVIC_ClearPendingIRQ(capsense_msc_interrupt_config[ch].intrSrc);
+            NVIC_EnableIRQ(capsense_msc_interrupt_config[ch].intrSrc);
+        }
 
-        /* Initialize the CAPSENSE firmware modules */
-        status = Cy_CapSense_Enable(&cy_capsense_context);
+        /* Restore the saved calibration, or calibrate and initialize the
+         * CAPSENSE firmware modules
+         */
+        if (!WARM_START_RESTORE(&cy_capsense_context))
+        {
+            status = Cy_CapSense_Enable(&cy_capsense_context);
+        }
+    }
+
+    if (CY_CAPSENSE_STATUS_SUCCESS == status)
+    {
+        /* Start the next scan and queue the scanned batch from the interrupt */
+        status = Cy_CapSense_RegisterCallback(CY_CAPSENSE_END_OF_SCAN_E, capsense_eos_callback,
+                                              &cy_capsense_context);
     }
 
 #if(TUNER_PROTOCOL == TUNER_UART)
@@ -411,8 +677,19 @@ void wdt_isr(void)
 {
     /* Clears the WDT match flag */
     Cy_WDT_ClearInterrupt();
+    /* Set the match for the next interrupt */
+    wdt_timer_next_match();
     /* Set the interrupt flag */
     interrupt_flag = true;
+
+    /* Start the frame of the frame governor on the tick, unless a self-test
+     * step waits for the MSC block; the main loop then starts it after the
+     * step
+     */
+    if (FRAME_GOVERNOR_TICK(!low_power_is_on()) && (NULL == scanningGroup) && !SELF_TEST_MSC_REQUESTED())
+    {
+        start_next_scan();
+    }
 }
 
 /*******************************************************************************
@@ -427,6 +704,238 @@ static void capsense_msc0_isr(void)
     Cy_CapSense_InterruptHandler(msc_0_msc_0_HW, &cy_capsense_context);
 }
 
+#if (CY_CAPSENSE_TOTAL_CH_NUMBER > 1u)
+/*******************************************************************************
+ * Function Name: capsense_msc1_isr
+ ********************************************************************************
+ * Summary:
+ *  Wrapper function for handling interrupts from CAPSENSE MSC1 block.
+ *
+ *******************************************************************************/
+static void capsense_msc1_isr(void)
+{
+    Cy_CapSense_InterruptHandler(msc_1_msc_0_HW, &cy_capsense_context);
+}
+#endif
+
+/*******************************************************************************
+ * Function Name: capsense_eos_callback
+ ********************************************************************************
+ * Summary:
+ *  End-of-scan callback, called from the CAPSENSE interrupt once all slots of
+ *  the batch are scanned. Queues the batch for processing by the main loop and
+ *  starts the scan of the next batch right away, so the MSC block does not
+ *  wait for the CPU, unless a self-test step waits for the block.
+ *
+ * Parameters:
+ *  ptrActiveScan - last scanned sensor (unused)
+ *
+ *******************************************************************************/
+static void capsense_eos_callback(cy_stc_active_scan_sns_t * ptrActiveScan)
+{
+    (void)ptrActiveScan;
+
+    /* Convert the remaining frequency channels of the batch first */
+    if (MULTI_FREQ_RESCAN(scanningGroup))
+    {
+        Cy_CapSense_ScanSlots(scanningGroup->firstSlotId, scanningGroup->numSlots, &cy_capsense_context);
+        return;
+    }
+
+    /* Time the scan to predict the next scans of its widgets */
+    sleep_policy_scan_done();
+    BENCH_SCAN_DONE();
+
+    /* Cannot fail: a batch is never queued twice */
+    (void)scan_queue_push(scanningGroup);
+
+    /* Leave the MSC block idle for a self-test step; the main loop restarts
+     * the scan after the step
+     */
+    if (SELF_TEST_MSC_REQUESTED())
+    {
+        scanningGroup = NULL;
+    }
+    else
+    {
+        start_next_scan();
+    }
+}
+
+/*******************************************************************************
+ * Function Name: start_next_scan
+ ********************************************************************************
+ * Summary:
+ *  Starts the scan of the next batch of the schedule. The scan stops when all
+ *  batches are waiting for processing, or in low-power mode; the main loop
+ *  then restarts it. With the frame governor, it also stops at the end of the
+ *  frame until the WDT interrupt starts the next one. Called from the
+ *  end-of-scan callback, the WDT interrupt, which has the same priority, or
+ *  with interrupts disabled.
+ *
+ * Return:
+ *  void
+ *
+ * Parameters:
+ *  void
+ *******************************************************************************/
+static void start_next_scan(void)
+{
+    const scan_group_t * group = NULL;
+    uint32_t traceStart;
+
+    /* The pipeline does not chain scans in low-power mode, nor past the end
+     * of the frame of the frame governor
+     */
+    if(!low_power_is_on() && FRAME_GOVERNOR_SCAN_ALLOWED())
+    {
+        group = scan_schedule_next();
+    }
+
+    scanningGroup = group;
+    if(NULL != group)
+    {
+        FRAME_GOVERNOR_SCANNED(group->numWidgets);
+        MULTI_FREQ_SCAN_STARTED(group);
+        sleep_policy_scan_started(group);
+        BENCH_SCAN_STARTED();
+        traceStart = STAGE_TRACE_BEGIN();
+        Cy_CapSense_ScanSlots(group->firstSlotId, group->numSlots, &cy_capsense_context);
+        STAGE_TRACE_END(STAGE_TRACE_SCAN, group->firstWidgetId, traceStart);
+    }
+}
+
+
+/*******************************************************************************
+ * Function Name: start_wake_scan
+ ********************************************************************************
+ * Summary:
+ *  Starts the scan of the wake group in low-power mode, unless the previous
+ *  scan has not completed yet. The end-of-scan callback queues the group like
+ *  a batch of the pipeline and chains no further scan.
+ *
+ * Return:
+ *  void
+ *
+ * Parameters:
+ *  void
+ *******************************************************************************/
+static void start_wake_scan(void)
+{
+    const scan_group_t * group = low_power_wake_group();
+    uint32_t interruptState;
+
+    interruptState = Cy_SysLib_EnterCriticalSection();
+    if((NULL == scanningGroup) && scan_queue_is_empty())
+    {
+        scanningGroup = group;
+        low_power_wake_scan_started();
+        MULTI_FREQ_SCAN_STARTED(group);
+        sleep_policy_scan_started(group);
+        BENCH_SCAN_STARTED();
+        Cy_CapSense_ScanSlots(group->firstSlotId, group->numSlots, &cy_capsense_context);
+    }
+    Cy_SysLib_ExitCriticalSection(interruptState);
+}
+
+/*******************************************************************************
+ * Function Name: process_wake_group
+ ********************************************************************************
+ * Summary:
+ *  Processes the widgets of the wake group and queues their touch events.
+ *  A touch is reported as soon as one sensor crosses the finger threshold,
+ *  without the ON debounce: at the low-power scan rate, the debounce would
+ *  add several scan periods to the wake-up. The full pipeline then debounces
+ *  at full rate.
+ *
+ * Return:
+ *  bool - true if any sensor of the group is above its finger threshold
+ *
+ * Parameters:
+ *  void
+ *******************************************************************************/
+static bool process_wake_group(void)
+{
+    const scan_group_t * group = low_power_wake_group();
+    const cy_stc_capsense_widget_config_t * ptrWdCfg;
+    bool touched = false;
+    bool widgetActive;
+    uint32_t widgetID;
+    uint32_t snsID;
+
+    for (widgetID = group->firstWidgetId; widgetID < (uint32_t)(group->firstWidgetId + group->numWidgets);
+         widgetID++)
+    {
+        MULTI_FREQ_VOTE(widgetID);
+        RAW_TRACE_RECORD(widgetID, &cy_capsense_context);
+        Cy_CapSense_ProcessWidget(widgetID, &cy_capsense_context);
+        BENCH_PROCESSED();
+        widgetActive = (0u != Cy_CapSense_IsWidgetActive(widgetID, &cy_capsense_context));
+        RAW_TRACE_STATUS(widgetID, widgetActive);
+        LED_OUTPUT_STATUS(widgetID, widgetActive);
+        touch_event_update(widgetID, widgetActive);
+
+        ptrWdCfg = &cy_capsense_context.ptrWdConfig[widgetID];
+        for (snsID = 0u; snsID < ptrWdCfg->numSns; snsID++)
+        {
+            if (ptrWdCfg->ptrSnsContext[snsID].diff >= ptrWdCfg->ptrWdContext->fingerTh)
+            {
+                touched = true;
+            }
+        }
+    }
+    return touched;
+}
+
+#if (0u != TOUCH_EVENT_EXAMPLE_CONSUMER)
+/*******************************************************************************
+ * Function Name: process_touch_events
+ ********************************************************************************
+ * Summary:
+ *  Example consumer of the touch events, to be replaced by the one of the
+ *  application. Drains the touch event queue and sets the LED of each widget
+ *  from its press and release events. If events were dropped because the
+ *  queue was full, a release may be missing, so every LED is set from the
+ *  widget status instead.
+ *
+ * Return:
+ *  void
+ *
+ * Parameters:
+ *  void
+ *******************************************************************************/
+static void process_touch_events(void)
+{
+    static uint32_t overflows = 0u;
+    touch_event_t event;
+    uint32_t widgetID;
+
+    while (touch_event_pop(&event))
+    {
+        if (TOUCH_EVENT_PRESS == event.type)
+        {
+            led_output_set(event.widgetId, true);
+        }
+        else if (TOUCH_EVENT_RELEASE == event.type)
+        {
+            led_output_set(event.widgetId, false);
+        }
+        else
+        {
+            /* Hold events do not change the LED */
+        }
+    }
+
+    if (overflows != touch_event_overflows())
+    {
+        overflows = touch_event_overflows();
+        for (widgetID = 0u; widgetID < CY_CAPSENSE_WIDGET_COUNT; widgetID++)
+        {
+            led_output_set(widgetID, (0u != Cy_CapSense_IsWidgetActive(widgetID, &cy_capsense_context)));
+        }
+    }
+}
+#endif
 
 /*******************************************************************************
  * Function Name: initialize_capsense_tuner
@@ -464,14 +973,19 @@ static void initialize_capsense_tuner(void)
     Cy_SysInt_Init(&i2c_intr_config, tuner_isr);
     NVIC_EnableIRQ(i2c_intr_config.intrSrc);
 
-    /* Set the CapSense data structure as the I2C buffer to be exposed to the
-     * master on primary slave address interface. Any I2C host tools such as
-     * the Tuner or the Bridge Control Panel can read this buffer but you can
-     * connect only one tool at a time.
+#if(0u != HOST_REGMAP_ENABLE)
+    /* Expose the compact register map to a host controller instead of the
+     * CapSense data structure. The CAPSENSE Tuner cannot connect.
+     */
+    host_regmap_attach_ezi2c(CYBSP_EZI2C_HW, &i2c_context, CYBSP_EZI2C_IRQ);
+#else
+    /* Set the published copy of the CapSense data structure as the I2C
+     * buffer to be exposed to the master on primary slave address interface.
+     * Any I2C host tools such as the Tuner or the Bridge Control Panel can
+     * read this buffer but you can connect only one tool at a time.
      */
-    Cy_SCB_EZI2C_SetBuffer1(CYBSP_EZI2C_HW, (uint8_t *)&cy_capsense_tuner,
-                            sizeof(cy_capsense_tuner), sizeof(cy_capsense_tuner),
-                            &i2c_context);
+    tuner_snapshot_attach_ezi2c(CYBSP_EZI2C_HW, &i2c_context, CYBSP_EZI2C_IRQ);
+#endif /* HOST_REGMAP_ENABLE */
 
     Cy_SCB_EZI2C_Enable(CYBSP_EZI2C_HW);
 
@@ -500,35 +1014,18 @@ static void initialize_capsense_tuner(void)
 
     Cy_SCB_UART_StartRingBuffer(scb_1_HW, uartRingBuffer, UART_RINGBUFFER_SIZE, &CYBSP_UART_context);
 
+    /* Tuner commands are framed from the ring buffer, tuner frames are sent
+     * from the UART interrupt
+     */
+    tuner_rx_init(scb_1_HW, &CYBSP_UART_context);
+    tuner_tx_init(scb_1_HW, &CYBSP_UART_context);
+    tuner_telemetry_init();
+
     Cy_SCB_UART_Enable(scb_1_HW);
 #endif /*TUNER PROTOCOL SELECTION*/
 }
 
 
-/*******************************************************************************
- * Function Name: led_control
- ********************************************************************************
- * Summary:
- *  Turning LEDs ON/OFF based on the status of CAPSENSE Widgets and their respective Sensors
- *
- * Return:
- *  void
- *
- * Parameters:
- *  WidgetID
- *******************************************************************************/
-static void led_control(uint8_t WidgetID)
-{
-    if(0 != Cy_CapSense_IsWidgetActive(WidgetID, &cy_capsense_context))
-    {
-         Cy_GPIO_Write(LED_PORT_BUTT[WidgetID], LED_PIN_BUTT[WidgetID], LED_STATE_ON);
-    }
-    else
-    {
-         Cy_GPIO_Write(LED_PORT_BUTT[WidgetID], LED_PIN_BUTT[WidgetID], LED_STATE_OFF);
-    }
-}
-
 /*******************************************************************************
  * Function Name: tuner_isr
  ********************************************************************************
@@ -545,6 +1042,9 @@ static void tuner_isr(void)
 {
 #if(TUNER_PROTOCOL == TUNER_I2C)
     Cy_SCB_EZI2C_Interrupt(CYBSP_I2C_HW, &i2c_context);
+
+    /* Pass completed host writes to the live tuner data */
+    tuner_snapshot_ezi2c_event();
 #else
     Cy_SCB_UART_Interrupt(scb_1_HW, &CYBSP_UART_context);
 #endif /*TUNER PROTOCOL SELECTION*/
@@ -560,16 +1060,14 @@ static void tuner_isr(void)
 *******************************************************************************/
 void tuner_send(void * context)
 {
-    uint8_t uartTxHeader[] = {0x0Du, 0x0Au};
-    uint8_t uartTxTail[] = {0x00u, 0xFFu, 0xFFu};
     (void)context;
-    Cy_SCB_UART_PutArrayBlocking(scb_1_HW, &(uartTxHeader[0u]), sizeof(uartTxHeader));
-    Cy_SCB_UART_PutArrayBlocking(scb_1_HW, (uint8_t *)&cy_capsense_tuner, sizeof(cy_capsense_tuner));
-    Cy_SCB_UART_PutArrayBlocking(scb_1_HW, &(uartTxTail[0u]), sizeof(uartTxTail));
-    /* Blocking wait for transfer completion */
-    while (!Cy_SCB_UART_IsTxComplete(scb_1_HW))
-    {
-    }
+#if (0u != TUNER_TELEMETRY_DELTA)
+    /* Send the changed widget and sensor records only */
+    tuner_telemetry_send();
+#else
+    /* Copy the published frame; the SCB interrupt sends it in the background */
+    tuner_tx_send(tuner_snapshot_frame(), sizeof(cy_capsense_tuner));
+#endif /* TUNER_TELEMETRY_DELTA */
 }
 
 /*******************************************************************************
@@ -581,42 +1079,16 @@ void tuner_send(void * context)
 *******************************************************************************/
 void tuner_receive(uint8_t ** packet, uint8_t ** tunerPacket, void * context)
 {
-    uint32_t i;
+    uint8_t * commandPacket;
     (void)context;
-    static uint32_t dataIndex = 0u;
-    static uint8_t commandPacket[CY_CAPSENSE_COMMAND_PACKET_SIZE] = {0u};
-    uint32_t numBytes;
-    while(0u != Cy_SCB_UART_GetNumInRingBuffer(scb_1_HW, &CYBSP_UART_context))
-    {
-        numBytes = Cy_SCB_UART_GetNumInRingBuffer(scb_1_HW, &CYBSP_UART_context);
-        /* Calculate number of bytes to read from ring buffer */
-        if ((CY_CAPSENSE_COMMAND_PACKET_SIZE - dataIndex) < numBytes)
-        {
-            numBytes = CY_CAPSENSE_COMMAND_PACKET_SIZE - dataIndex;
-        }
-        /* Add received data to the end of commandPacket */
-        Cy_SCB_UART_Receive(scb_1_HW, &commandPacket[dataIndex], numBytes, &CYBSP_UART_context);
-        dataIndex += numBytes;
-        if(CY_CAPSENSE_COMMAND_PACKET_SIZE <= dataIndex)
-        {
-            if (CY_CAPSENSE_COMMAND_OK == Cy_CapSense_CheckTunerCmdIntegrity(&commandPacket[0u]))
-            {
-                /* Found a correct command, reset data index and assign pointers to buffers */
-                dataIndex = 0u;
-                *tunerPacket = (uint8_t *)&cy_capsense_tuner;
-                *packet = &commandPacket[0u];
-                break;
-            }
-            else
-            {
-                /* Command is not correct, remove the first byte in commandPacket buffer */
-                dataIndex--;
-                for (i = 0u; i < (CY_CAPSENSE_COMMAND_PACKET_SIZE - 1u); i++)
-                {
-                    commandPacket[i] = commandPacket[i + 1u];
-                }
-            }
-        }
+
+    /* Frame the received bytes without shifting the packet buffer */
+    commandPacket = tuner_rx_poll();
+    if (NULL != commandPacket)
+    {
+        /* Found a correct command, assign pointers to buffers */
+        *tunerPacket = (uint8_t *)&cy_capsense_tuner;
+        *packet = commandPacket;
     }
 }
 #endif /* TUNER_UART */
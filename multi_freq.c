@@ -0,0 +1,395 @@
+/******************************************************************************
+ * File Name: multi_freq.c
+ *
+ * Description: Frequency hopping of the scan pipeline. Sets the sense clock
+ * divider of the widgets of a batch before its scan, keeps a reference level
+ * and the latest deviation of each frequency channel per sensor, and writes
+ * the median deviation over the baseline into the raw count processed by
+ * Cy_CapSense_ProcessWidget().
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include <string.h>
+#include "cy_pdl.h"
+#include "cycfg_capsense.h"
+#include "multi_freq.h"
+
+#if (0u != MULTI_FREQ_ENABLE)
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+#define MULTI_FREQ_ALL_CHANNELS          ((1u << MULTI_FREQ_CHANNELS) - 1u)
+
+/*******************************************************************************
+ * Global Definitions
+ *******************************************************************************/
+static cy_stc_capsense_context_t * multi_freq_context = NULL;
+static multi_freq_stats_t multi_freq_stats;
+
+/* Divider of each widget without the channel offset, the divider last
+ * written to the widget context, and the channel of the last scan
+ */
+static uint16_t multi_freq_base[CY_CAPSENSE_WIDGET_COUNT];
+static uint16_t multi_freq_applied[CY_CAPSENSE_WIDGET_COUNT];
+static volatile uint8_t multi_freq_channel[CY_CAPSENSE_WIDGET_COUNT];
+
+/* Channels with a reference level, and the index of the first sensor of
+ * each widget
+ */
+static uint8_t multi_freq_valid[CY_CAPSENSE_WIDGET_COUNT];
+static uint16_t multi_freq_first_sns[CY_CAPSENSE_WIDGET_COUNT];
+
+/* Reference level and latest deviation of each channel, per sensor in
+ * widget order
+ */
+static uint16_t multi_freq_ref[CY_CAPSENSE_SENSOR_COUNT][MULTI_FREQ_CHANNELS];
+static int16_t multi_freq_dev[CY_CAPSENSE_SENSOR_COUNT][MULTI_FREQ_CHANNELS];
+
+#if (0u == MULTI_FREQ_PIPELINED)
+/* Raw counts of F0 and F1, saved before the next channel overwrites them */
+static uint16_t multi_freq_raw[CY_CAPSENSE_SENSOR_COUNT][MULTI_FREQ_CHANNELS - 1u];
+#endif /* MULTI_FREQ_PIPELINED */
+
+/*******************************************************************************
+ * Function Name: multi_freq_init
+ ********************************************************************************
+ * Summary:
+ *  Takes the sense clock dividers of the calibrated widgets as their F0
+ *  divider. The first scans of successive widgets start on successive
+ *  channels.
+ *
+ * Return:
+ *  void
+ *
+ * Parameters:
+ *  context - CAPSENSE context, after Cy_CapSense_Enable()
+ *******************************************************************************/
+void multi_freq_init(cy_stc_capsense_context_t * context)
+{
+    uint32_t wdId;
+    uint32_t snsIndex = 0u;
+
+    multi_freq_context = context;
+    memset(&multi_freq_stats, 0, sizeof(multi_freq_stats));
+    for (wdId = 0u; wdId < CY_CAPSENSE_WIDGET_COUNT; wdId++)
+    {
+        multi_freq_base[wdId] = context->ptrWdConfig[wdId].ptrWdContext->snsClk;
+        multi_freq_applied[wdId] = multi_freq_base[wdId];
+        multi_freq_channel[wdId] = (uint8_t)((wdId + MULTI_FREQ_CHANNELS - 1u) % MULTI_FREQ_CHANNELS);
+        multi_freq_valid[wdId] = 0u;
+        multi_freq_first_sns[wdId] = (uint16_t)snsIndex;
+        snsIndex += context->ptrWdConfig[wdId].numSns;
+    }
+}
+
+/*******************************************************************************
+ * Function Name: multi_freq_apply
+ ********************************************************************************
+ * Summary:
+ *  Sets the divider of a channel in the widget context. A divider written
+ *  by the tuner or the application since the last scan becomes the new F0
+ *  divider and restarts the reference levels.
+ *
+ *******************************************************************************/
+static void multi_freq_apply(uint32_t wdId, uint32_t ch)
+{
+    const cy_stc_capsense_widget_config_t * ptrWdCfg = &multi_freq_context->ptrWdConfig[wdId];
+    uint32_t offset = 0u;
+
+    if (ptrWdCfg->ptrWdContext->snsClk != multi_freq_applied[wdId])
+    {
+        multi_freq_base[wdId] = ptrWdCfg->ptrWdContext->snsClk;
+        multi_freq_valid[wdId] = 0u;
+    }
+
+    if (0u != ch)
+    {
+        if (CY_CAPSENSE_CSX_GROUP == ptrWdCfg->senseMethod)
+        {
+            offset = (1u == ch) ? MULTI_FREQ_CSX_OFFSET_F1 : MULTI_FREQ_CSX_OFFSET_F2;
+        }
+        else
+        {
+            offset = (1u == ch) ? MULTI_FREQ_CSD_OFFSET_F1 : MULTI_FREQ_CSD_OFFSET_F2;
+        }
+    }
+
+    multi_freq_applied[wdId] = (uint16_t)(multi_freq_base[wdId] + offset);
+    ptrWdCfg->ptrWdContext->snsClk = multi_freq_applied[wdId];
+    multi_freq_channel[wdId] = (uint8_t)ch;
+    multi_freq_stats.scans[ch]++;
+}
+
+/*******************************************************************************
+ * Function Name: multi_freq_scan_started
+ ********************************************************************************
+ * Summary:
+ *  Selects the channel of each widget of a batch before its scan: the
+ *  channel after the one of its last scan, or F0 when the three channels
+ *  are converted back to back. Called from the end-of-scan callback or with
+ *  interrupts disabled.
+ *
+ * Return:
+ *  void
+ *
+ * Parameters:
+ *  group - batch about to be scanned
+ *******************************************************************************/
+void multi_freq_scan_started(const scan_group_t * group)
+{
+    uint32_t wdId;
+    uint32_t ch = 0u;
+
+    for (wdId = group->firstWidgetId; wdId < (uint32_t)(group->firstWidgetId + group->numWidgets); wdId++)
+    {
+#if (0u != MULTI_FREQ_PIPELINED)
+        ch = (multi_freq_channel[wdId] + 1u) % MULTI_FREQ_CHANNELS;
+#endif /* MULTI_FREQ_PIPELINED */
+        multi_freq_apply(wdId, ch);
+    }
+}
+
+/*******************************************************************************
+ * Function Name: multi_freq_rescan
+ ********************************************************************************
+ * Summary:
+ *  Saves the raw counts of the channel just converted and selects the next
+ *  channel, when the channels are converted back to back. Called from the
+ *  end-of-scan callback.
+ *
+ * Return:
+ *  bool - true if the batch is to be scanned again on the next channel,
+ *  false once the last channel is converted
+ *
+ * Parameters:
+ *  group - batch whose scan has completed
+ *******************************************************************************/
+bool multi_freq_rescan(const scan_group_t * group)
+{
+#if (0u == MULTI_FREQ_PIPELINED)
+    const cy_stc_capsense_widget_config_t * ptrWdCfg;
+    uint32_t ch = multi_freq_channel[group->firstWidgetId];
+    uint32_t wdId;
+    uint32_t snsId;
+
+    if (ch >= (MULTI_FREQ_CHANNELS - 1u))
+    {
+        return false;
+    }
+
+    for (wdId = group->firstWidgetId; wdId < (uint32_t)(group->firstWidgetId + group->numWidgets); wdId++)
+    {
+        ptrWdCfg = &multi_freq_context->ptrWdConfig[wdId];
+        for (snsId = 0u; snsId < ptrWdCfg->numSns; snsId++)
+        {
+            multi_freq_raw[multi_freq_first_sns[wdId] + snsId][ch] = ptrWdCfg->ptrSnsContext[snsId].raw;
+        }
+        multi_freq_apply(wdId, ch + 1u);
+    }
+    return true;
+#else
+    (void)group;
+    return false;
+#endif /* MULTI_FREQ_PIPELINED */
+}
+
+/*******************************************************************************
+ * Function Name: multi_freq_median
+ ********************************************************************************
+ * Summary:
+ *  Votes the latest deviations of the channels with a reference level: the
+ *  median of three, or of two the one closer to zero, so that one channel
+ *  alone never reports a touch.
+ *
+ *******************************************************************************/
+static int32_t multi_freq_median(const int16_t * dev, uint32_t channels)
+{
+    int32_t value[MULTI_FREQ_CHANNELS];
+    int32_t tmp;
+    uint32_t num = 0u;
+    uint32_t ch;
+
+    for (ch = 0u; ch < MULTI_FREQ_CHANNELS; ch++)
+    {
+        if (0u != (channels & (1u << ch)))
+        {
+            value[num++] = dev[ch];
+        }
+    }
+
+    if (1u == num)
+    {
+        return value[0u];
+    }
+    if (value[0u] > value[1u])
+    {
+        tmp = value[0u];
+        value[0u] = value[1u];
+        value[1u] = tmp;
+    }
+    if (2u == num)
+    {
+        /* Both above zero: the lower one, both below: the higher one */
+        return (value[0u] > 0) ? value[0u] : ((value[1u] < 0) ? value[1u] : 0);
+    }
+    return (value[2u] < value[0u]) ? value[0u] : ((value[2u] > value[1u]) ? value[1u] : value[2u]);
+}
+
+/*******************************************************************************
+ * Function Name: multi_freq_vote
+ ********************************************************************************
+ * Summary:
+ *  Updates the channels converted since the last vote of a widget and
+ *  replaces the raw count of each sensor with its baseline plus the voted
+ *  deviation. The reference level of a channel follows its raw count within
+ *  the noise thresholds of the widget, like the baseline.
+ *
+ * Return:
+ *  void
+ *
+ * Parameters:
+ *  widgetId - widget about to be processed
+ *******************************************************************************/
+void multi_freq_vote(uint32_t widgetId)
+{
+    const cy_stc_capsense_widget_config_t * ptrWdCfg = &multi_freq_context->ptrWdConfig[widgetId];
+    const cy_stc_capsense_widget_context_t * ptrWdCxt = ptrWdCfg->ptrWdContext;
+    cy_stc_capsense_sensor_context_t * ptrSns;
+    uint32_t snsIndex = multi_freq_first_sns[widgetId];
+    uint32_t snsId;
+    uint32_t ch;
+    uint32_t fresh;
+    uint32_t raw;
+    int32_t dev;
+    int32_t vote;
+
+#if (0u != MULTI_FREQ_PIPELINED)
+    fresh = 1u << multi_freq_channel[widgetId];
+#else
+    fresh = MULTI_FREQ_ALL_CHANNELS;
+#endif /* MULTI_FREQ_PIPELINED */
+
+    for (snsId = 0u; snsId < ptrWdCfg->numSns; snsId++)
+    {
+        ptrSns = &ptrWdCfg->ptrSnsContext[snsId];
+        for (ch = 0u; ch < MULTI_FREQ_CHANNELS; ch++)
+        {
+            if (0u == (fresh & (1u << ch)))
+            {
+                continue;
+            }
+#if (0u == MULTI_FREQ_PIPELINED)
+            raw = (ch < (MULTI_FREQ_CHANNELS - 1u)) ? multi_freq_raw[snsIndex][ch] : ptrSns->raw;
+#else
+            raw = ptrSns->raw;
+#endif /* MULTI_FREQ_PIPELINED */
+
+            if (0u == (multi_freq_valid[widgetId] & (1u << ch)))
+            {
+                multi_freq_ref[snsIndex][ch] = (uint16_t)raw;
+            }
+            dev = (int32_t)raw - (int32_t)multi_freq_ref[snsIndex][ch];
+            if ((dev < (int32_t)ptrWdCxt->noiseTh) && (dev > -(int32_t)ptrWdCxt->nNoiseTh))
+            {
+                multi_freq_ref[snsIndex][ch] = (uint16_t)((int32_t)multi_freq_ref[snsIndex][ch] + (dev / 8));
+            }
+            else if (dev < 0)
+            {
+                multi_freq_ref[snsIndex][ch] = (uint16_t)raw;
+            }
+            multi_freq_dev[snsIndex][ch] = (int16_t)((dev > INT16_MAX) ? INT16_MAX :
+                                                     ((dev < INT16_MIN) ? INT16_MIN : dev));
+        }
+
+        vote = multi_freq_median(multi_freq_dev[snsIndex], multi_freq_valid[widgetId] | fresh);
+        for (ch = 0u; ch < MULTI_FREQ_CHANNELS; ch++)
+        {
+            if ((0u != (fresh & (1u << ch))) && (multi_freq_dev[snsIndex][ch] > (int32_t)ptrWdCxt->fingerTh) &&
+                (vote <= (int32_t)ptrWdCxt->fingerTh))
+            {
+                multi_freq_stats.outvoted++;
+            }
+        }
+
+        vote += (int32_t)ptrSns->bsln;
+        ptrSns->raw = (uint16_t)((vote < 0) ? 0 : ((vote > (int32_t)UINT16_MAX) ? (int32_t)UINT16_MAX : vote));
+        snsIndex++;
+    }
+    multi_freq_valid[widgetId] |= (uint8_t)fresh;
+}
+
+/*******************************************************************************
+ * Function Name: multi_freq_base_sns_clk
+ ********************************************************************************
+ * Summary:
+ *  Returns the divider of a widget without the channel offset.
+ *
+ * Return:
+ *  uint16_t - F0 divider, or snsClk if it was written since the last scan
+ *
+ * Parameters:
+ *  widgetId - widget
+ *  snsClk - divider in the widget context
+ *******************************************************************************/
+uint16_t multi_freq_base_sns_clk(uint32_t widgetId, uint16_t snsClk)
+{
+    return (snsClk == multi_freq_applied[widgetId]) ? multi_freq_base[widgetId] : snsClk;
+}
+
+/*******************************************************************************
+ * Function Name: multi_freq_get_stats
+ ********************************************************************************
+ * Summary:
+ *  Returns the channel statistics.
+ *
+ * Return:
+ *  const multi_freq_stats_t * - statistics since multi_freq_init()
+ *
+ * Parameters:
+ *  void
+ *******************************************************************************/
+const multi_freq_stats_t * multi_freq_get_stats(void)
+{
+    return &multi_freq_stats;
+}
+
+#endif /* MULTI_FREQ_ENABLE */
+
+/* [] END OF FILE */
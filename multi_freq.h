@@ -0,0 +1,143 @@
+/******************************************************************************
+ * File Name: multi_freq.h
+ *
+ * Description: Frequency hopping of the scan pipeline. Each scan of a widget
+ * converts its sensors at the next of three sense clock frequencies, and the
+ * processing votes the latest result of each frequency channel, so narrowband
+ * interference on one frequency is outvoted at the frame rate of a single
+ * frequency. Compiled out unless MULTI_FREQ_ENABLE is set.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+
+#ifndef MULTI_FREQ_H
+#define MULTI_FREQ_H
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include "scan_schedule.h"
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+/* 1 = hop the sense clock frequency between the scans, 0 = one frequency as
+ * configured. Leave MULTI_FREQ_SCAN_EN of the CAPSENSE configuration off.
+ */
+#ifndef MULTI_FREQ_ENABLE
+#define MULTI_FREQ_ENABLE                (0u)
+#endif
+
+/* 1 = each scan of a batch converts the next frequency channel of its
+ * widgets, 0 = each scan of a batch converts the three channels back to back
+ * before the batch is processed, as MULTI_FREQ_SCAN_EN does. The second mode
+ * triples the scan time and serves as the reference for the first.
+ */
+#ifndef MULTI_FREQ_PIPELINED
+#define MULTI_FREQ_PIPELINED             (1u)
+#endif
+
+/* Frequency channels F0, F1 and F2 */
+#define MULTI_FREQ_CHANNELS              (3u)
+
+/* Sense clock divider offsets of the channels F1 and F2 from the divider of
+ * the widget, as CSD_MFS_DIVIDER_OFFSET_F1/F2 and CSX_MFS_DIVIDER_OFFSET_F1/F2
+ * in design.cycapsense
+ */
+#ifndef MULTI_FREQ_CSD_OFFSET_F1
+#define MULTI_FREQ_CSD_OFFSET_F1         (4u)
+#endif
+
+#ifndef MULTI_FREQ_CSD_OFFSET_F2
+#define MULTI_FREQ_CSD_OFFSET_F2         (8u)
+#endif
+
+#ifndef MULTI_FREQ_CSX_OFFSET_F1
+#define MULTI_FREQ_CSX_OFFSET_F1         (2u)
+#endif
+
+#ifndef MULTI_FREQ_CSX_OFFSET_F2
+#define MULTI_FREQ_CSX_OFFSET_F2         (4u)
+#endif
+
+/* Instrumentation of the application. MULTI_FREQ_SCAN_STARTED() selects the
+ * channel of a batch before Cy_CapSense_ScanSlots(). MULTI_FREQ_RESCAN()
+ * returns true from the end-of-scan callback while the batch has channels
+ * left to convert back to back. MULTI_FREQ_VOTE() replaces the raw counts of
+ * a widget with the vote before Cy_CapSense_ProcessWidget().
+ * MULTI_FREQ_BASE_SNS_CLK() returns the divider of the widget without the
+ * channel offset.
+ */
+#if (0u != MULTI_FREQ_ENABLE)
+#define MULTI_FREQ_SCAN_STARTED(group)   multi_freq_scan_started(group)
+#define MULTI_FREQ_VOTE(id)              multi_freq_vote(id)
+#define MULTI_FREQ_BASE_SNS_CLK(id, snsClk) multi_freq_base_sns_clk((id), (snsClk))
+#else
+#define MULTI_FREQ_SCAN_STARTED(group)
+#define MULTI_FREQ_VOTE(id)
+#define MULTI_FREQ_BASE_SNS_CLK(id, snsClk) (snsClk)
+#endif /* MULTI_FREQ_ENABLE */
+
+#if ((0u != MULTI_FREQ_ENABLE) && (0u == MULTI_FREQ_PIPELINED))
+#define MULTI_FREQ_RESCAN(group)         multi_freq_rescan(group)
+#else
+#define MULTI_FREQ_RESCAN(group)         (false)
+#endif
+
+/*******************************************************************************
+ * Types
+ *******************************************************************************/
+typedef struct
+{
+    uint32_t scans[MULTI_FREQ_CHANNELS]; /* widget scans per channel */
+    uint32_t outvoted;               /* channel results above the finger threshold outvoted */
+} multi_freq_stats_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+void multi_freq_init(cy_stc_capsense_context_t * context);
+void multi_freq_scan_started(const scan_group_t * group);
+bool multi_freq_rescan(const scan_group_t * group);
+void multi_freq_vote(uint32_t widgetId);
+uint16_t multi_freq_base_sns_clk(uint32_t widgetId, uint16_t snsClk);
+const multi_freq_stats_t * multi_freq_get_stats(void);
+
+#endif /* MULTI_FREQ_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,339 @@
+/******************************************************************************
+ * File Name: raw_trace.c
+ *
+ * Description: Raw count recorder. Records of variable size, one per
+ * processed widget, are written into a byte ring that overwrites the oldest
+ * records. A trigger starts the post-trigger countdown, after which the ring
+ * freezes until the telemetry has read it out. The recorder and the telemetry
+ * both run in the main loop, so the ring needs no locking.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "cy_pdl.h"
+#include "tuner_telemetry.h"
+#include "raw_trace.h"
+
+#if (0u != RAW_TRACE_ENABLE)
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+#define RAW_TRACE_RECORDING              (0u)
+#define RAW_TRACE_POST_TRIGGER           (1u)
+#define RAW_TRACE_FROZEN                 (2u)
+
+/*******************************************************************************
+ * Global Definitions
+ *******************************************************************************/
+static uint8_t raw_trace_buf[RAW_TRACE_BUFFER_SIZE];
+static uint32_t raw_trace_head = 0u;
+static uint32_t raw_trace_tail = 0u;
+static uint32_t raw_trace_used = 0u;
+
+/* Position of the status byte of the last record, for raw_trace_status() */
+static uint32_t raw_trace_last_pos = 0u;
+static uint32_t raw_trace_last_size = 0u;
+static uint32_t raw_trace_last_widget = CY_CAPSENSE_WIDGET_COUNT;
+
+static uint32_t raw_trace_state = RAW_TRACE_RECORDING;
+static uint32_t raw_trace_post_left = 0u;
+static uint32_t raw_trace_dump = 0u;
+static bool raw_trace_active[CY_CAPSENSE_WIDGET_COUNT];
+static raw_trace_stats_t raw_trace_stats;
+
+/*******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+static void raw_trace_put(uint32_t value);
+static uint32_t raw_trace_size_at(uint32_t pos);
+
+/*******************************************************************************
+ * Function Name: raw_trace_init
+ ********************************************************************************
+ * Summary:
+ *  Empties the buffer and starts recording.
+ *
+ * Return:
+ *  void
+ *
+ * Parameters:
+ *  void
+ *******************************************************************************/
+void raw_trace_init(void)
+{
+    uint32_t wdId;
+
+    raw_trace_head = 0u;
+    raw_trace_tail = 0u;
+    raw_trace_used = 0u;
+    raw_trace_last_widget = CY_CAPSENSE_WIDGET_COUNT;
+    raw_trace_state = RAW_TRACE_RECORDING;
+    raw_trace_dump = 0u;
+    for (wdId = 0u; wdId < CY_CAPSENSE_WIDGET_COUNT; wdId++)
+    {
+        raw_trace_active[wdId] = false;
+    }
+}
+
+/*******************************************************************************
+ * Function Name: raw_trace_record
+ ********************************************************************************
+ * Summary:
+ *  Records the raw counts of a widget. Call before Cy_CapSense_ProcessWidget(),
+ *  which may filter the raw counts in place. The oldest records are
+ *  overwritten to make room.
+ *
+ * Return:
+ *  void
+ *
+ * Parameters:
+ *  widgetId - widget about to be processed
+ *  context - CAPSENSE context
+ *******************************************************************************/
+void raw_trace_record(uint32_t widgetId, const cy_stc_capsense_context_t * context)
+{
+    const cy_stc_capsense_widget_config_t * ptrWdCfg = &context->ptrWdConfig[widgetId];
+    uint32_t numSns = ptrWdCfg->numSns;
+    uint32_t size = TUNER_TELEMETRY_RAW_RECORD_HEADER_SIZE + (2u * numSns);
+    uint32_t oldest;
+    uint32_t count;
+    uint32_t snsId;
+
+    CY_ASSERT((numSns <= TUNER_TELEMETRY_RAW_SNS_MASK) && (size <= TUNER_TELEMETRY_RAW_BYTES));
+
+    raw_trace_last_widget = CY_CAPSENSE_WIDGET_COUNT;
+    if ((RAW_TRACE_FROZEN == raw_trace_state) || (size > RAW_TRACE_BUFFER_SIZE))
+    {
+        return;
+    }
+
+    while ((RAW_TRACE_BUFFER_SIZE - raw_trace_used) < size)
+    {
+        oldest = raw_trace_size_at(raw_trace_tail);
+        raw_trace_tail = (raw_trace_tail + oldest) % RAW_TRACE_BUFFER_SIZE;
+        raw_trace_used -= oldest;
+        raw_trace_stats.overwritten++;
+    }
+
+    count = Cy_WDT_GetCount();
+    raw_trace_put(widgetId);
+    raw_trace_last_pos = raw_trace_head;
+    raw_trace_put(numSns);
+    raw_trace_put(count);
+    raw_trace_put(count >> 8u);
+    for (snsId = 0u; snsId < numSns; snsId++)
+    {
+        raw_trace_put(ptrWdCfg->ptrSnsContext[snsId].raw);
+        raw_trace_put((uint32_t)ptrWdCfg->ptrSnsContext[snsId].raw >> 8u);
+    }
+    raw_trace_used += size;
+    raw_trace_last_size = size;
+    raw_trace_last_widget = widgetId;
+    raw_trace_stats.records++;
+}
+
+/*******************************************************************************
+ * Function Name: raw_trace_status
+ ********************************************************************************
+ * Summary:
+ *  Adds the result of Cy_CapSense_ProcessWidget() to the last record. With
+ *  RAW_TRACE_TRIGGER_ON_TOUCH, a widget becoming active triggers the
+ *  recorder. Freezes the buffer at the end of the post-trigger countdown.
+ *
+ * Return:
+ *  void
+ *
+ * Parameters:
+ *  widgetId - processed widget
+ *  active - result of Cy_CapSense_IsWidgetActive()
+ *******************************************************************************/
+void raw_trace_status(uint32_t widgetId, bool active)
+{
+    bool wasActive = raw_trace_active[widgetId];
+
+    raw_trace_active[widgetId] = active;
+    if (widgetId != raw_trace_last_widget)
+    {
+        return;
+    }
+    if (active)
+    {
+        raw_trace_buf[raw_trace_last_pos] |= TUNER_TELEMETRY_RAW_ACTIVE_MASK;
+        if ((0u != RAW_TRACE_TRIGGER_ON_TOUCH) && (!wasActive))
+        {
+            raw_trace_trigger();
+        }
+    }
+
+    if (RAW_TRACE_POST_TRIGGER == raw_trace_state)
+    {
+        if (raw_trace_post_left <= raw_trace_last_size)
+        {
+            raw_trace_state = RAW_TRACE_FROZEN;
+            raw_trace_stats.dumps++;
+        }
+        else
+        {
+            raw_trace_post_left -= raw_trace_last_size;
+        }
+    }
+}
+
+/*******************************************************************************
+ * Function Name: raw_trace_trigger
+ ********************************************************************************
+ * Summary:
+ *  Starts the post-trigger countdown, unless it already runs or the buffer
+ *  is frozen. Can be called by the application, for example on an
+ *  unexpected touch event.
+ *
+ * Return:
+ *  void
+ *
+ * Parameters:
+ *  void
+ *******************************************************************************/
+void raw_trace_trigger(void)
+{
+    if (RAW_TRACE_RECORDING == raw_trace_state)
+    {
+        raw_trace_state = RAW_TRACE_POST_TRIGGER;
+        raw_trace_post_left = RAW_TRACE_POST_TRIGGER_SIZE;
+    }
+}
+
+/* True while a frozen buffer waits to be read out */
+bool raw_trace_frozen(void)
+{
+    return (RAW_TRACE_FROZEN == raw_trace_state);
+}
+
+/*******************************************************************************
+ * Function Name: raw_trace_read
+ ********************************************************************************
+ * Summary:
+ *  Removes the oldest whole records of a frozen buffer. Recording restarts
+ *  with an empty buffer, and the dump number is incremented, when the last
+ *  record is read.
+ *
+ * Return:
+ *  uint32_t - bytes copied, 0 if the buffer is not frozen
+ *
+ * Parameters:
+ *  dst - destination
+ *  maxSize - size of the destination in bytes
+ *  records - receives the number of records copied
+ *******************************************************************************/
+uint32_t raw_trace_read(uint8_t * dst, uint32_t maxSize, uint32_t * records)
+{
+    uint32_t pos = 0u;
+    uint32_t size;
+
+    *records = 0u;
+    if (RAW_TRACE_FROZEN != raw_trace_state)
+    {
+        return 0u;
+    }
+
+    while (0u != raw_trace_used)
+    {
+        size = raw_trace_size_at(raw_trace_tail);
+        if ((pos + size) > maxSize)
+        {
+            break;
+        }
+        raw_trace_used -= size;
+        while (0u != size--)
+        {
+            dst[pos++] = raw_trace_buf[raw_trace_tail];
+            raw_trace_tail = (raw_trace_tail < (RAW_TRACE_BUFFER_SIZE - 1u)) ? (raw_trace_tail + 1u) : 0u;
+        }
+        (*records)++;
+    }
+
+    if (0u == raw_trace_used)
+    {
+        raw_trace_head = 0u;
+        raw_trace_tail = 0u;
+        raw_trace_dump++;
+        raw_trace_state = RAW_TRACE_RECORDING;
+    }
+    return pos;
+}
+
+/* Number of the dump being read out, incremented after each dump */
+uint32_t raw_trace_dump_number(void)
+{
+    return raw_trace_dump;
+}
+
+/*******************************************************************************
+ * Function Name: raw_trace_get_stats
+ ********************************************************************************
+ * Summary:
+ *  Returns the recorder counters.
+ *
+ * Return:
+ *  const raw_trace_stats_t * - statistics
+ *
+ * Parameters:
+ *  void
+ *******************************************************************************/
+const raw_trace_stats_t * raw_trace_get_stats(void)
+{
+    return &raw_trace_stats;
+}
+
+static void raw_trace_put(uint32_t value)
+{
+    raw_trace_buf[raw_trace_head] = (uint8_t)value;
+    raw_trace_head = (raw_trace_head < (RAW_TRACE_BUFFER_SIZE - 1u)) ? (raw_trace_head + 1u) : 0u;
+}
+
+/* Size of the record starting at pos */
+static uint32_t raw_trace_size_at(uint32_t pos)
+{
+    uint32_t numSns = raw_trace_buf[(pos + 1u) % RAW_TRACE_BUFFER_SIZE] & TUNER_TELEMETRY_RAW_SNS_MASK;
+
+    return TUNER_TELEMETRY_RAW_RECORD_HEADER_SIZE + (2u * numSns);
+}
+
+#endif /* RAW_TRACE_ENABLE */
+
+/* [] END OF FILE */
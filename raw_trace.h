@@ -0,0 +1,123 @@
+/******************************************************************************
+ * File Name: raw_trace.h
+ *
+ * Description: Raw count recorder. Logs the raw counts and the resulting
+ * widget status of each processed widget into a circular buffer, freezes the
+ * buffer some time after a trigger, and hands the frozen records to the
+ * telemetry stream. The host replays the records in the host simulation.
+ * Compiled out unless RAW_TRACE_ENABLE is set.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+
+#ifndef RAW_TRACE_H
+#define RAW_TRACE_H
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include "cycfg_capsense.h"
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+/* 1 = record the raw counts, dumped with TUNER_TELEMETRY_DELTA,
+ * 0 = no recorder
+ */
+#ifndef RAW_TRACE_ENABLE
+#define RAW_TRACE_ENABLE                 (0u)
+#endif
+
+/* Size of the circular buffer in bytes. A record takes
+ * TUNER_TELEMETRY_RAW_RECORD_HEADER_SIZE bytes plus 2 bytes per sensor of the
+ * widget, see tuner_telemetry.h for the format.
+ */
+#ifndef RAW_TRACE_BUFFER_SIZE
+#define RAW_TRACE_BUFFER_SIZE            (1024u)
+#endif
+
+/* Bytes recorded after the trigger before the buffer freezes. The rest of the
+ * buffer keeps the history before the trigger.
+ */
+#ifndef RAW_TRACE_POST_TRIGGER_SIZE
+#define RAW_TRACE_POST_TRIGGER_SIZE      (RAW_TRACE_BUFFER_SIZE / 2u)
+#endif
+
+/* 1 = a widget becoming active triggers the recorder, 0 = only
+ * raw_trace_trigger() does
+ */
+#ifndef RAW_TRACE_TRIGGER_ON_TOUCH
+#define RAW_TRACE_TRIGGER_ON_TOUCH       (1u)
+#endif
+
+/* Instrumentation of the application. RAW_TRACE_RECORD() logs the raw counts
+ * before Cy_CapSense_ProcessWidget(), RAW_TRACE_STATUS() adds the result.
+ */
+#if (0u != RAW_TRACE_ENABLE)
+#define RAW_TRACE_RECORD(id, context)    raw_trace_record((id), (context))
+#define RAW_TRACE_STATUS(id, active)     raw_trace_status((id), (active))
+#else
+#define RAW_TRACE_RECORD(id, context)    ((void)(context))
+#define RAW_TRACE_STATUS(id, active)     ((void)(active))
+#endif /* RAW_TRACE_ENABLE */
+
+/*******************************************************************************
+ * Types
+ *******************************************************************************/
+typedef struct
+{
+    uint32_t records;                /* records logged */
+    uint32_t overwritten;            /* records overwritten by newer ones */
+    uint32_t dumps;                  /* frozen buffers handed out */
+} raw_trace_stats_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+void raw_trace_init(void);
+void raw_trace_record(uint32_t widgetId, const cy_stc_capsense_context_t * context);
+void raw_trace_status(uint32_t widgetId, bool active);
+void raw_trace_trigger(void);
+bool raw_trace_frozen(void);
+uint32_t raw_trace_read(uint8_t * dst, uint32_t maxSize, uint32_t * records);
+uint32_t raw_trace_dump_number(void);
+const raw_trace_stats_t * raw_trace_get_stats(void);
+
+#endif /* RAW_TRACE_H */
+
+/* [] END OF FILE */
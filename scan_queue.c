@@ -0,0 +1,145 @@
+/******************************************************************************
+ * File Name: scan_queue.c
+ *
+ * Description: Single-producer/single-consumer queue of scanned batches. The
+ * producer (end-of-scan interrupt) only writes the head index and the consumer
+ * (main loop) only writes the tail index, so neither side needs a critical
+ * section. On the single-core Cortex-M0+ the volatile accesses are sufficient
+ * to publish an entry before the head index that makes it visible.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "scan_queue.h"
+
+/*******************************************************************************
+ * Global Definitions
+ *******************************************************************************/
+static const scan_group_t * volatile scan_queue_buf[SCAN_QUEUE_SIZE];
+static volatile uint32_t scan_queue_head = 0u;
+static volatile uint32_t scan_queue_tail = 0u;
+
+/*******************************************************************************
+ * Function Name: scan_queue_init
+ ********************************************************************************
+ * Summary:
+ *  Empties the queue. Must be called before the first scan is started.
+ *
+ * Return:
+ *  void
+ *
+ * Parameters:
+ *  void
+ *******************************************************************************/
+void scan_queue_init(void)
+{
+    scan_queue_head = 0u;
+    scan_queue_tail = 0u;
+}
+
+/*******************************************************************************
+ * Function Name: scan_queue_push
+ ********************************************************************************
+ * Summary:
+ *  Appends a scanned batch. Producer side, called from the end-of-scan
+ *  interrupt.
+ *
+ * Return:
+ *  bool - false if the queue is full
+ *
+ * Parameters:
+ *  group - batch whose scan has completed
+ *******************************************************************************/
+bool scan_queue_push(const scan_group_t * group)
+{
+    uint32_t head = scan_queue_head;
+    uint32_t next = (head < (SCAN_QUEUE_SIZE - 1u)) ? (head + 1u) : 0u;
+
+    if (next == scan_queue_tail)
+    {
+        return false;
+    }
+    scan_queue_buf[head] = group;
+    scan_queue_head = next;
+    return true;
+}
+
+/*******************************************************************************
+ * Function Name: scan_queue_pop
+ ********************************************************************************
+ * Summary:
+ *  Removes the oldest scanned batch. Consumer side, called from the main loop.
+ *
+ * Return:
+ *  const scan_group_t * - NULL if the queue is empty
+ *
+ * Parameters:
+ *  void
+ *******************************************************************************/
+const scan_group_t * scan_queue_pop(void)
+{
+    uint32_t tail = scan_queue_tail;
+    const scan_group_t * group;
+
+    if (tail == scan_queue_head)
+    {
+        return NULL;
+    }
+    group = scan_queue_buf[tail];
+    scan_queue_tail = (tail < (SCAN_QUEUE_SIZE - 1u)) ? (tail + 1u) : 0u;
+    return group;
+}
+
+/*******************************************************************************
+ * Function Name: scan_queue_is_empty
+ ********************************************************************************
+ * Summary:
+ *  Checks whether a scanned batch is waiting for processing.
+ *
+ * Return:
+ *  bool
+ *
+ * Parameters:
+ *  void
+ *******************************************************************************/
+bool scan_queue_is_empty(void)
+{
+    return (scan_queue_tail == scan_queue_head);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,71 @@
+/******************************************************************************
+ * File Name: scan_queue.h
+ *
+ * Description: Single-producer/single-consumer queue of scanned batches. The
+ * end-of-scan interrupt pushes each batch whose scan has completed and the
+ * main loop pops the batches to process them. The queue is lock-free: each
+ * index is written by one side only.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+
+#ifndef SCAN_QUEUE_H
+#define SCAN_QUEUE_H
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "scan_schedule.h"
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+/* One entry per batch is enough: a batch is not scanned again before it is
+ * processed. One entry stays free to tell a full queue from an empty one.
+ */
+#define SCAN_QUEUE_SIZE                  (CY_CAPSENSE_WIDGET_COUNT + 1u)
+
+/*******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+void scan_queue_init(void);
+bool scan_queue_push(const scan_group_t * group);
+const scan_group_t * scan_queue_pop(void);
+bool scan_queue_is_empty(void);
+
+#endif /* SCAN_QUEUE_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,908 @@
+/******************************************************************************
+ * File Name: scan_schedule.c
+ *
+ * Description: Scan schedule of the CAPSENSE pipeline. The widgets are split
+ * into batches of consecutive widgets whose slots are contiguous, so that each
+ * batch can be scanned by one Cy_CapSense_ScanSlots() call. Batching amortizes
+ * the scan setup and the main loop overhead over several widgets, which
+ * matters for designs with many small CSX buttons. The batch table of each kit
+ * is generated from its design.cycapsense into scan_schedule_table.h. At run
+ * time, the batches are split and reordered so that the scan of each batch
+ * covers the processing of the batch before it.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include <string.h>
+#include "scan_schedule.h"
+#include "scan_schedule_table.h"
+#include "sleep_policy.h"
+#include "wdt_timer.h"
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+/* The generated table is used only if it was made for this widget layout and
+ * batching; otherwise the batches are built at start-up.
+ */
+#if (0u != PIPELINE_STATIC_SCHEDULE) && (0u == PIPELINE_SEQUENTIAL_SCAN) && \
+    defined(SCAN_SCHEDULE_TABLE_GROUPS) && \
+    (SCAN_SCHEDULE_TABLE_WIDGETS == CY_CAPSENSE_WIDGET_COUNT) && \
+    (SCAN_SCHEDULE_TABLE_SLOTS == CY_CAPSENSE_SLOT_COUNT) && \
+    (SCAN_SCHEDULE_TABLE_BATCH_WIDGETS == PIPELINE_BATCH_WIDGETS) && \
+    (SCAN_SCHEDULE_TABLE_BATCH_MIN_SLOTS == PIPELINE_BATCH_MIN_SLOTS)
+#define SCAN_SCHEDULE_STATIC             (1u)
+#else
+#define SCAN_SCHEDULE_STATIC             (0u)
+#endif
+
+#define SCAN_SCHEDULE_WDT_MASK           (0xFFFFu)
+
+/* Processing times are averaged in 1/16 us, with a weight of 1/8 per sample */
+#define SCAN_SCHEDULE_FRACTION_SHIFT     (4u)
+#define SCAN_SCHEDULE_AVERAGE_SHIFT      (3u)
+
+/*******************************************************************************
+ * Global Definitions
+ *******************************************************************************/
+/* Startup table: the generated table, kept in flash, or the table built from
+ * the widget configuration
+ */
+#if (0u != SCAN_SCHEDULE_STATIC)
+static const scan_group_t scan_table_groups[SCAN_SCHEDULE_TABLE_NUM_GROUPS] = SCAN_SCHEDULE_TABLE_GROUPS;
+#else
+static scan_group_t scan_built_groups[CY_CAPSENSE_WIDGET_COUNT];
+#endif
+
+/* Batch table in use: the startup table above or the balanced table */
+static const scan_group_t * scan_groups = NULL;
+static uint32_t scan_num_groups = 0u;
+static uint32_t scan_next_group = 0u;
+
+/* Batch returned by scan_schedule_next() and not yet processed. Set in the
+ * end-of-scan interrupt, cleared by the main loop after processing.
+ */
+static volatile bool scan_in_flight[CY_CAPSENSE_WIDGET_COUNT];
+
+#if (0u != PIPELINE_ADAPTIVE_SCHEDULE)
+/* Scans since the last scan of each batch */
+static uint16_t scan_age[CY_CAPSENSE_WIDGET_COUNT];
+/* Touch activity of each batch at its last processing */
+static volatile bool scan_active[CY_CAPSENSE_WIDGET_COUNT];
+static uint32_t scan_max_revisit = PIPELINE_MAX_REVISIT_SCANS;
+static uint32_t scan_idle_turn = 0u;
+#endif
+
+#if (0u != SCAN_SCHEDULE_BALANCE)
+static const cy_stc_capsense_context_t * scan_context = NULL;
+
+/* Startup table, the starting point of every balance */
+static const scan_group_t * scan_base_groups = NULL;
+static uint32_t scan_base_num_groups = 0u;
+
+/* Balanced table. It is rebuilt only while the startup table is in use. */
+static scan_group_t scan_balanced_groups[CY_CAPSENSE_WIDGET_COUNT];
+static uint32_t scan_balanced_num_groups = 0u;
+static uint32_t scan_balanced_period = 0u;
+static bool scan_rebalance = false;
+
+/* Table installed by scan_schedule_next() once no batch is in flight, NULL
+ * if none. The scan stops until then.
+ */
+static const scan_group_t * volatile scan_new_groups = NULL;
+static uint32_t scan_new_num_groups = 0u;
+
+/* Average processing time of each widget in 1/16 us, 0 until first measured */
+static uint32_t scan_process_time[CY_CAPSENSE_WIDGET_COUNT];
+static uint32_t scan_process_stamp = 0u;
+static uint32_t scan_processed_widgets = 0u;
+#endif /* SCAN_SCHEDULE_BALANCE */
+
+static scan_schedule_stats_t scan_stats;
+
+#if (0u == SCAN_SCHEDULE_STATIC)
+/*******************************************************************************
+ * Function Name: scan_schedule_batch_slots
+ ********************************************************************************
+ * Summary:
+ *  Returns the minimum number of slots per batch used by the automatic
+ *  batching: PIPELINE_BATCH_MIN_SLOTS, limited to half of the total slot count
+ *  so that every frame keeps at least two batches in the pipeline.
+ *
+ * Return:
+ *  uint32_t
+ *
+ * Parameters:
+ *  totalSlots
+ *******************************************************************************/
+static uint32_t scan_schedule_batch_slots(uint32_t totalSlots)
+{
+    uint32_t batchSlots = PIPELINE_BATCH_MIN_SLOTS;
+
+    if (batchSlots > (totalSlots / 2u))
+    {
+        batchSlots = totalSlots / 2u;
+    }
+    return (0u != batchSlots) ? batchSlots : 1u;
+}
+
+/*******************************************************************************
+ * Function Name: scan_schedule_build
+ ********************************************************************************
+ * Summary:
+ *  Builds the batch table from the widget configuration. A widget starts a
+ *  new batch when the current batch is full or when its slots do not directly
+ *  follow the slots of the previous widget.
+ *
+ * Return:
+ *  void
+ *
+ * Parameters:
+ *  context - CAPSENSE context
+ *******************************************************************************/
+static void scan_schedule_build(const cy_stc_capsense_context_t * context)
+{
+    const cy_stc_capsense_widget_config_t * ptrWdCfg = context->ptrWdConfig;
+    uint32_t numWgt = context->ptrCommonConfig->numWd;
+    uint32_t totalSlots = 0u;
+    uint32_t batchWidgets = PIPELINE_BATCH_WIDGETS;
+    uint32_t batchSlots = CY_CAPSENSE_SLOT_COUNT;
+    uint32_t wdId;
+    scan_group_t * group = NULL;
+
+    for (wdId = 0u; wdId < numWgt; wdId++)
+    {
+        totalSlots += ptrWdCfg[wdId].numSlots;
+    }
+    if (0u == batchWidgets)
+    {
+        batchWidgets = numWgt;
+        batchSlots = scan_schedule_batch_slots(totalSlots);
+    }
+#if (0u != PIPELINE_SEQUENTIAL_SCAN)
+    /* One batch: the next scan starts only after the processing */
+    batchWidgets = numWgt;
+    batchSlots = CY_CAPSENSE_SLOT_COUNT;
+#endif /* PIPELINE_SEQUENTIAL_SCAN */
+
+    scan_num_groups = 0u;
+    for (wdId = 0u; wdId < numWgt; wdId++)
+    {
+        bool full;
+
+        if (NULL == group)
+        {
+            full = true;
+        }
+        else
+        {
+            full = ((group->numWidgets >= batchWidgets) || (group->numSlots >= batchSlots));
+        }
+
+        if (full || ((group->firstSlotId + group->numSlots) != ptrWdCfg[wdId].firstSlotId))
+        {
+            group = &scan_built_groups[scan_num_groups++];
+            group->firstWidgetId = (uint8_t)wdId;
+            group->numWidgets = 0u;
+            group->firstSlotId = ptrWdCfg[wdId].firstSlotId;
+            group->numSlots = 0u;
+        }
+        group->numWidgets++;
+        group->numSlots += ptrWdCfg[wdId].numSlots;
+    }
+}
+#else
+/*******************************************************************************
+ * Function Name: scan_schedule_check
+ ********************************************************************************
+ * Summary:
+ *  Asserts that the generated table matches the widget configuration, which
+ *  fails if the design changed without regenerating scan_schedule_table.h.
+ *
+ * Return:
+ *  void
+ *
+ * Parameters:
+ *  context - CAPSENSE context
+ *******************************************************************************/
+static void scan_schedule_check(const cy_stc_capsense_context_t * context)
+{
+    const cy_stc_capsense_widget_config_t * ptrWdCfg = context->ptrWdConfig;
+    uint32_t idx;
+    uint32_t wdId;
+    uint32_t slotId;
+
+    CY_ASSERT(SCAN_SCHEDULE_TABLE_WIDGETS == context->ptrCommonConfig->numWd);
+    for (idx = 0u; idx < scan_num_groups; idx++)
+    {
+        slotId = scan_groups[idx].firstSlotId;
+        for (wdId = scan_groups[idx].firstWidgetId;
+             wdId < (uint32_t)(scan_groups[idx].firstWidgetId + scan_groups[idx].numWidgets); wdId++)
+        {
+            CY_ASSERT(ptrWdCfg[wdId].firstSlotId == slotId);
+            slotId += ptrWdCfg[wdId].numSlots;
+        }
+        CY_ASSERT(slotId == (uint32_t)(scan_groups[idx].firstSlotId + scan_groups[idx].numSlots));
+    }
+    (void)ptrWdCfg;
+    (void)slotId;
+}
+#endif /* SCAN_SCHEDULE_STATIC */
+
+/*******************************************************************************
+ * Function Name: scan_schedule_init
+ ********************************************************************************
+ * Summary:
+ *  Selects the batch table: the table generated for the kit in
+ *  scan_schedule_table.h, or a table built from the widget configuration.
+ *  Resets the scan state of the batches and the measurements of the
+ *  balancing.
+ *
+ * Return:
+ *  void
+ *
+ * Parameters:
+ *  context - CAPSENSE context
+ *******************************************************************************/
+void scan_schedule_init(const cy_stc_capsense_context_t * context)
+{
+    uint32_t wdId;
+
+#if (0u != SCAN_SCHEDULE_STATIC)
+    scan_groups = scan_table_groups;
+    scan_num_groups = SCAN_SCHEDULE_TABLE_NUM_GROUPS;
+    scan_schedule_check(context);
+#else
+    scan_schedule_build(context);
+    scan_groups = scan_built_groups;
+#endif
+
+    scan_next_group = 0u;
+
+#if (0u != SCAN_SCHEDULE_BALANCE)
+    scan_context = context;
+    scan_base_groups = scan_groups;
+    scan_base_num_groups = scan_num_groups;
+    scan_rebalance = false;
+    scan_new_groups = NULL;
+    for (wdId = 0u; wdId < CY_CAPSENSE_WIDGET_COUNT; wdId++)
+    {
+        scan_process_time[wdId] = 0u;
+    }
+    scan_processed_widgets = 0u;
+    memset(&scan_stats, 0, sizeof(scan_stats));
+    scan_stats.numGroups = scan_num_groups;
+#endif /* SCAN_SCHEDULE_BALANCE */
+
+    for (wdId = 0u; wdId < scan_num_groups; wdId++)
+    {
+        scan_in_flight[wdId] = false;
+    }
+
+#if (0u != PIPELINE_ADAPTIVE_SCHEDULE)
+    for (wdId = 0u; wdId < scan_num_groups; wdId++)
+    {
+        scan_age[wdId] = 0u;
+        scan_active[wdId] = false;
+    }
+    scan_max_revisit = (PIPELINE_MAX_REVISIT_SCANS > scan_num_groups) ? PIPELINE_MAX_REVISIT_SCANS : scan_num_groups;
+    scan_idle_turn = 0u;
+#endif
+}
+
+#if (0u != PIPELINE_ADAPTIVE_SCHEDULE)
+/*******************************************************************************
+ * Function Name: scan_schedule_pick
+ ********************************************************************************
+ * Summary:
+ *  Selects the index of the next batch to scan among the batches that are not
+ *  in flight:
+ *  - the oldest batch, if it has reached the maximum revisit interval
+ *  - the oldest idle batch, on every PIPELINE_IDLE_SCAN_DIVIDER-th scan
+ *  - otherwise the next active batch in round-robin order
+ *  - the next batch in round-robin order if no batch is active
+ *
+ * Return:
+ *  uint32_t - batch index, scan_num_groups if all batches are in flight
+ *
+ * Parameters:
+ *  void
+ *******************************************************************************/
+static uint32_t scan_schedule_pick(void)
+{
+    uint32_t oldest = scan_num_groups;
+    uint32_t oldestIdle = scan_num_groups;
+    uint32_t nextIdle = scan_num_groups;
+    uint32_t nextActive = scan_num_groups;
+    bool anyActive = false;
+    uint32_t i;
+
+    for (i = 0u; i < scan_num_groups; i++)
+    {
+        /* Visit the batches starting from the round-robin position */
+        uint32_t idx = scan_next_group + i;
+        idx = (idx < scan_num_groups) ? idx : (idx - scan_num_groups);
+
+        if (scan_active[idx])
+        {
+            anyActive = true;
+        }
+        if (scan_in_flight[idx])
+        {
+            continue;
+        }
+
+        if ((oldest == scan_num_groups) || (scan_age[idx] > scan_age[oldest]))
+        {
+            oldest = idx;
+        }
+        if (scan_active[idx])
+        {
+            if (nextActive == scan_num_groups)
+            {
+                nextActive = idx;
+            }
+        }
+        else
+        {
+            if (nextIdle == scan_num_groups)
+            {
+                nextIdle = idx;
+            }
+            if ((oldestIdle == scan_num_groups) || (scan_age[idx] > scan_age[oldestIdle]))
+            {
+                oldestIdle = idx;
+            }
+        }
+    }
+
+    if ((oldest == scan_num_groups) || (scan_age[oldest] >= scan_max_revisit))
+    {
+        return oldest;
+    }
+    if (!anyActive)
+    {
+        /* No activity: plain round-robin */
+        return nextIdle;
+    }
+    if ((++scan_idle_turn >= PIPELINE_IDLE_SCAN_DIVIDER) || (nextActive == scan_num_groups))
+    {
+        scan_idle_turn = 0u;
+        if (oldestIdle != scan_num_groups)
+        {
+            return oldestIdle;
+        }
+    }
+    return nextActive;
+}
+#endif
+
+#if (0u != SCAN_SCHEDULE_BALANCE)
+/*******************************************************************************
+ * Function Name: scan_schedule_install
+ ********************************************************************************
+ * Summary:
+ *  Switches to the table of scan_schedule_request() if no batch is in
+ *  flight. The batches restart in round-robin order, idle; an active batch
+ *  is flagged again after its next processing.
+ *
+ * Return:
+ *  bool - true if the table is installed
+ *
+ * Parameters:
+ *  void
+ *******************************************************************************/
+static bool scan_schedule_install(void)
+{
+    uint32_t idx;
+
+    for (idx = 0u; idx < scan_num_groups; idx++)
+    {
+        if (scan_in_flight[idx])
+        {
+            return false;
+        }
+    }
+
+    scan_groups = scan_new_groups;
+    scan_num_groups = scan_new_num_groups;
+    scan_next_group = 0u;
+#if (0u != PIPELINE_ADAPTIVE_SCHEDULE)
+    for (idx = 0u; idx < scan_num_groups; idx++)
+    {
+        scan_age[idx] = 0u;
+        scan_active[idx] = false;
+    }
+    scan_max_revisit = (PIPELINE_MAX_REVISIT_SCANS > scan_num_groups) ? PIPELINE_MAX_REVISIT_SCANS : scan_num_groups;
+    scan_idle_turn = 0u;
+#endif
+    scan_stats.numGroups = scan_num_groups;
+    scan_stats.balances++;
+    scan_new_groups = NULL;
+    return true;
+}
+#endif /* SCAN_SCHEDULE_BALANCE */
+
+/*******************************************************************************
+ * Function Name: scan_schedule_next
+ ********************************************************************************
+ * Summary:
+ *  Returns the next batch to scan and marks it in flight. A batch in flight is
+ *  not returned again until scan_schedule_update() reports its processing, so
+ *  the sensor data of a batch is never overwritten by a new scan before it is
+ *  processed. Called from the end-of-scan interrupt or with interrupts
+ *  disabled. A balanced table waiting to be installed stops the scan until
+ *  every batch in flight is processed; the call that finds the pipeline
+ *  empty installs it.
+ *
+ * Return:
+ *  const scan_group_t * - NULL if all batches are in flight, or while the
+ *  pipeline drains for a new table
+ *
+ * Parameters:
+ *  void
+ *******************************************************************************/
+const scan_group_t * scan_schedule_next(void)
+{
+    uint32_t idx;
+    uint32_t i;
+
+#if (0u != SCAN_SCHEDULE_BALANCE)
+    if ((NULL != scan_new_groups) && !scan_schedule_install())
+    {
+        return NULL;
+    }
+#endif /* SCAN_SCHEDULE_BALANCE */
+
+#if (0u != PIPELINE_ADAPTIVE_SCHEDULE)
+    idx = scan_schedule_pick();
+    if (idx >= scan_num_groups)
+    {
+        return NULL;
+    }
+    for (i = 0u; i < scan_num_groups; i++)
+    {
+        if (scan_age[i] < UINT16_MAX)
+        {
+            scan_age[i]++;
+        }
+    }
+    scan_age[idx] = 0u;
+#else
+    idx = scan_next_group;
+    for (i = 0u; (i < scan_num_groups) && scan_in_flight[idx]; i++)
+    {
+        idx = (idx < (scan_num_groups - 1u)) ? (idx + 1u) : 0u;
+    }
+    if (scan_in_flight[idx])
+    {
+        return NULL;
+    }
+#endif
+
+    scan_in_flight[idx] = true;
+    scan_next_group = (idx < (scan_num_groups - 1u)) ? (idx + 1u) : 0u;
+    return &scan_groups[idx];
+}
+
+/*******************************************************************************
+ * Function Name: scan_schedule_update
+ ********************************************************************************
+ * Summary:
+ *  Reports the touch activity of a batch after its widgets are processed and
+ *  releases the batch for the next scan.
+ *
+ * Return:
+ *  void
+ *
+ * Parameters:
+ *  group - batch returned by scan_schedule_next()
+ *  active - true if any widget of the batch is active
+ *******************************************************************************/
+void scan_schedule_update(const scan_group_t * group, bool active)
+{
+    uint32_t idx = (uint32_t)(group - scan_groups);
+
+#if (0u != PIPELINE_ADAPTIVE_SCHEDULE)
+    scan_active[idx] = active;
+#else
+    (void)active;
+#endif
+    scan_in_flight[idx] = false;
+}
+
+#if (0u != SCAN_SCHEDULE_BALANCE)
+/*******************************************************************************
+ * Function Name: scan_schedule_process_begin
+ ********************************************************************************
+ * Summary:
+ *  Starts the time measurement of the processing of a batch. Call from the
+ *  main loop before the first widget of the batch is processed.
+ *
+ * Return:
+ *  void
+ *
+ * Parameters:
+ *  void
+ *******************************************************************************/
+void scan_schedule_process_begin(void)
+{
+    scan_process_stamp = Cy_WDT_GetCount();
+}
+
+/*******************************************************************************
+ * Function Name: scan_schedule_processed
+ ********************************************************************************
+ * Summary:
+ *  Measures the processing of a widget since the previous widget of its
+ *  batch, or since scan_schedule_process_begin(), and updates its average.
+ *  The time includes the interrupts served meanwhile; like the scan times,
+ *  the one-ILO-cycle resolution of the WDT counter averages out over many
+ *  frames.
+ *
+ * Return:
+ *  void
+ *
+ * Parameters:
+ *  widgetId - widget that has been processed
+ *******************************************************************************/
+void scan_schedule_processed(uint32_t widgetId)
+{
+    uint32_t now = Cy_WDT_GetCount();
+    uint32_t sample;
+
+    sample = wdt_timer_ticks_to_us((now - scan_process_stamp) & SCAN_SCHEDULE_WDT_MASK);
+    sample = (sample << SCAN_SCHEDULE_FRACTION_SHIFT) | 1u;
+    scan_process_stamp = now;
+
+    if (0u == scan_process_time[widgetId])
+    {
+        scan_process_time[widgetId] = sample;
+    }
+    else
+    {
+        scan_process_time[widgetId] = (uint32_t)((int32_t)scan_process_time[widgetId] +
+            (((int32_t)sample - (int32_t)scan_process_time[widgetId]) >> SCAN_SCHEDULE_AVERAGE_SHIFT));
+    }
+    scan_processed_widgets++;
+}
+
+/*******************************************************************************
+ * Function Name: scan_schedule_cost
+ ********************************************************************************
+ * Summary:
+ *  Sums the measured scan and processing times of the widgets of a batch, in
+ *  microseconds.
+ *
+ *******************************************************************************/
+static void scan_schedule_cost(const scan_group_t * group, uint32_t * scanUs, uint32_t * processUs)
+{
+    uint32_t wdId;
+
+    *scanUs = 0u;
+    *processUs = 0u;
+    for (wdId = group->firstWidgetId; wdId < (uint32_t)(group->firstWidgetId + group->numWidgets); wdId++)
+    {
+        *scanUs += sleep_policy_widget_scan_us(wdId);
+        *processUs += scan_process_time[wdId] >> SCAN_SCHEDULE_FRACTION_SHIFT;
+    }
+}
+
+/*******************************************************************************
+ * Function Name: scan_schedule_period
+ ********************************************************************************
+ * Summary:
+ *  Estimates the frame period of a batch table. While a batch is processed,
+ *  the next batch of the table is scanned, so each pair takes the longer of
+ *  the two.
+ *
+ *******************************************************************************/
+static uint32_t scan_schedule_period(const scan_group_t * groups, uint32_t numGroups)
+{
+    uint32_t period = 0u;
+    uint32_t scanUs;
+    uint32_t processUs;
+    uint32_t nextScanUs;
+    uint32_t unused;
+    uint32_t idx;
+
+    for (idx = 0u; idx < numGroups; idx++)
+    {
+        scan_schedule_cost(&groups[idx], &scanUs, &processUs);
+        scan_schedule_cost(&groups[(idx < (numGroups - 1u)) ? (idx + 1u) : 0u], &nextScanUs, &unused);
+        period += (processUs > nextScanUs) ? processUs : nextScanUs;
+    }
+    (void)scanUs;
+    return period;
+}
+
+/*******************************************************************************
+ * Function Name: scan_schedule_split
+ ********************************************************************************
+ * Summary:
+ *  Splits the batches of the base table whose scan plus processing time
+ *  exceeds limitUs into the fewest batches of similar time below the limit,
+ *  or into single widgets. Writes the batches to scan_balanced_groups.
+ *
+ *******************************************************************************/
+static void scan_schedule_split(uint32_t limitUs)
+{
+    const cy_stc_capsense_widget_config_t * ptrWdCfg = scan_context->ptrWdConfig;
+    const scan_group_t * base;
+    scan_group_t * group;
+    uint32_t scanUs;
+    uint32_t processUs;
+    uint32_t pieces;
+    uint32_t piece;
+    uint32_t done;
+    uint32_t cost;
+    uint32_t idx;
+    uint32_t wdId;
+
+    scan_balanced_num_groups = 0u;
+    for (idx = 0u; idx < scan_base_num_groups; idx++)
+    {
+        base = &scan_base_groups[idx];
+        scan_schedule_cost(base, &scanUs, &processUs);
+        pieces = ((scanUs + processUs) + limitUs - 1u) / limitUs;
+
+        /* Cut before a widget whose middle passes the next piece boundary */
+        group = NULL;
+        piece = 0u;
+        done = 0u;
+        for (wdId = base->firstWidgetId; wdId < (uint32_t)(base->firstWidgetId + base->numWidgets); wdId++)
+        {
+            cost = sleep_policy_widget_scan_us(wdId) + (scan_process_time[wdId] >> SCAN_SCHEDULE_FRACTION_SHIFT);
+            if ((NULL != group) && ((((done + (cost / 2u)) * pieces) / (scanUs + processUs)) > piece))
+            {
+                piece++;
+                group = NULL;
+            }
+            if (NULL == group)
+            {
+                group = &scan_balanced_groups[scan_balanced_num_groups++];
+                group->firstWidgetId = (uint8_t)wdId;
+                group->numWidgets = 0u;
+                group->firstSlotId = ptrWdCfg[wdId].firstSlotId;
+                group->numSlots = 0u;
+            }
+            group->numWidgets++;
+            group->numSlots += ptrWdCfg[wdId].numSlots;
+            done += cost;
+        }
+    }
+}
+
+/*******************************************************************************
+ * Function Name: scan_schedule_order
+ ********************************************************************************
+ * Summary:
+ *  Orders scan_balanced_groups so that the scan of each batch covers the
+ *  processing of the batch before it. The batch with the longest processing
+ *  goes first. Each following batch is the one with the shortest scan that
+ *  still covers the processing of the previous batch, or the one with the
+ *  longest scan if none does. Ties keep the widget order.
+ *
+ *******************************************************************************/
+static void scan_schedule_order(void)
+{
+    scan_group_t chosen;
+    uint32_t scanUs;
+    uint32_t processUs;
+    uint32_t coverUs = UINT32_MAX;
+    uint32_t bestScanUs = 0u;
+    uint32_t bestProcessUs = 0u;
+    uint32_t best;
+    bool covered;
+    bool bestCovered;
+    uint32_t pos;
+    uint32_t idx;
+
+    for (pos = 0u; pos < scan_balanced_num_groups; pos++)
+    {
+        best = pos;
+        bestCovered = false;
+        for (idx = pos; idx < scan_balanced_num_groups; idx++)
+        {
+            scan_schedule_cost(&scan_balanced_groups[idx], &scanUs, &processUs);
+            if (0u == pos)
+            {
+                /* First batch: longest processing */
+                if ((idx == pos) || (processUs > bestProcessUs))
+                {
+                    best = idx;
+                    bestProcessUs = processUs;
+                }
+                continue;
+            }
+            covered = (scanUs >= coverUs);
+            if ((idx == pos) || (covered && (!bestCovered || (scanUs < bestScanUs))) ||
+                (!covered && !bestCovered && (scanUs > bestScanUs)))
+            {
+                best = idx;
+                bestCovered = covered;
+                bestScanUs = scanUs;
+                bestProcessUs = processUs;
+            }
+        }
+
+        /* Move the chosen batch to its position, keeping the others in order */
+        chosen = scan_balanced_groups[best];
+        memmove(&scan_balanced_groups[pos + 1u], &scan_balanced_groups[pos], (best - pos) * sizeof(scan_group_t));
+        scan_balanced_groups[pos] = chosen;
+        coverUs = bestProcessUs;
+    }
+}
+
+/*******************************************************************************
+ * Function Name: scan_schedule_request
+ ********************************************************************************
+ * Summary:
+ *  Hands a table to scan_schedule_next(), which installs it once the pipeline
+ *  has drained.
+ *
+ *******************************************************************************/
+static void scan_schedule_request(const scan_group_t * groups, uint32_t numGroups)
+{
+    scan_new_num_groups = numGroups;
+
+    /* The count is stored before the interrupt can see the table */
+    __COMPILER_BARRIER();
+    scan_new_groups = groups;
+}
+
+/*******************************************************************************
+ * Function Name: scan_schedule_balance
+ ********************************************************************************
+ * Summary:
+ *  Every PIPELINE_BALANCE_INTERVAL_FRAMES frames, builds a balanced batch
+ *  table from the startup table and the measured times:
+ *  - the batches whose scan plus processing time exceeds
+ *    PIPELINE_BALANCE_LIMIT_PERCENT of the scan time of a frame are split
+ *  - the batches are ordered so that each scan covers the processing of the
+ *    batch before it
+ *  The table is installed if it shortens the estimated frame period of the
+ *  startup table by more than 1/16. The balanced table cannot be rebuilt
+ *  while it is in use: once its estimated period has grown by more than 1/16
+ *  since it was built, the startup table is installed again, and the next
+ *  call rebuilds the balanced table. When the processing of a frame takes
+ *  longer than its scan, the CPU is the bottleneck and the startup table is
+ *  used, since more batches only add overhead. Call once per main loop pass.
+ *
+ * Return:
+ *  void
+ *
+ * Parameters:
+ *  void
+ *******************************************************************************/
+void scan_schedule_balance(void)
+{
+    uint32_t scanUs = 0u;
+    uint32_t processUs = 0u;
+    uint32_t limitUs;
+    uint32_t period;
+    uint32_t wdId;
+
+    if ((NULL != scan_new_groups) || (!scan_rebalance &&
+        (scan_processed_widgets < (PIPELINE_BALANCE_INTERVAL_FRAMES * scan_context->ptrCommonConfig->numWd))))
+    {
+        return;
+    }
+    scan_processed_widgets = 0u;
+    scan_rebalance = false;
+
+    for (wdId = 0u; wdId < scan_context->ptrCommonConfig->numWd; wdId++)
+    {
+        if ((0u == sleep_policy_widget_scan_us(wdId)) || (0u == scan_process_time[wdId]))
+        {
+            /* Not every widget has been measured yet */
+            return;
+        }
+        scanUs += sleep_policy_widget_scan_us(wdId);
+        processUs += scan_process_time[wdId] >> SCAN_SCHEDULE_FRACTION_SHIFT;
+    }
+    scan_stats.frameScanUs = scanUs;
+    scan_stats.frameProcessUs = processUs;
+    scan_stats.periodUs = scan_schedule_period(scan_groups, scan_num_groups);
+
+    if (scan_groups == scan_balanced_groups)
+    {
+        if ((processUs >= scanUs) ||
+            ((scan_balanced_period + (scan_balanced_period / 16u)) < scan_stats.periodUs))
+        {
+            scan_schedule_request(scan_base_groups, scan_base_num_groups);
+            scan_rebalance = (processUs < scanUs);
+        }
+        return;
+    }
+    if (processUs >= scanUs)
+    {
+        return;
+    }
+
+    /* A short frame scan or a low limit percentage rounds the limit down to 0 */
+    limitUs = (scanUs * PIPELINE_BALANCE_LIMIT_PERCENT) / 100u;
+    scan_schedule_split((0u != limitUs) ? limitUs : 1u);
+    scan_schedule_order();
+    period = scan_schedule_period(scan_balanced_groups, scan_balanced_num_groups);
+    if ((period + (period / 16u)) < scan_stats.periodUs)
+    {
+        scan_balanced_period = period;
+        scan_schedule_request(scan_balanced_groups, scan_balanced_num_groups);
+    }
+}
+
+/*******************************************************************************
+ * Function Name: scan_schedule_get_stats
+ ********************************************************************************
+ * Summary:
+ *  Returns the batch count, the number of installed tables and the measured
+ *  frame times of the last balance.
+ *
+ * Return:
+ *  const scan_schedule_stats_t * - statistics
+ *
+ * Parameters:
+ *  void
+ *******************************************************************************/
+const scan_schedule_stats_t * scan_schedule_get_stats(void)
+{
+    return &scan_stats;
+}
+#else
+/*******************************************************************************
+ * Function Name: scan_schedule_get_stats
+ ********************************************************************************
+ * Summary:
+ *  Returns the batch count of the table in use. Without balancing, no table
+ *  is installed and no frame time is measured, so the other fields are 0.
+ *
+ * Return:
+ *  const scan_schedule_stats_t * - statistics
+ *
+ * Parameters:
+ *  void
+ *******************************************************************************/
+const scan_schedule_stats_t * scan_schedule_get_stats(void)
+{
+    scan_stats.numGroups = scan_num_groups;
+    return &scan_stats;
+}
+#endif /* SCAN_SCHEDULE_BALANCE */
+
+/* [] END OF FILE */
@@ -0,0 +1,204 @@
+/******************************************************************************
+ * File Name: scan_schedule.h
+ *
+ * Description: Scan schedule of the CAPSENSE pipeline. Groups widgets with
+ * contiguous slots into batches that are scanned by a single
+ * Cy_CapSense_ScanSlots() call and returns the batches in pipeline order.
+ * Batches with an active widget are rescanned at full rate, idle batches at a
+ * lower rate. The automatic batches are split and reordered at run time from
+ * the measured scan and processing times.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#ifndef SCAN_SCHEDULE_H
+#define SCAN_SCHEDULE_H
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "cy_pdl.h"
+#include "cycfg_capsense.h"
+#include "frame_governor.h"
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+/* Number of widgets scanned by one Cy_CapSense_ScanSlots() call.
+ * 1 scans one widget at a time, 0 selects the batch size automatically
+ * from the slot count.
+ */
+#ifndef PIPELINE_BATCH_WIDGETS
+#define PIPELINE_BATCH_WIDGETS           (0u)
+#endif
+
+/* 1 = scan all widgets with one Cy_CapSense_ScanSlots() call and process
+ * them after the scan, the scan-then-process loop without overlap, for
+ * comparison with the pipeline. Overrides PIPELINE_BATCH_WIDGETS.
+ */
+#ifndef PIPELINE_SEQUENTIAL_SCAN
+#define PIPELINE_SEQUENTIAL_SCAN         (0u)
+#endif
+
+/* Automatic batching: minimum number of slots in a batch. Batches are never
+ * made so large that a frame has fewer than two of them, so the scan of one
+ * batch always overlaps the processing of another.
+ */
+#ifndef PIPELINE_BATCH_MIN_SLOTS
+#define PIPELINE_BATCH_MIN_SLOTS         (4u)
+#endif
+
+/* Batch table: 1 = use the table generated for the kit in
+ * scan_schedule_table.h when it matches the widget layout and the batching
+ * options, 0 = always build the table from the widget configuration at start-up
+ */
+#ifndef PIPELINE_STATIC_SCHEDULE
+#define PIPELINE_STATIC_SCHEDULE         (1u)
+#endif
+
+/* Scan order: 1 = activity-aware, 0 = fixed round-robin order. The frame
+ * governor scans every batch once per frame, so it defaults to the fixed
+ * order.
+ */
+#ifndef PIPELINE_ADAPTIVE_SCHEDULE
+#if (0u != FRAME_GOVERNOR_ENABLE)
+#define PIPELINE_ADAPTIVE_SCHEDULE       (0u)
+#else
+#define PIPELINE_ADAPTIVE_SCHEDULE       (1u)
+#endif
+#endif
+
+#if (0u != FRAME_GOVERNOR_ENABLE) && (0u != PIPELINE_ADAPTIVE_SCHEDULE)
+#error "The frame governor scans every batch once per frame: PIPELINE_ADAPTIVE_SCHEDULE must be 0"
+#endif
+
+/* While any batch is active, every Nth scan is given to an idle batch and the
+ * remaining scans go to the active batches.
+ */
+#ifndef PIPELINE_IDLE_SCAN_DIVIDER
+#define PIPELINE_IDLE_SCAN_DIVIDER       (4u)
+#endif
+
+/* Maximum number of scans between two scans of the same batch. A new touch on
+ * an idle widget is therefore seen within this number of scans. The value is
+ * raised to the number of batches if it is lower.
+ */
+#ifndef PIPELINE_MAX_REVISIT_SCANS
+#define PIPELINE_MAX_REVISIT_SCANS       (16u)
+#endif
+
+/* Load balancing of the automatic batches: 1 = split and reorder the batches
+ * from the measured scan and processing times of the widgets, so that the
+ * scan of each batch covers the processing of the batch before it, 0 = keep
+ * the batches in widget order. Applies only to the automatic batching.
+ */
+#ifndef PIPELINE_BALANCED_SCHEDULE
+#define PIPELINE_BALANCED_SCHEDULE       (1u)
+#endif
+
+/* Largest scan plus processing time of a batch, in percent of the scan time
+ * of a frame. A batch must be processed before its turn to be scanned comes
+ * again; the margin covers the processing left over from the batch before.
+ */
+#ifndef PIPELINE_BALANCE_LIMIT_PERCENT
+#define PIPELINE_BALANCE_LIMIT_PERCENT   (75u)
+#endif
+
+/* Frames between two evaluations of the balance. A new batch table is
+ * installed only if it shortens the estimated frame period by more than
+ * 1/16, and the pipeline drains once to install it.
+ */
+#ifndef PIPELINE_BALANCE_INTERVAL_FRAMES
+#define PIPELINE_BALANCE_INTERVAL_FRAMES (256u)
+#endif
+
+#if (0u != PIPELINE_BALANCED_SCHEDULE) && (0u == PIPELINE_BATCH_WIDGETS) && (0u == PIPELINE_SEQUENTIAL_SCAN)
+#define SCAN_SCHEDULE_BALANCE            (1u)
+#else
+#define SCAN_SCHEDULE_BALANCE            (0u)
+#endif
+
+/* Instrumentation of the application. SCAN_SCHEDULE_PROCESS_BEGIN() starts
+ * the processing of a batch, SCAN_SCHEDULE_PROCESSED() ends the processing of
+ * each of its widgets, and SCAN_SCHEDULE_BALANCE_SERVICE() runs once per main
+ * loop pass.
+ */
+#if (0u != SCAN_SCHEDULE_BALANCE)
+#define SCAN_SCHEDULE_PROCESS_BEGIN()    scan_schedule_process_begin()
+#define SCAN_SCHEDULE_PROCESSED(id)      scan_schedule_processed(id)
+#define SCAN_SCHEDULE_BALANCE_SERVICE()  scan_schedule_balance()
+#else
+#define SCAN_SCHEDULE_PROCESS_BEGIN()
+#define SCAN_SCHEDULE_PROCESSED(id)
+#define SCAN_SCHEDULE_BALANCE_SERVICE()
+#endif /* SCAN_SCHEDULE_BALANCE */
+
+/*******************************************************************************
+ * Data types
+ *******************************************************************************/
+/* Widgets and slots scanned by one Cy_CapSense_ScanSlots() call */
+typedef struct
+{
+    uint8_t firstWidgetId;
+    uint8_t numWidgets;
+    uint16_t firstSlotId;
+    uint16_t numSlots;
+} scan_group_t;
+
+typedef struct
+{
+    uint32_t numGroups;              /* batches of the table in use */
+    uint32_t balances;               /* tables installed by the balancing */
+    uint32_t frameScanUs;            /* measured scan time of a frame */
+    uint32_t frameProcessUs;         /* measured processing time of a frame */
+    uint32_t periodUs;               /* estimated frame period of the table in use */
+} scan_schedule_stats_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+void scan_schedule_init(const cy_stc_capsense_context_t * context);
+const scan_group_t * scan_schedule_next(void);
+void scan_schedule_update(const scan_group_t * group, bool active);
+#if (0u != SCAN_SCHEDULE_BALANCE)
+void scan_schedule_process_begin(void);
+void scan_schedule_processed(uint32_t widgetId);
+void scan_schedule_balance(void);
+#endif /* SCAN_SCHEDULE_BALANCE */
+const scan_schedule_stats_t * scan_schedule_get_stats(void);
+
+#endif /* SCAN_SCHEDULE_H */
+
+/* [] END OF FILE */
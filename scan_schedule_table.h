@@ -0,0 +1,98 @@
+/******************************************************************************
+ * File Name: scan_schedule_table.h
+ *
+ * Description: Static scan schedule of each kit. Generated from the
+ * design.cycapsense of the kit by host_tools/schedule_gen; do not edit.
+ * Regenerate with "make -C host_tools schedule" after a layout change.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#ifndef SCAN_SCHEDULE_TABLE_H
+#define SCAN_SCHEDULE_TABLE_H
+
+/* Batching the tables were generated for */
+#define SCAN_SCHEDULE_TABLE_BATCH_WIDGETS (0u)
+#define SCAN_SCHEDULE_TABLE_BATCH_MIN_SLOTS (4u)
+
+#if defined(TARGET_APP_KIT_PSOC4_HVMS_128K_LITE_02) || defined(TARGET_KIT_PSOC4_HVMS_128K_LITE_02)
+/* templates/TARGET_KIT_PSOC4-HVMS-128K_LITE-02/config/design.cycapsense */
+#define SCAN_SCHEDULE_TABLE_WIDGETS      (2u)
+#define SCAN_SCHEDULE_TABLE_SLOTS        (2u)
+#define SCAN_SCHEDULE_TABLE_NUM_GROUPS   (2u)
+/* firstWidgetId, numWidgets, firstSlotId, numSlots */
+#define SCAN_SCHEDULE_TABLE_GROUPS \
+{ \
+    {0u, 1u, 0u, 1u}, /* Button0 */ \
+    {1u, 1u, 1u, 1u}, /* Button1 */ \
+}
+#elif defined(TARGET_APP_KIT_PSOC4_HVMS_128K_LITE) || defined(TARGET_KIT_PSOC4_HVMS_128K_LITE)
+/* templates/TARGET_KIT_PSOC4-HVMS-128K_LITE/config/design.cycapsense */
+#define SCAN_SCHEDULE_TABLE_WIDGETS      (2u)
+#define SCAN_SCHEDULE_TABLE_SLOTS        (2u)
+#define SCAN_SCHEDULE_TABLE_NUM_GROUPS   (2u)
+/* firstWidgetId, numWidgets, firstSlotId, numSlots */
+#define SCAN_SCHEDULE_TABLE_GROUPS \
+{ \
+    {0u, 1u, 0u, 1u}, /* Button0 */ \
+    {1u, 1u, 1u, 1u}, /* Button1 */ \
+}
+#elif defined(TARGET_APP_KIT_PSOC4_HVMS_64K_LITE_02) || defined(TARGET_KIT_PSOC4_HVMS_64K_LITE_02)
+/* templates/TARGET_KIT_PSOC4-HVMS-64K_LITE-02/config/design.cycapsense */
+#define SCAN_SCHEDULE_TABLE_WIDGETS      (2u)
+#define SCAN_SCHEDULE_TABLE_SLOTS        (2u)
+#define SCAN_SCHEDULE_TABLE_NUM_GROUPS   (2u)
+/* firstWidgetId, numWidgets, firstSlotId, numSlots */
+#define SCAN_SCHEDULE_TABLE_GROUPS \
+{ \
+    {0u, 1u, 0u, 1u}, /* Button0 */ \
+    {1u, 1u, 1u, 1u}, /* Button1 */ \
+}
+#elif defined(TARGET_APP_KIT_PSOC4_HVMS_64K_LITE) || defined(TARGET_KIT_PSOC4_HVMS_64K_LITE)
+/* templates/TARGET_KIT_PSOC4-HVMS-64K_LITE/config/design.cycapsense */
+#define SCAN_SCHEDULE_TABLE_WIDGETS      (2u)
+#define SCAN_SCHEDULE_TABLE_SLOTS        (2u)
+#define SCAN_SCHEDULE_TABLE_NUM_GROUPS   (2u)
+/* firstWidgetId, numWidgets, firstSlotId, numSlots */
+#define SCAN_SCHEDULE_TABLE_GROUPS \
+{ \
+    {0u, 1u, 0u, 1u}, /* Button0 */ \
+    {1u, 1u, 1u, 1u}, /* Button1 */ \
+}
+#endif
+
+#endif /* SCAN_SCHEDULE_TABLE_H */
+
+/* [] END OF FILE */
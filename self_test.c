@@ -0,0 +1,418 @@
+/******************************************************************************
+ * File Name: self_test.c
+ *
+ * Description: Incremental CAPSENSE built-in self-test. One step checks one
+ * sensor or electrode. The steps that use the MSC block run while the
+ * end-of-scan callback leaves the block idle; the baseline check only reads
+ * RAM and runs between the processing passes of the main loop. Step and pass
+ * durations are taken from the WDT counter.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "cy_pdl.h"
+#include "cycfg_capsense.h"
+#include "wdt_timer.h"
+#include "self_test.h"
+
+#if (0u != SELF_TEST_ENABLE)
+
+#if (0u == CY_CAPSENSE_BIST_EN)
+#error "SELF_TEST_ENABLE requires the self-test library enabled in the CAPSENSE configuration"
+#endif
+
+#if ((0u == SELF_TEST_CHECK_SHORTS) && (0u == SELF_TEST_CHECK_CAPACITANCE) && (0u == SELF_TEST_CHECK_BASELINE))
+#error "SELF_TEST_ENABLE requires at least one enabled check"
+#endif
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+#define SELF_TEST_WDT_MASK               (0xFFFFu)
+
+/* Budget of one frame, in us x widgets */
+#define SELF_TEST_CREDIT_MAX             ((int32_t)(SELF_TEST_FRAME_BUDGET_US * CY_CAPSENSE_WIDGET_COUNT))
+
+/*******************************************************************************
+ * Global Definitions
+ *******************************************************************************/
+static cy_stc_capsense_context_t * self_test_context = NULL;
+static self_test_stats_t self_test_stats;
+static uint8_t self_test_failed[(CY_CAPSENSE_WIDGET_COUNT + 7u) / 8u];
+
+static const bool self_test_check_enabled[SELF_TEST_CHECK_COUNT] =
+{
+    (0u != SELF_TEST_CHECK_SHORTS),
+    (0u != SELF_TEST_CHECK_CAPACITANCE),
+    (0u != SELF_TEST_CHECK_BASELINE),
+};
+
+/* Next step, the check is read by the end-of-scan interrupt */
+static volatile uint32_t self_test_check;
+static uint32_t self_test_widget;
+static uint32_t self_test_index;
+
+/* Self-test time available, in us x widgets, negative after an overrun */
+static volatile int32_t self_test_credit;
+
+/* Pass in progress, in WDT ticks */
+static uint32_t self_test_last_run;
+static uint32_t self_test_elapsed;
+
+/*******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+static bool self_test_uses_msc(uint32_t check);
+static uint32_t self_test_first_check(uint32_t check);
+static bool self_test_advance(void);
+static cy_en_capsense_bist_status_t self_test_step(void);
+static void self_test_fail(cy_en_capsense_bist_status_t status);
+
+/*******************************************************************************
+ * Function Name: self_test_init
+ ********************************************************************************
+ * Summary:
+ *  Clears the results and starts the first pass with no budget. Call after
+ *  the CAPSENSE is enabled.
+ *
+ * Return:
+ *  void
+ *
+ * Parameters:
+ *  context - CAPSENSE context
+ *******************************************************************************/
+void self_test_init(cy_stc_capsense_context_t * context)
+{
+    uint32_t idx;
+
+    self_test_context = context;
+    self_test_stats.passes = 0u;
+    self_test_stats.coverageMs = 0u;
+    self_test_stats.maxCoverageMs = 0u;
+    self_test_stats.steps = 0u;
+    self_test_stats.deferred = 0u;
+    self_test_stats.failures = 0u;
+    for (idx = 0u; idx < sizeof(self_test_failed); idx++)
+    {
+        self_test_failed[idx] = 0u;
+    }
+
+    self_test_check = self_test_first_check(0u);
+    self_test_widget = 0u;
+    self_test_index = 0u;
+    self_test_credit = 0;
+    self_test_last_run = Cy_WDT_GetCount();
+    self_test_elapsed = 0u;
+}
+
+/*******************************************************************************
+ * Function Name: self_test_processed
+ ********************************************************************************
+ * Summary:
+ *  Adds the self-test budget of processed widgets. The unused budget is kept
+ *  for at most one frame.
+ *
+ * Return:
+ *  void
+ *
+ * Parameters:
+ *  widgets - number of processed widgets
+ *******************************************************************************/
+void self_test_processed(uint32_t widgets)
+{
+    int32_t credit = self_test_credit + (int32_t)(widgets * SELF_TEST_FRAME_BUDGET_US);
+
+    self_test_credit = (credit < SELF_TEST_CREDIT_MAX) ? credit : SELF_TEST_CREDIT_MAX;
+}
+
+/*******************************************************************************
+ * Function Name: self_test_msc_requested
+ ********************************************************************************
+ * Summary:
+ *  Tells whether the next step needs the MSC block and has the budget to run.
+ *  Called from the end-of-scan callback, which then leaves the block idle
+ *  until the main loop has run the step and restarts the scan.
+ *
+ * Return:
+ *  bool - true to leave the MSC block idle after this scan
+ *
+ * Parameters:
+ *  void
+ *******************************************************************************/
+bool self_test_msc_requested(void)
+{
+    return (self_test_credit > 0) && self_test_uses_msc(self_test_check);
+}
+
+/*******************************************************************************
+ * Function Name: self_test_run
+ ********************************************************************************
+ * Summary:
+ *  Runs steps until the budget is used up, the next step needs the MSC block
+ *  while a scan is in flight, or the pass is complete. The time taken is
+ *  charged to the budget with a resolution of one WDT tick. Call once per
+ *  main loop pass, at least once per WDT counter period.
+ *
+ * Return:
+ *  void
+ *
+ * Parameters:
+ *  mscIdle - true if no scan is in flight and none starts before the return
+ *******************************************************************************/
+void self_test_run(bool mscIdle)
+{
+    cy_en_capsense_bist_status_t status;
+    uint32_t start = Cy_WDT_GetCount();
+    uint32_t ticks = 0u;
+    bool passDone = false;
+
+    self_test_elapsed += (start - self_test_last_run) & SELF_TEST_WDT_MASK;
+
+    while (!passDone && ((int32_t)(wdt_timer_ticks_to_us(ticks) * CY_CAPSENSE_WIDGET_COUNT) < self_test_credit))
+    {
+        if (!mscIdle && self_test_uses_msc(self_test_check))
+        {
+            break;
+        }
+
+        status = self_test_step();
+        if (CY_CAPSENSE_BIST_HW_BUSY_E == status)
+        {
+            self_test_stats.deferred++;
+            break;
+        }
+        if (CY_CAPSENSE_BIST_SUCCESS_E != status)
+        {
+            self_test_fail(status);
+        }
+        self_test_stats.steps++;
+        passDone = self_test_advance();
+        ticks = (Cy_WDT_GetCount() - start) & SELF_TEST_WDT_MASK;
+    }
+
+    self_test_credit -= (int32_t)(wdt_timer_ticks_to_us(ticks) * CY_CAPSENSE_WIDGET_COUNT);
+    self_test_elapsed += ticks;
+    self_test_last_run = (start + ticks) & SELF_TEST_WDT_MASK;
+
+    if (passDone)
+    {
+        self_test_stats.passes++;
+        self_test_stats.coverageMs = wdt_timer_ticks_to_us(self_test_elapsed) / 1000u;
+        if (self_test_stats.coverageMs > self_test_stats.maxCoverageMs)
+        {
+            self_test_stats.maxCoverageMs = self_test_stats.coverageMs;
+        }
+        self_test_elapsed = 0u;
+    }
+}
+
+/*******************************************************************************
+ * Function Name: self_test_widget_failed
+ ********************************************************************************
+ * Summary:
+ *  Tells whether any check of a widget has failed since the start.
+ *
+ * Return:
+ *  bool - true if a step of the widget has failed
+ *
+ * Parameters:
+ *  widgetId - widget
+ *******************************************************************************/
+bool self_test_widget_failed(uint32_t widgetId)
+{
+    return (widgetId < CY_CAPSENSE_WIDGET_COUNT) &&
+        (0u != (self_test_failed[widgetId >> 3u] & (1u << (widgetId & 7u))));
+}
+
+/*******************************************************************************
+ * Function Name: self_test_get_stats
+ ********************************************************************************
+ * Summary:
+ *  Returns the self-test results.
+ *
+ * Return:
+ *  const self_test_stats_t * - results, coverageMs is 0 until the first pass
+ *  is complete
+ *
+ * Parameters:
+ *  void
+ *******************************************************************************/
+const self_test_stats_t * self_test_get_stats(void)
+{
+    return &self_test_stats;
+}
+
+/*******************************************************************************
+ * Function Name: self_test_uses_msc
+ ********************************************************************************
+ * Summary:
+ *  Tells whether the steps of a check drive the sensor pins or the MSC block.
+ *
+ *******************************************************************************/
+static bool self_test_uses_msc(uint32_t check)
+{
+    return (SELF_TEST_BASELINE != check);
+}
+
+/*******************************************************************************
+ * Function Name: self_test_first_check
+ ********************************************************************************
+ * Summary:
+ *  Returns the first enabled check from the given one, or
+ *  SELF_TEST_CHECK_COUNT if none is left.
+ *
+ *******************************************************************************/
+static uint32_t self_test_first_check(uint32_t check)
+{
+    while ((check < SELF_TEST_CHECK_COUNT) && !self_test_check_enabled[check])
+    {
+        check++;
+    }
+    return check;
+}
+
+/*******************************************************************************
+ * Function Name: self_test_advance
+ ********************************************************************************
+ * Summary:
+ *  Moves to the next sensor or electrode, widget, and check.
+ *
+ * Return:
+ *  bool - true if the pass is complete and the next one has started
+ *
+ *******************************************************************************/
+static bool self_test_advance(void)
+{
+    const cy_stc_capsense_widget_config_t * ptrWdCfg = &self_test_context->ptrWdConfig[self_test_widget];
+    uint32_t items = (SELF_TEST_CAPACITANCE == self_test_check) ?
+        ((uint32_t)ptrWdCfg->numCols + ptrWdCfg->numRows) : ptrWdCfg->numSns;
+    uint32_t check;
+
+    if (++self_test_index < items)
+    {
+        return false;
+    }
+    self_test_index = 0u;
+    if (++self_test_widget < CY_CAPSENSE_WIDGET_COUNT)
+    {
+        return false;
+    }
+    self_test_widget = 0u;
+
+    check = self_test_first_check(self_test_check + 1u);
+    if (check < SELF_TEST_CHECK_COUNT)
+    {
+        self_test_check = check;
+        return false;
+    }
+    self_test_check = self_test_first_check(0u);
+    return true;
+}
+
+/*******************************************************************************
+ * Function Name: self_test_step
+ ********************************************************************************
+ * Summary:
+ *  Runs the check of the current sensor or electrode.
+ *
+ * Return:
+ *  cy_en_capsense_bist_status_t - result of the step
+ *
+ *******************************************************************************/
+static cy_en_capsense_bist_status_t self_test_step(void)
+{
+    const cy_stc_capsense_widget_config_t * ptrWdCfg = &self_test_context->ptrWdConfig[self_test_widget];
+    cy_en_capsense_bist_status_t status;
+    uint32_t capacitance;
+
+    switch (self_test_check)
+    {
+        case SELF_TEST_SHORTS:
+            status = Cy_CapSense_CheckIntegritySensorPins(self_test_widget, self_test_index, self_test_context);
+            break;
+
+        case SELF_TEST_CAPACITANCE:
+            status = Cy_CapSense_MeasureCapacitanceSensorElectrode(self_test_widget, self_test_index,
+                                                                   self_test_context);
+            if (CY_CAPSENSE_BIST_SUCCESS_E == status)
+            {
+                capacitance = ptrWdCfg->ptrEltdCapacitance[self_test_index];
+                if (capacitance < SELF_TEST_CAP_MIN_FF)
+                {
+                    status = CY_CAPSENSE_BIST_LOW_LIMIT_E;
+                }
+                else if (capacitance > SELF_TEST_CAP_MAX_FF)
+                {
+                    status = CY_CAPSENSE_BIST_HIGH_LIMIT_E;
+                }
+                else
+                {
+                    /* Within the limits */
+                }
+            }
+            break;
+
+        default:
+            status = Cy_CapSense_CheckIntegritySensorBaseline(self_test_widget, self_test_index,
+                                                              ptrWdCfg->ptrWdContext->maxRawCount,
+                                                              SELF_TEST_BASELINE_LOW_LIMIT, self_test_context);
+            break;
+    }
+    return status;
+}
+
+/*******************************************************************************
+ * Function Name: self_test_fail
+ ********************************************************************************
+ * Summary:
+ *  Records a failed step.
+ *
+ *******************************************************************************/
+static void self_test_fail(cy_en_capsense_bist_status_t status)
+{
+    self_test_stats.failures++;
+    self_test_stats.lastFault.check = (uint8_t)self_test_check;
+    self_test_stats.lastFault.widgetId = (uint8_t)self_test_widget;
+    self_test_stats.lastFault.index = (uint16_t)self_test_index;
+    self_test_stats.lastFault.status = (uint32_t)status;
+    self_test_failed[self_test_widget >> 3u] |= (uint8_t)(1u << (self_test_widget & 7u));
+}
+
+#endif /* SELF_TEST_ENABLE */
+
+/* [] END OF FILE */
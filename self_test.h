@@ -0,0 +1,161 @@
+/******************************************************************************
+ * File Name: self_test.h
+ *
+ * Description: Incremental CAPSENSE built-in self-test. The sensor shorts,
+ * electrode capacitance and baseline integrity checks of the middleware are
+ * split into one step per sensor or electrode and run between the scans of
+ * the pipeline, within a time budget per frame. Compiled out unless
+ * SELF_TEST_ENABLE is set.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+
+#ifndef SELF_TEST_H
+#define SELF_TEST_H
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include "cycfg_capsense.h"
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+/* 1 = run the self-test steps between the scans, 0 = no self-test. Requires
+ * the self-test library (BIST) enabled in the CAPSENSE configuration.
+ */
+#ifndef SELF_TEST_ENABLE
+#define SELF_TEST_ENABLE                 (0u)
+#endif
+
+/* Self-test time per frame in us. A frame is one processing of every widget;
+ * each processed widget adds its share of the budget. A step that overruns
+ * the budget is paid back from the following frames.
+ */
+#ifndef SELF_TEST_FRAME_BUDGET_US
+#define SELF_TEST_FRAME_BUDGET_US        (50u)
+#endif
+
+/* Checks of a pass, 1 = enabled. The short and capacitance checks use the
+ * sensor pins and the MSC block and only run while no scan is in flight.
+ */
+#ifndef SELF_TEST_CHECK_SHORTS
+#define SELF_TEST_CHECK_SHORTS           (1u)
+#endif
+
+#ifndef SELF_TEST_CHECK_CAPACITANCE
+#define SELF_TEST_CHECK_CAPACITANCE      (1u)
+#endif
+
+#ifndef SELF_TEST_CHECK_BASELINE
+#define SELF_TEST_CHECK_BASELINE         (1u)
+#endif
+
+/* Electrode capacitance limits in fF */
+#ifndef SELF_TEST_CAP_MIN_FF
+#define SELF_TEST_CAP_MIN_FF             (1000u)
+#endif
+
+#ifndef SELF_TEST_CAP_MAX_FF
+#define SELF_TEST_CAP_MAX_FF             (100000u)
+#endif
+
+/* Lowest valid baseline. The highest is the maximum raw count of the widget. */
+#ifndef SELF_TEST_BASELINE_LOW_LIMIT
+#define SELF_TEST_BASELINE_LOW_LIMIT     (1u)
+#endif
+
+/* Instrumentation of the application. SELF_TEST_PROCESSED() adds the budget
+ * of the processed widgets, SELF_TEST_MSC_REQUESTED() tells the end-of-scan
+ * callback to leave the MSC block idle for a step, and SELF_TEST_RUN() runs
+ * the steps the budget allows.
+ */
+#if (0u != SELF_TEST_ENABLE)
+#define SELF_TEST_PROCESSED(widgets)     self_test_processed(widgets)
+#define SELF_TEST_MSC_REQUESTED()        self_test_msc_requested()
+#define SELF_TEST_RUN(mscIdle)           self_test_run(mscIdle)
+#else
+#define SELF_TEST_PROCESSED(widgets)     ((void)(widgets))
+#define SELF_TEST_MSC_REQUESTED()        (false)
+#define SELF_TEST_RUN(mscIdle)           ((void)(mscIdle))
+#endif /* SELF_TEST_ENABLE */
+
+/*******************************************************************************
+ * Types
+ *******************************************************************************/
+typedef enum
+{
+    SELF_TEST_SHORTS,
+    SELF_TEST_CAPACITANCE,
+    SELF_TEST_BASELINE,
+    SELF_TEST_CHECK_COUNT
+} self_test_check_t;
+
+/* A failed step */
+typedef struct
+{
+    uint8_t check;                   /* self_test_check_t */
+    uint8_t widgetId;
+    uint16_t index;                  /* sensor, or electrode for the capacitance check */
+    uint32_t status;                 /* cy_en_capsense_bist_status_t */
+} self_test_fault_t;
+
+typedef struct
+{
+    uint32_t passes;                 /* complete passes over all checks */
+    uint32_t coverageMs;             /* duration of the last complete pass, ms */
+    uint32_t maxCoverageMs;          /* longest complete pass, ms */
+    uint32_t steps;                  /* steps run */
+    uint32_t deferred;               /* steps retried because a scan was in flight */
+    uint32_t failures;               /* failed steps */
+    self_test_fault_t lastFault;     /* valid if failures is not 0 */
+} self_test_stats_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+void self_test_init(cy_stc_capsense_context_t * context);
+void self_test_processed(uint32_t widgets);
+bool self_test_msc_requested(void);
+void self_test_run(bool mscIdle);
+bool self_test_widget_failed(uint32_t widgetId);
+const self_test_stats_t * self_test_get_stats(void);
+
+#endif /* SELF_TEST_H */
+
+/* [] END OF FILE */
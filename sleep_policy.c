@@ -0,0 +1,324 @@
+/******************************************************************************
+ * File Name: sleep_policy.c
+ *
+ * Description: Sleep mode selection. Each scan is timed with the WDT counter,
+ * which also runs in Deep Sleep, and the measured duration is split over the
+ * widgets of the batch by slot count. The per-widget averages predict the
+ * duration of the next scan of a batch, and the remaining time of the scan in
+ * flight selects the cheapest wait for the end-of-scan interrupt.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "wdt_timer.h"
+#include "sleep_policy.h"
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+#define SLEEP_POLICY_WDT_MASK            (0xFFFFu)
+
+/* Scan durations are averaged in 1/16 us, with a weight of 1/8 per scan */
+#define SLEEP_POLICY_FRACTION_SHIFT      (4u)
+#define SLEEP_POLICY_AVERAGE_SHIFT       (3u)
+
+/*******************************************************************************
+ * Global Definitions
+ *******************************************************************************/
+/* Average scan duration of each widget in 1/16 us, 0 until first measured */
+static uint32_t sleep_policy_widget_time[CY_CAPSENSE_WIDGET_COUNT];
+
+static const cy_stc_capsense_context_t * sleep_policy_context = NULL;
+static uint32_t sleep_policy_frame_us = 0u;
+static sleep_policy_stats_t sleep_policy_stats;
+
+/* Scan in flight, written by the end-of-scan interrupt */
+static const scan_group_t * volatile sleep_policy_group = NULL;
+static volatile uint32_t sleep_policy_scan_start = 0u;
+static volatile uint32_t sleep_policy_predicted_us = 0u;
+
+/*******************************************************************************
+ * Function Name: sleep_policy_init
+ ********************************************************************************
+ * Summary:
+ *  Clears the scan duration averages. Until a widget is measured, the scans
+ *  that contain it wait in CPU Sleep.
+ *
+ * Return:
+ *  void
+ *
+ * Parameters:
+ *  context - CAPSENSE context
+ *******************************************************************************/
+void sleep_policy_init(const cy_stc_capsense_context_t * context)
+{
+    uint32_t wdId;
+
+    for (wdId = 0u; wdId < CY_CAPSENSE_WIDGET_COUNT; wdId++)
+    {
+        sleep_policy_widget_time[wdId] = 0u;
+    }
+    sleep_policy_context = context;
+    sleep_policy_frame_us = (0u != PIPELINE_MIN_FRAME_RATE_HZ) ? (1000000u / PIPELINE_MIN_FRAME_RATE_HZ) : 0u;
+    sleep_policy_group = NULL;
+}
+
+/*******************************************************************************
+ * Function Name: sleep_policy_scan_started
+ ********************************************************************************
+ * Summary:
+ *  Records the start of a scan and predicts its duration from the averages of
+ *  its widgets. Call right before Cy_CapSense_ScanSlots(), from the
+ *  end-of-scan interrupt or with interrupts disabled.
+ *
+ * Return:
+ *  void
+ *
+ * Parameters:
+ *  group - batch to be scanned
+ *******************************************************************************/
+void sleep_policy_scan_started(const scan_group_t * group)
+{
+    uint32_t predicted = 0u;
+    uint32_t wdId;
+
+    for (wdId = group->firstWidgetId; wdId < (uint32_t)(group->firstWidgetId + group->numWidgets); wdId++)
+    {
+        if (0u == sleep_policy_widget_time[wdId])
+        {
+            predicted = 0u;
+            break;
+        }
+        predicted += sleep_policy_widget_time[wdId];
+    }
+
+    sleep_policy_predicted_us = predicted >> SLEEP_POLICY_FRACTION_SHIFT;
+    sleep_policy_scan_start = Cy_WDT_GetCount();
+    sleep_policy_group = group;
+}
+
+/*******************************************************************************
+ * Function Name: sleep_policy_scan_done
+ ********************************************************************************
+ * Summary:
+ *  Measures the scan that has completed and updates the averages of its
+ *  widgets. The WDT counter has the resolution of one ILO cycle; the error
+ *  averages out over many scans. Call from the end-of-scan interrupt.
+ *
+ * Return:
+ *  void
+ *
+ * Parameters:
+ *  void
+ *******************************************************************************/
+void sleep_policy_scan_done(void)
+{
+    const scan_group_t * group = sleep_policy_group;
+    const cy_stc_capsense_widget_config_t * ptrWdCfg;
+    uint32_t elapsed;
+    uint32_t share;
+    uint32_t wdId;
+
+    if ((NULL == group) || (0u == group->numSlots))
+    {
+        return;
+    }
+    sleep_policy_group = NULL;
+
+    elapsed = (Cy_WDT_GetCount() - sleep_policy_scan_start) & SLEEP_POLICY_WDT_MASK;
+    elapsed = wdt_timer_ticks_to_us(elapsed) << SLEEP_POLICY_FRACTION_SHIFT;
+
+    ptrWdCfg = sleep_policy_context->ptrWdConfig;
+    for (wdId = group->firstWidgetId; wdId < (uint32_t)(group->firstWidgetId + group->numWidgets); wdId++)
+    {
+        /* At least 1/16 us, so that a measured widget is never 0 */
+        share = ((elapsed * ptrWdCfg[wdId].numSlots) / group->numSlots) | 1u;
+        if (0u == sleep_policy_widget_time[wdId])
+        {
+            sleep_policy_widget_time[wdId] = share;
+        }
+        else
+        {
+            sleep_policy_widget_time[wdId] = (uint32_t)((int32_t)sleep_policy_widget_time[wdId] +
+                (((int32_t)share - (int32_t)sleep_policy_widget_time[wdId]) >> SLEEP_POLICY_AVERAGE_SHIFT));
+        }
+    }
+}
+
+/*******************************************************************************
+ * Function Name: sleep_policy_remaining_us
+ ********************************************************************************
+ * Summary:
+ *  Predicts the time until the end of the scan in flight.
+ *
+ * Return:
+ *  uint32_t - remaining time in microseconds. UINT32_MAX if no scan is in
+ *  flight: the next wake-up comes from the WDT or the tuner interface.
+ *  PIPELINE_SLEEP_MIN_US if the duration of the scan is not known yet.
+ *
+ * Parameters:
+ *  void
+ *******************************************************************************/
+uint32_t sleep_policy_remaining_us(void)
+{
+    uint32_t elapsed;
+
+    if (NULL == sleep_policy_group)
+    {
+        return UINT32_MAX;
+    }
+    if (0u == sleep_policy_predicted_us)
+    {
+        return PIPELINE_SLEEP_MIN_US;
+    }
+    elapsed = wdt_timer_ticks_to_us((Cy_WDT_GetCount() - sleep_policy_scan_start) & SLEEP_POLICY_WDT_MASK);
+    return (elapsed < sleep_policy_predicted_us) ? (sleep_policy_predicted_us - elapsed) : 0u;
+}
+
+/*******************************************************************************
+ * Function Name: sleep_policy_widget_scan_us
+ ********************************************************************************
+ * Summary:
+ *  Returns the average scan time of a widget, including its share of the
+ *  scan setup of its batch.
+ *
+ * Return:
+ *  uint32_t - scan time in microseconds, rounded up, 0 until first measured
+ *
+ * Parameters:
+ *  widgetId - widget index
+ *******************************************************************************/
+uint32_t sleep_policy_widget_scan_us(uint32_t widgetId)
+{
+    uint32_t fraction = (1u << SLEEP_POLICY_FRACTION_SHIFT) - 1u;
+
+    return (sleep_policy_widget_time[widgetId] + fraction) >> SLEEP_POLICY_FRACTION_SHIFT;
+}
+
+/*******************************************************************************
+ * Function Name: sleep_policy_select
+ ********************************************************************************
+ * Summary:
+ *  Selects how the main loop waits for the next event:
+ *  - continues, when the scan ends before a CPU Sleep would pay off
+ *  - CPU Sleep, when the high-frequency clock is needed, the scan ends before
+ *    PIPELINE_DEEPSLEEP_MIN_US, or the Deep Sleep wake-up would break the
+ *    PIPELINE_MIN_FRAME_RATE_HZ frame rate
+ *  - Deep Sleep otherwise
+ *  Call with interrupts disabled, right before the sleep mode is entered.
+ *
+ * Return:
+ *  sleep_policy_mode_t - selected mode
+ *
+ * Parameters:
+ *  hfClkNeeded - a peripheral needs the high-frequency clock
+ *******************************************************************************/
+sleep_policy_mode_t sleep_policy_select(bool hfClkNeeded)
+{
+    const scan_group_t * group = sleep_policy_group;
+    sleep_policy_mode_t mode = SLEEP_POLICY_DEEPSLEEP;
+    uint32_t remaining;
+    uint32_t budget;
+
+#if (0u != PIPELINE_SLEEP_POLICY)
+    remaining = sleep_policy_remaining_us();
+    if (remaining < PIPELINE_SLEEP_MIN_US)
+    {
+        mode = SLEEP_POLICY_BUSY;
+    }
+    else if (hfClkNeeded || (remaining < PIPELINE_DEEPSLEEP_MIN_US))
+    {
+        mode = SLEEP_POLICY_SLEEP;
+    }
+    else if ((NULL != group) && (0u != sleep_policy_frame_us))
+    {
+        /* Share of the frame period of this batch */
+        budget = (sleep_policy_frame_us * group->numSlots) / CY_CAPSENSE_SLOT_COUNT;
+        if ((sleep_policy_predicted_us + PIPELINE_DEEPSLEEP_WAKEUP_US) > budget)
+        {
+            sleep_policy_stats.frameLimited++;
+            mode = SLEEP_POLICY_SLEEP;
+        }
+    }
+    else
+    {
+        /* Deep Sleep */
+    }
+#else
+    (void)group;
+    (void)remaining;
+    (void)budget;
+    if (hfClkNeeded)
+    {
+        mode = SLEEP_POLICY_SLEEP;
+    }
+#endif /* PIPELINE_SLEEP_POLICY */
+
+    switch (mode)
+    {
+        case SLEEP_POLICY_BUSY:
+            sleep_policy_stats.busy++;
+            break;
+        case SLEEP_POLICY_SLEEP:
+            sleep_policy_stats.sleep++;
+            break;
+        default:
+            sleep_policy_stats.deepSleep++;
+            break;
+    }
+    return mode;
+}
+
+/*******************************************************************************
+ * Function Name: sleep_policy_get_stats
+ ********************************************************************************
+ * Summary:
+ *  Returns the number of selections of each mode.
+ *
+ * Return:
+ *  const sleep_policy_stats_t * - statistics
+ *
+ * Parameters:
+ *  void
+ *******************************************************************************/
+const sleep_policy_stats_t * sleep_policy_get_stats(void)
+{
+    return &sleep_policy_stats;
+}
+
+/* [] END OF FILE */
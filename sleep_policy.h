@@ -0,0 +1,124 @@
+/******************************************************************************
+ * File Name: sleep_policy.h
+ *
+ * Description: Sleep mode selection. Predicts the remaining time of the scan
+ * in flight from measured per-widget scan durations and selects whether the
+ * main loop continues, enters CPU Sleep or enters Deep Sleep.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+
+#ifndef SLEEP_POLICY_H
+#define SLEEP_POLICY_H
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "cy_pdl.h"
+#include "cycfg_capsense.h"
+#include "scan_schedule.h"
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+/* 1 = select the sleep mode from the predicted remaining scan time,
+ * 0 = always enter Deep Sleep unless the high-frequency clock is needed
+ */
+#ifndef PIPELINE_SLEEP_POLICY
+#define PIPELINE_SLEEP_POLICY            (1u)
+#endif
+
+/* Remaining scan time below which the main loop continues without sleeping */
+#ifndef PIPELINE_SLEEP_MIN_US
+#define PIPELINE_SLEEP_MIN_US            (10u)
+#endif
+
+/* Remaining scan time from which Deep Sleep costs less energy than CPU Sleep.
+ * The Deep Sleep entry, the wake-up and the clock restore of
+ * Cy_SysClk_DeepSleepCallback() run at active current, so the saving of a
+ * shorter Deep Sleep does not pay for them.
+ */
+#ifndef PIPELINE_DEEPSLEEP_MIN_US
+#define PIPELINE_DEEPSLEEP_MIN_US        (100u)
+#endif
+
+/* Deep Sleep exit time. The end-of-scan interrupt, and so the start of the
+ * next scan, is delayed by this time when the scan ends in Deep Sleep.
+ */
+#ifndef PIPELINE_DEEPSLEEP_WAKEUP_US
+#define PIPELINE_DEEPSLEEP_WAKEUP_US     (35u)
+#endif
+
+/* Guaranteed frame rate. Deep Sleep is not entered during a scan if the
+ * wake-up delay would stretch the scan beyond its share of the frame period.
+ * 0 = no frame rate requirement.
+ */
+#ifndef PIPELINE_MIN_FRAME_RATE_HZ
+#define PIPELINE_MIN_FRAME_RATE_HZ       (0u)
+#endif
+
+/*******************************************************************************
+ * Data types
+ *******************************************************************************/
+typedef enum
+{
+    SLEEP_POLICY_BUSY,               /* continue the main loop */
+    SLEEP_POLICY_SLEEP,              /* CPU Sleep */
+    SLEEP_POLICY_DEEPSLEEP           /* Deep Sleep */
+} sleep_policy_mode_t;
+
+typedef struct
+{
+    uint32_t busy;                   /* selections of each mode */
+    uint32_t sleep;
+    uint32_t deepSleep;
+    uint32_t frameLimited;           /* Deep Sleep refused for the frame rate */
+} sleep_policy_stats_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+void sleep_policy_init(const cy_stc_capsense_context_t * context);
+void sleep_policy_scan_started(const scan_group_t * group);
+void sleep_policy_scan_done(void);
+uint32_t sleep_policy_remaining_us(void);
+uint32_t sleep_policy_widget_scan_us(uint32_t widgetId);
+sleep_policy_mode_t sleep_policy_select(bool hfClkNeeded);
+const sleep_policy_stats_t * sleep_policy_get_stats(void);
+
+#endif /* SLEEP_POLICY_H */
+
+/* [] END OF FILE */
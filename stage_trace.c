@@ -0,0 +1,335 @@
+/******************************************************************************
+ * File Name: stage_trace.c
+ *
+ * Description: Per-stage cycle-count instrumentation of the scan and process
+ * pipeline. Stage durations are measured with SysTick in CPU cycles; Deep
+ * Sleep durations are measured with the WDT counter and converted to CPU
+ * cycles with the ILO compensation of wdt_timer.c.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include <string.h>
+#include "cy_pdl.h"
+#include "cycfg_capsense.h"
+#include "wdt_timer.h"
+#include "stage_trace.h"
+
+#if (0u != STAGE_TRACE_ENABLE)
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+/* SysTick is a 24-bit down counter; stages must be shorter than one period */
+#define STAGE_TRACE_SYSTICK_MASK         (0x00FFFFFFu)
+#define STAGE_TRACE_WDT_MASK             (0xFFFFu)
+#define STAGE_TRACE_HISTOGRAM_MAX        (0xFFFFu)
+
+/*******************************************************************************
+ * Global Definitions
+ *******************************************************************************/
+static stage_trace_stats_t stage_trace_stats[STAGE_TRACE_NUM_RECORDS];
+static stage_trace_event_t stage_trace_ring[STAGE_TRACE_RING_SIZE];
+static uint32_t stage_trace_ring_pos = 0u;
+static uint32_t stage_trace_ring_count = 0u;
+static uint32_t stage_trace_cycles_per_us = 0u;
+
+/*******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+static void stage_trace_add(stage_trace_stats_t * stats, uint32_t cycles);
+
+/*******************************************************************************
+ * Function Name: stage_trace_init
+ ********************************************************************************
+ * Summary:
+ *  Clears the statistics and starts SysTick as a free-running cycle counter
+ *  without interrupt. Call after the system clocks are configured.
+ *
+ * Return:
+ *  void
+ *
+ * Parameters:
+ *  void
+ *******************************************************************************/
+void stage_trace_init(void)
+{
+    uint32_t i;
+
+    memset(stage_trace_stats, 0, sizeof(stage_trace_stats));
+    for (i = 0u; i < STAGE_TRACE_NUM_RECORDS; i++)
+    {
+        stage_trace_stats[i].min = UINT32_MAX;
+    }
+    stage_trace_ring_pos = 0u;
+    stage_trace_ring_count = 0u;
+    stage_trace_cycles_per_us = Cy_SysClk_ClkSysGetFrequency() / 1000000u;
+
+    Cy_SysTick_Init(CY_SYSTICK_CLOCK_SOURCE_CLK_CPU, STAGE_TRACE_SYSTICK_MASK);
+    Cy_SysTick_DisableInterrupt();
+}
+
+/*******************************************************************************
+ * Function Name: stage_trace_now
+ ********************************************************************************
+ * Summary:
+ *  Returns the SysTick counter, the start time of a stage.
+ *
+ * Return:
+ *  uint32_t - SysTick counter value
+ *
+ * Parameters:
+ *  void
+ *******************************************************************************/
+uint32_t stage_trace_now(void)
+{
+    return Cy_SysTick_GetValue();
+}
+
+/*******************************************************************************
+ * Function Name: stage_trace_end
+ ********************************************************************************
+ * Summary:
+ *  Records the time from start to now as the duration of a stage. The time
+ *  includes the interrupts that preempted the stage.
+ *
+ * Return:
+ *  void
+ *
+ * Parameters:
+ *  stage - pipeline stage
+ *  id - widget or batch id, 0 for stages without id
+ *  start - value returned by stage_trace_now() at the start of the stage
+ *******************************************************************************/
+void stage_trace_end(stage_trace_stage_t stage, uint32_t id, uint32_t start)
+{
+    /* SysTick counts down */
+    stage_trace_record(stage, id, (start - Cy_SysTick_GetValue()) & STAGE_TRACE_SYSTICK_MASK);
+}
+
+/*******************************************************************************
+ * Function Name: stage_trace_deepsleep_now
+ ********************************************************************************
+ * Summary:
+ *  Returns the WDT counter, the start time of Deep Sleep.
+ *
+ * Return:
+ *  uint32_t - WDT counter value
+ *
+ * Parameters:
+ *  void
+ *******************************************************************************/
+uint32_t stage_trace_deepsleep_now(void)
+{
+    return Cy_WDT_GetCount();
+}
+
+/*******************************************************************************
+ * Function Name: stage_trace_deepsleep_end
+ ********************************************************************************
+ * Summary:
+ *  Records the Deep Sleep duration. The resolution is one ILO cycle.
+ *
+ * Return:
+ *  void
+ *
+ * Parameters:
+ *  start - value returned by stage_trace_deepsleep_now() before Deep Sleep
+ *******************************************************************************/
+void stage_trace_deepsleep_end(uint32_t start)
+{
+    uint32_t ticks = (Cy_WDT_GetCount() - start) & STAGE_TRACE_WDT_MASK;
+
+    stage_trace_record(STAGE_TRACE_DEEPSLEEP, 0u, wdt_timer_ticks_to_us(ticks) * stage_trace_cycles_per_us);
+}
+
+/*******************************************************************************
+ * Function Name: stage_trace_record
+ ********************************************************************************
+ * Summary:
+ *  Adds a duration to the statistics of the stage, and of the widget for the
+ *  processing stage, and to the trace ring. Can be called from interrupts.
+ *
+ * Return:
+ *  void
+ *
+ * Parameters:
+ *  stage - pipeline stage
+ *  id - widget or batch id
+ *  cycles - duration in CPU cycles
+ *******************************************************************************/
+void stage_trace_record(stage_trace_stage_t stage, uint32_t id, uint32_t cycles)
+{
+    uint32_t interruptState;
+    stage_trace_event_t * event;
+
+    interruptState = Cy_SysLib_EnterCriticalSection();
+
+    stage_trace_add(&stage_trace_stats[stage], cycles);
+    if ((STAGE_TRACE_PROCESS == stage) && (id < CY_CAPSENSE_WIDGET_COUNT))
+    {
+        stage_trace_add(&stage_trace_stats[STAGE_TRACE_STAGE_COUNT + id], cycles);
+    }
+
+    event = &stage_trace_ring[stage_trace_ring_pos];
+    event->stage = (uint8_t)stage;
+    event->id = (uint8_t)id;
+    event->reserved = 0u;
+    event->cycles = cycles;
+    stage_trace_ring_pos = (stage_trace_ring_pos + 1u) % STAGE_TRACE_RING_SIZE;
+    if (stage_trace_ring_count < STAGE_TRACE_RING_SIZE)
+    {
+        stage_trace_ring_count++;
+    }
+
+    Cy_SysLib_ExitCriticalSection(interruptState);
+}
+
+/*******************************************************************************
+ * Function Name: stage_trace_read
+ ********************************************************************************
+ * Summary:
+ *  Copies a statistics record. The copy is consistent even if the record is
+ *  updated by an interrupt.
+ *
+ * Return:
+ *  void
+ *
+ * Parameters:
+ *  index - record, stages first, then widgets
+ *  stats - destination
+ *******************************************************************************/
+void stage_trace_read(uint32_t index, stage_trace_stats_t * stats)
+{
+    uint32_t interruptState;
+
+    if (index < STAGE_TRACE_NUM_RECORDS)
+    {
+        interruptState = Cy_SysLib_EnterCriticalSection();
+        *stats = stage_trace_stats[index];
+        Cy_SysLib_ExitCriticalSection(interruptState);
+    }
+}
+
+/*******************************************************************************
+ * Function Name: stage_trace_read_ring
+ ********************************************************************************
+ * Summary:
+ *  Copies the most recent measurements, oldest first.
+ *
+ * Return:
+ *  uint32_t - number of events copied
+ *
+ * Parameters:
+ *  events - destination
+ *  maxEvents - size of the destination in events
+ *******************************************************************************/
+uint32_t stage_trace_read_ring(stage_trace_event_t * events, uint32_t maxEvents)
+{
+    uint32_t interruptState;
+    uint32_t count;
+    uint32_t pos;
+    uint32_t i;
+
+    interruptState = Cy_SysLib_EnterCriticalSection();
+    count = (stage_trace_ring_count < maxEvents) ? stage_trace_ring_count : maxEvents;
+    pos = (stage_trace_ring_pos + STAGE_TRACE_RING_SIZE - count) % STAGE_TRACE_RING_SIZE;
+    for (i = 0u; i < count; i++)
+    {
+        events[i] = stage_trace_ring[pos];
+        pos = (pos + 1u) % STAGE_TRACE_RING_SIZE;
+    }
+    Cy_SysLib_ExitCriticalSection(interruptState);
+
+    return count;
+}
+
+/*******************************************************************************
+ * Function Name: stage_trace_clock_hz
+ ********************************************************************************
+ * Summary:
+ *  Returns the CPU clock frequency that the durations are counted in.
+ *
+ * Return:
+ *  uint32_t - frequency in Hz
+ *
+ * Parameters:
+ *  void
+ *******************************************************************************/
+uint32_t stage_trace_clock_hz(void)
+{
+    return stage_trace_cycles_per_us * 1000000u;
+}
+
+/*******************************************************************************
+ * Function Name: stage_trace_add
+ ********************************************************************************
+ * Summary:
+ *  Adds a duration to a statistics record.
+ *
+ *******************************************************************************/
+static void stage_trace_add(stage_trace_stats_t * stats, uint32_t cycles)
+{
+    uint32_t bin = 0u;
+    uint32_t value = cycles >> STAGE_TRACE_HISTOGRAM_SHIFT;
+
+    while ((0u != value) && (bin < (STAGE_TRACE_HISTOGRAM_BINS - 1u)))
+    {
+        value >>= 1u;
+        bin++;
+    }
+    if (stats->histogram[bin] < STAGE_TRACE_HISTOGRAM_MAX)
+    {
+        stats->histogram[bin]++;
+    }
+
+    stats->sum += cycles;
+    stats->count++;
+    if (cycles < stats->min)
+    {
+        stats->min = cycles;
+    }
+    if (cycles > stats->max)
+    {
+        stats->max = cycles;
+    }
+}
+
+#endif /* STAGE_TRACE_ENABLE */
+
+/* [] END OF FILE */
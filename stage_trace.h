@@ -0,0 +1,153 @@
+/******************************************************************************
+ * File Name: stage_trace.h
+ *
+ * Description: Per-stage cycle-count instrumentation of the scan and process
+ * pipeline. Records the duration of each stage of the main loop, and of each
+ * widget's processing, in fixed RAM statistics with a histogram. Compiled out
+ * unless STAGE_TRACE_ENABLE is set.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+
+#ifndef STAGE_TRACE_H
+#define STAGE_TRACE_H
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+/* 1 = measure the pipeline stages, 0 = the measurement is compiled out */
+#ifndef STAGE_TRACE_ENABLE
+#define STAGE_TRACE_ENABLE               (0u)
+#endif
+
+/* Histogram of each statistic: bin 0 counts durations below
+ * 2^STAGE_TRACE_HISTOGRAM_SHIFT CPU cycles, bin n counts durations from
+ * 2^(SHIFT + n - 1) up to 2^(SHIFT + n) cycles. The last bin also counts all
+ * longer durations.
+ */
+#ifndef STAGE_TRACE_HISTOGRAM_BINS
+#define STAGE_TRACE_HISTOGRAM_BINS       (12u)
+#endif
+
+#ifndef STAGE_TRACE_HISTOGRAM_SHIFT
+#define STAGE_TRACE_HISTOGRAM_SHIFT      (8u)
+#endif
+
+/* Number of the most recent measurements kept in the trace ring */
+#ifndef STAGE_TRACE_RING_SIZE
+#define STAGE_TRACE_RING_SIZE            (32u)
+#endif
+
+/* Statistics records: one per stage, then one per widget for its processing */
+#define STAGE_TRACE_NUM_RECORDS          (STAGE_TRACE_STAGE_COUNT + CY_CAPSENSE_WIDGET_COUNT)
+
+/* Instrumentation of the application. STAGE_TRACE_BEGIN() returns the start
+ * time of a stage, STAGE_TRACE_END() records the stage duration for a widget
+ * or batch id. The deep sleep variants use the WDT counter, because SysTick
+ * stops in Deep Sleep.
+ */
+#if (0u != STAGE_TRACE_ENABLE)
+#define STAGE_TRACE_BEGIN()              stage_trace_now()
+#define STAGE_TRACE_END(stage, id, start) stage_trace_end((stage), (id), (start))
+#define STAGE_TRACE_DEEPSLEEP_BEGIN()    stage_trace_deepsleep_now()
+#define STAGE_TRACE_DEEPSLEEP_END(start) stage_trace_deepsleep_end(start)
+#else
+#define STAGE_TRACE_BEGIN()              (0u)
+#define STAGE_TRACE_END(stage, id, start) ((void)(start))
+#define STAGE_TRACE_DEEPSLEEP_BEGIN()    (0u)
+#define STAGE_TRACE_DEEPSLEEP_END(start) ((void)(start))
+#endif /* STAGE_TRACE_ENABLE */
+
+/*******************************************************************************
+ * Types
+ *******************************************************************************/
+/* Pipeline stages */
+typedef enum
+{
+    STAGE_TRACE_SCAN = 0u,          /* Cy_CapSense_ScanSlots(), id = first widget of the batch */
+    STAGE_TRACE_PROCESS,            /* Cy_CapSense_ProcessWidget(), id = widget */
+    STAGE_TRACE_LED,                /* led_output_apply() */
+    STAGE_TRACE_TUNER,              /* Cy_CapSense_RunTuner() */
+    STAGE_TRACE_WDT,                /* wdt_trigger() without the time asleep */
+    STAGE_TRACE_SLEEP,              /* CPU Sleep, wake-up included */
+    STAGE_TRACE_DEEPSLEEP,          /* Deep Sleep, wake-up included */
+    STAGE_TRACE_WAKE,               /* low-power wake scan start to touch detection */
+    STAGE_TRACE_STAGE_COUNT
+} stage_trace_stage_t;
+
+/* Statistics of one stage or widget, durations in CPU cycles. The layout is
+ * also the wire format of the trace telemetry frame.
+ */
+typedef struct
+{
+    uint64_t sum;
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint16_t histogram[STAGE_TRACE_HISTOGRAM_BINS];
+} stage_trace_stats_t;
+
+/* Entry of the trace ring */
+typedef struct
+{
+    uint8_t stage;
+    uint8_t id;
+    uint16_t reserved;
+    uint32_t cycles;
+} stage_trace_event_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+void stage_trace_init(void);
+uint32_t stage_trace_now(void);
+void stage_trace_end(stage_trace_stage_t stage, uint32_t id, uint32_t start);
+uint32_t stage_trace_deepsleep_now(void);
+void stage_trace_deepsleep_end(uint32_t start);
+void stage_trace_record(stage_trace_stage_t stage, uint32_t id, uint32_t cycles);
+void stage_trace_read(uint32_t index, stage_trace_stats_t * stats);
+uint32_t stage_trace_read_ring(stage_trace_event_t * events, uint32_t maxEvents);
+uint32_t stage_trace_clock_hz(void);
+
+#endif /* STAGE_TRACE_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,262 @@
+/******************************************************************************
+ * File Name: touch_event.c
+ *
+ * Description: Touch events for the application. Compares the state of each
+ * processed widget with its previous state and queues press, release and hold
+ * events. The queue has one producer, the main loop, and one consumer, which
+ * may also run in an interrupt, so it needs no critical sections.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "wdt_timer.h"
+#include "touch_event.h"
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+#define TOUCH_EVENT_WDT_MASK             (0xFFFFu)
+
+/* State of a widget */
+#define TOUCH_EVENT_IDLE                 (0u)
+#define TOUCH_EVENT_PRESSED              (1u)
+#define TOUCH_EVENT_HELD                 (2u)
+
+/*******************************************************************************
+ * Global Definitions
+ *******************************************************************************/
+static touch_event_t touch_event_buf[TOUCH_EVENT_QUEUE_SIZE];
+static volatile uint32_t touch_event_head = 0u;
+static volatile uint32_t touch_event_tail = 0u;
+static volatile uint32_t touch_event_overflow_count = 0u;
+
+static uint8_t touch_event_state[CY_CAPSENSE_WIDGET_COUNT];
+static uint32_t touch_event_press_ms[CY_CAPSENSE_WIDGET_COUNT];
+
+/* Pass clock, advanced from the WDT counter */
+static uint32_t touch_event_wdt_count = 0u;
+static uint32_t touch_event_time_us = 0u;
+static uint32_t touch_event_time_ms = 0u;
+static uint16_t touch_event_pass = 0u;
+
+/*******************************************************************************
+ * Function Name: touch_event_init
+ ********************************************************************************
+ * Summary:
+ *  Empties the queue, marks all widgets inactive and starts the pass clock.
+ *  Call after the WDT timekeeping is initialized.
+ *
+ * Return:
+ *  void
+ *
+ * Parameters:
+ *  void
+ *******************************************************************************/
+void touch_event_init(void)
+{
+    uint32_t wdId;
+
+    touch_event_head = 0u;
+    touch_event_tail = 0u;
+    touch_event_overflow_count = 0u;
+    for (wdId = 0u; wdId < CY_CAPSENSE_WIDGET_COUNT; wdId++)
+    {
+        touch_event_state[wdId] = TOUCH_EVENT_IDLE;
+    }
+
+    touch_event_wdt_count = Cy_WDT_GetCount();
+    touch_event_time_us = 0u;
+    touch_event_time_ms = 0u;
+    touch_event_pass = 0u;
+}
+
+/*******************************************************************************
+ * Function Name: touch_event_pass_start
+ ********************************************************************************
+ * Summary:
+ *  Advances the pass clock and counter. Called once per main loop pass, before the
+ *  scanned batches are processed; the events of the pass carry its time. The
+ *  16-bit WDT counter wraps around once per longest WDT interrupt interval,
+ *  and every WDT interrupt leads to a pass, so no wrap is missed.
+ *
+ * Return:
+ *  void
+ *
+ * Parameters:
+ *  void
+ *******************************************************************************/
+void touch_event_pass_start(void)
+{
+    uint32_t count = Cy_WDT_GetCount();
+
+    touch_event_time_us += wdt_timer_ticks_to_us((count - touch_event_wdt_count) & TOUCH_EVENT_WDT_MASK);
+    touch_event_wdt_count = count;
+
+    /* Carry whole milliseconds, keep the rest for the next pass */
+    touch_event_time_ms += touch_event_time_us / 1000u;
+    touch_event_time_us %= 1000u;
+    touch_event_pass++;
+}
+
+/*******************************************************************************
+ * Function Name: touch_event_push
+ ********************************************************************************
+ * Summary:
+ *  Appends an event. The event is dropped and counted if the queue is full.
+ *
+ * Return:
+ *  void
+ *
+ * Parameters:
+ *  widgetId - widget of the event
+ *  type - touch_event_type_t
+ *******************************************************************************/
+static void touch_event_push(uint32_t widgetId, touch_event_type_t type)
+{
+    uint32_t head = touch_event_head;
+    uint32_t next = (head < (TOUCH_EVENT_QUEUE_SIZE - 1u)) ? (head + 1u) : 0u;
+
+    if (next == touch_event_tail)
+    {
+        touch_event_overflow_count++;
+        return;
+    }
+    touch_event_buf[head].timeMs = touch_event_time_ms;
+    touch_event_buf[head].pass = touch_event_pass;
+    touch_event_buf[head].widgetId = (uint8_t)widgetId;
+    touch_event_buf[head].type = (uint8_t)type;
+
+    /* The entry is complete before the consumer can see it */
+    __COMPILER_BARRIER();
+    touch_event_head = next;
+}
+
+/*******************************************************************************
+ * Function Name: touch_event_update
+ ********************************************************************************
+ * Summary:
+ *  Queues the events of a processed widget: press when it becomes active,
+ *  hold once when it has been active for TOUCH_EVENT_HOLD_MS, and release
+ *  when it becomes inactive.
+ *
+ * Return:
+ *  void
+ *
+ * Parameters:
+ *  widgetId - processed widget
+ *  active - result of Cy_CapSense_IsWidgetActive()
+ *******************************************************************************/
+void touch_event_update(uint32_t widgetId, bool active)
+{
+    uint8_t state = touch_event_state[widgetId];
+
+    if (!active)
+    {
+        if (TOUCH_EVENT_IDLE != state)
+        {
+            touch_event_state[widgetId] = TOUCH_EVENT_IDLE;
+            touch_event_push(widgetId, TOUCH_EVENT_RELEASE);
+        }
+    }
+    else if (TOUCH_EVENT_IDLE == state)
+    {
+        touch_event_state[widgetId] = TOUCH_EVENT_PRESSED;
+        touch_event_press_ms[widgetId] = touch_event_time_ms;
+        touch_event_push(widgetId, TOUCH_EVENT_PRESS);
+    }
+    else if ((0u != TOUCH_EVENT_HOLD_MS) && (TOUCH_EVENT_PRESSED == state) &&
+             ((touch_event_time_ms - touch_event_press_ms[widgetId]) >= TOUCH_EVENT_HOLD_MS))
+    {
+        touch_event_state[widgetId] = TOUCH_EVENT_HELD;
+        touch_event_push(widgetId, TOUCH_EVENT_HOLD);
+    }
+    else
+    {
+        /* No change */
+    }
+}
+
+/*******************************************************************************
+ * Function Name: touch_event_pop
+ ********************************************************************************
+ * Summary:
+ *  Removes the oldest event. Consumer side, called by the application.
+ *
+ * Return:
+ *  bool - false if the queue is empty
+ *
+ * Parameters:
+ *  event - receives the event
+ *******************************************************************************/
+bool touch_event_pop(touch_event_t * event)
+{
+    uint32_t tail = touch_event_tail;
+
+    if (tail == touch_event_head)
+    {
+        return false;
+    }
+    __COMPILER_BARRIER();
+    *event = touch_event_buf[tail];
+
+    /* The entry is read before the producer can reuse it */
+    __COMPILER_BARRIER();
+    touch_event_tail = (tail < (TOUCH_EVENT_QUEUE_SIZE - 1u)) ? (tail + 1u) : 0u;
+    return true;
+}
+
+/*******************************************************************************
+ * Function Name: touch_event_overflows
+ ********************************************************************************
+ * Summary:
+ *  Returns the number of events dropped because the queue was full. After an
+ *  increase, the application can resynchronize with
+ *  Cy_CapSense_IsWidgetActive(), since a release may have been dropped.
+ *
+ * Return:
+ *  uint32_t - dropped events
+ *
+ * Parameters:
+ *  void
+ *******************************************************************************/
+uint32_t touch_event_overflows(void)
+{
+    return touch_event_overflow_count;
+}
+
+/* [] END OF FILE */
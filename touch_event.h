@@ -0,0 +1,109 @@
+/******************************************************************************
+ * File Name: touch_event.h
+ *
+ * Description: Touch events for the application. The pipeline reports the
+ * state of each processed widget; press, release and hold events are queued
+ * with the widget ID and the frame time, and the application reads them at
+ * its own rate.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+
+#ifndef TOUCH_EVENT_H
+#define TOUCH_EVENT_H
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "cy_pdl.h"
+#include "cycfg_capsense.h"
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+/* Queue entries. One entry stays free to tell a full queue from an empty
+ * one. When the queue is full, new events are dropped and counted.
+ */
+#ifndef TOUCH_EVENT_QUEUE_SIZE
+#define TOUCH_EVENT_QUEUE_SIZE           (16u)
+#endif
+
+/* Time a widget must stay active before its hold event. 0 = no hold
+ * events.
+ */
+#ifndef TOUCH_EVENT_HOLD_MS
+#define TOUCH_EVENT_HOLD_MS              (500u)
+#endif
+
+/* 1 = process_touch_events() in main.c drains the queue once per main loop
+ * pass and sets the LEDs from the events; it is a placeholder for the
+ * consumer of the application. 0 = the application pops the events at its
+ * own rate, and the LEDs follow the widget status.
+ */
+#ifndef TOUCH_EVENT_EXAMPLE_CONSUMER
+#define TOUCH_EVENT_EXAMPLE_CONSUMER     (1u)
+#endif
+
+/*******************************************************************************
+ * Data types
+ *******************************************************************************/
+typedef enum
+{
+    TOUCH_EVENT_PRESS = 0u,          /* widget became active */
+    TOUCH_EVENT_RELEASE,             /* widget became inactive */
+    TOUCH_EVENT_HOLD,                /* widget active for TOUCH_EVENT_HOLD_MS */
+} touch_event_type_t;
+
+typedef struct
+{
+    uint32_t timeMs;                 /* time of the main loop pass, from touch_event_init() */
+    uint16_t pass;                   /* main loop pass counter, wraps around */
+    uint8_t widgetId;
+    uint8_t type;                    /* touch_event_type_t */
+} touch_event_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+void touch_event_init(void);
+void touch_event_pass_start(void);
+void touch_event_update(uint32_t widgetId, bool active);
+bool touch_event_pop(touch_event_t * event);
+uint32_t touch_event_overflows(void);
+
+#endif /* TOUCH_EVENT_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,204 @@
+/******************************************************************************
+ * File Name: tuner_rx.c
+ *
+ * Description: Streaming receiver of CAPSENSE Tuner command packets over UART.
+ * The last CY_CAPSENSE_COMMAND_PACKET_SIZE received bytes are kept in a
+ * mirrored ring: every byte is stored twice, one window apart, so the window
+ * always reads as a contiguous packet and never has to be shifted. A new byte
+ * costs a constant number of operations: the header and tail are compared in
+ * place, and the CRC is checked only when both match. When the check fails,
+ * the window simply slides by one byte on the next byte received, as with the
+ * previous shift-based resynchronisation.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include <string.h>
+#include "tuner_rx.h"
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+#define TUNER_RX_WINDOW                  (CY_CAPSENSE_COMMAND_PACKET_SIZE)
+
+/* Bytes moved from the UART ring buffer per Cy_SCB_UART_Receive() call */
+#define TUNER_RX_CHUNK_SIZE              (CY_CAPSENSE_COMMAND_PACKET_SIZE)
+
+/*******************************************************************************
+ * Global Definitions
+ *******************************************************************************/
+/* Mirrored ring: byte i of the stream is at [i % WINDOW] and [i % WINDOW + WINDOW] */
+static uint8_t tuner_rx_ring[2u * TUNER_RX_WINDOW];
+/* Ring position of the next byte, which is also the start of the window */
+static uint32_t tuner_rx_pos = 0u;
+/* Bytes in the window since the last packet */
+static uint32_t tuner_rx_fill = 0u;
+
+/* Bytes read from the UART and not yet framed */
+static uint8_t tuner_rx_chunk[TUNER_RX_CHUNK_SIZE];
+static uint32_t tuner_rx_chunk_pos = 0u;
+static uint32_t tuner_rx_chunk_len = 0u;
+
+/* Last packet found, stays valid until the next packet is found */
+static uint8_t tuner_rx_packet[CY_CAPSENSE_COMMAND_PACKET_SIZE];
+
+static CySCB_Type * tuner_rx_base = NULL;
+static cy_stc_scb_uart_context_t * tuner_rx_context = NULL;
+
+/*******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+static bool tuner_rx_push(uint8_t byte);
+
+/*******************************************************************************
+ * Function Name: tuner_rx_init
+ ********************************************************************************
+ * Summary:
+ *  Resets the receiver. Call after the UART ring buffer is started.
+ *
+ * Return:
+ *  void
+ *
+ * Parameters:
+ *  base - SCB block of the tuner UART
+ *  context - UART context
+ *******************************************************************************/
+void tuner_rx_init(CySCB_Type * base, cy_stc_scb_uart_context_t * context)
+{
+    tuner_rx_base = base;
+    tuner_rx_context = context;
+    tuner_rx_pos = 0u;
+    tuner_rx_fill = 0u;
+    tuner_rx_chunk_pos = 0u;
+    tuner_rx_chunk_len = 0u;
+}
+
+/*******************************************************************************
+ * Function Name: tuner_rx_poll
+ ********************************************************************************
+ * Summary:
+ *  Frames the bytes received since the last call. Stops at the first valid
+ *  command packet; the bytes after it are framed on the next call.
+ *
+ * Return:
+ *  uint8_t * - command packet, NULL if no complete packet was received
+ *
+ * Parameters:
+ *  void
+ *******************************************************************************/
+uint8_t * tuner_rx_poll(void)
+{
+    uint32_t numBytes;
+
+    for (;;)
+    {
+        while (tuner_rx_chunk_pos < tuner_rx_chunk_len)
+        {
+            if (tuner_rx_push(tuner_rx_chunk[tuner_rx_chunk_pos++]))
+            {
+                return &tuner_rx_packet[0u];
+            }
+        }
+
+        numBytes = Cy_SCB_UART_GetNumInRingBuffer(tuner_rx_base, tuner_rx_context);
+        if (0u == numBytes)
+        {
+            return NULL;
+        }
+        if (numBytes > TUNER_RX_CHUNK_SIZE)
+        {
+            numBytes = TUNER_RX_CHUNK_SIZE;
+        }
+        (void)Cy_SCB_UART_Receive(tuner_rx_base, &tuner_rx_chunk[0u], numBytes, tuner_rx_context);
+        tuner_rx_chunk_pos = 0u;
+        tuner_rx_chunk_len = numBytes;
+    }
+}
+
+/*******************************************************************************
+ * Function Name: tuner_rx_push
+ ********************************************************************************
+ * Summary:
+ *  Adds one byte to the window and checks whether the window holds a valid
+ *  command packet.
+ *
+ * Return:
+ *  bool - true if a packet was found and copied to tuner_rx_packet
+ *
+ * Parameters:
+ *  byte - received byte
+ *******************************************************************************/
+static bool tuner_rx_push(uint8_t byte)
+{
+    const uint8_t * window;
+
+    tuner_rx_ring[tuner_rx_pos] = byte;
+    tuner_rx_ring[tuner_rx_pos + TUNER_RX_WINDOW] = byte;
+    tuner_rx_pos = (tuner_rx_pos < (TUNER_RX_WINDOW - 1u)) ? (tuner_rx_pos + 1u) : 0u;
+
+    if (tuner_rx_fill < TUNER_RX_WINDOW)
+    {
+        tuner_rx_fill++;
+        if (tuner_rx_fill < TUNER_RX_WINDOW)
+        {
+            return false;
+        }
+    }
+
+    /* The oldest byte is at the write position */
+    window = &tuner_rx_ring[tuner_rx_pos];
+    if ((CY_CAPSENSE_COMMAND_HEAD_0 != window[CY_CAPSENSE_COMMAND_HEAD_0_IDX]) ||
+        (CY_CAPSENSE_COMMAND_HEAD_1 != window[CY_CAPSENSE_COMMAND_HEAD_1_IDX]) ||
+        (CY_CAPSENSE_COMMAND_TAIL_0 != window[CY_CAPSENSE_COMMAND_TAIL_0_IDX]) ||
+        (CY_CAPSENSE_COMMAND_TAIL_1 != window[CY_CAPSENSE_COMMAND_TAIL_1_IDX]) ||
+        (CY_CAPSENSE_COMMAND_TAIL_2 != window[CY_CAPSENSE_COMMAND_TAIL_2_IDX]))
+    {
+        return false;
+    }
+    if (CY_CAPSENSE_COMMAND_OK != Cy_CapSense_CheckTunerCmdIntegrity(window))
+    {
+        return false;
+    }
+
+    /* The packet is framed; the next packet starts with the next byte */
+    memcpy(tuner_rx_packet, window, CY_CAPSENSE_COMMAND_PACKET_SIZE);
+    tuner_rx_fill = 0u;
+    return true;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,327 @@
+/******************************************************************************
+ * File Name: tuner_snapshot.c
+ *
+ * Description: Published copy of the tuner data. The frame is kept twice and
+ * guarded by a sequence counter: a reader that interrupts the publication
+ * reads the copy that is not being written, so it never stalls. The EZI2C
+ * host reads copy 0, which is only rewritten between I2C transactions; copy 1
+ * stays as published and shows the bytes the host has written, which are
+ * merged back into the live data.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include <string.h>
+#include "tuner_snapshot.h"
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+#define TUNER_SNAPSHOT_SIZE              (sizeof(cy_stc_capsense_tuner_t))
+
+/*******************************************************************************
+ * Global Definitions
+ *******************************************************************************/
+static cy_stc_capsense_tuner_t tuner_snapshot_buf[2u];
+
+/* Incremented before and after copy 0 is written. While odd, readers use
+ * copy 1; while even, copy 0.
+ */
+static volatile uint32_t tuner_snapshot_seq = 0u;
+
+static CySCB_Type * tuner_snapshot_ezi2c_base = NULL;
+static cy_stc_scb_ezi2c_context_t * tuner_snapshot_ezi2c_context = NULL;
+static IRQn_Type tuner_snapshot_ezi2c_irq;
+static bool tuner_snapshot_host_wrote = false;
+static bool tuner_snapshot_deferred = false;
+static tuner_snapshot_stats_t tuner_snapshot_stats;
+
+/*******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+static void tuner_snapshot_merge(void);
+
+/*******************************************************************************
+ * Function Name: tuner_snapshot_init
+ ********************************************************************************
+ * Summary:
+ *  Publishes the first frame. Call after the CAPSENSE initialization and
+ *  before the first Cy_CapSense_RunTuner().
+ *
+ * Return:
+ *  void
+ *
+ * Parameters:
+ *  void
+ *******************************************************************************/
+void tuner_snapshot_init(void)
+{
+    tuner_snapshot_seq = 0u;
+    tuner_snapshot_publish();
+}
+
+/*******************************************************************************
+ * Function Name: tuner_snapshot_attach_ezi2c
+ ********************************************************************************
+ * Summary:
+ *  Exposes copy 0 as the EZI2C primary buffer. The whole frame is writable
+ *  by the host, as the live tuner data was.
+ *
+ * Return:
+ *  void
+ *
+ * Parameters:
+ *  base - EZI2C SCB block
+ *  context - EZI2C context
+ *  irq - EZI2C interrupt, masked while copy 0 is rewritten
+ *******************************************************************************/
+void tuner_snapshot_attach_ezi2c(CySCB_Type * base, cy_stc_scb_ezi2c_context_t * context, IRQn_Type irq)
+{
+    tuner_snapshot_ezi2c_context = context;
+    tuner_snapshot_ezi2c_irq = irq;
+    tuner_snapshot_ezi2c_base = base;
+
+    Cy_SCB_EZI2C_SetBuffer1(base, (uint8_t *)&tuner_snapshot_buf[0u], TUNER_SNAPSHOT_SIZE,
+                            TUNER_SNAPSHOT_SIZE, context);
+}
+
+/*******************************************************************************
+ * Function Name: tuner_snapshot_publish
+ ********************************************************************************
+ * Summary:
+ *  Copies the live tuner data into both copies. Call from the main loop once
+ *  the processed widgets are consistent. While the EZI2C host is in a
+ *  transaction, the publication is deferred to the next call, so the host
+ *  reads one frame from start to end. Host writes are merged into the live
+ *  data first.
+ *
+ * Return:
+ *  void
+ *
+ * Parameters:
+ *  void
+ *******************************************************************************/
+void tuner_snapshot_publish(void)
+{
+    uint32_t activity;
+
+    if (NULL != tuner_snapshot_ezi2c_base)
+    {
+        NVIC_DisableIRQ(tuner_snapshot_ezi2c_irq);
+        activity = Cy_SCB_EZI2C_GetActivity(tuner_snapshot_ezi2c_base, tuner_snapshot_ezi2c_context);
+        if (0u != (activity & CY_SCB_EZI2C_STATUS_WRITE1))
+        {
+            tuner_snapshot_host_wrote = true;
+        }
+        if (0u != (activity & CY_SCB_EZI2C_STATUS_BUSY))
+        {
+            tuner_snapshot_stats.deferred++;
+            tuner_snapshot_deferred = true;
+            NVIC_EnableIRQ(tuner_snapshot_ezi2c_irq);
+            return;
+        }
+        if (tuner_snapshot_host_wrote)
+        {
+            tuner_snapshot_merge();
+        }
+    }
+
+    /* Readers use copy 1 while copy 0 is written, then copy 0 while copy 1
+     * is brought up to date
+     */
+    tuner_snapshot_seq++;
+    __COMPILER_BARRIER();
+    memcpy(&tuner_snapshot_buf[0u], &cy_capsense_tuner, TUNER_SNAPSHOT_SIZE);
+    __COMPILER_BARRIER();
+    tuner_snapshot_seq++;
+    __COMPILER_BARRIER();
+    memcpy(&tuner_snapshot_buf[1u], &tuner_snapshot_buf[0u], TUNER_SNAPSHOT_SIZE);
+    tuner_snapshot_stats.published++;
+    tuner_snapshot_deferred = false;
+
+    if (NULL != tuner_snapshot_ezi2c_base)
+    {
+        NVIC_EnableIRQ(tuner_snapshot_ezi2c_irq);
+    }
+}
+
+/*******************************************************************************
+ * Function Name: tuner_snapshot_ezi2c_event
+ ********************************************************************************
+ * Summary:
+ *  Merges a completed host write into the live data, so that a tuner command
+ *  is seen by Cy_CapSense_RunTuner() without waiting for the next
+ *  publication. Call from the EZI2C interrupt, after
+ *  Cy_SCB_EZI2C_Interrupt().
+ *
+ * Return:
+ *  void
+ *
+ * Parameters:
+ *  void
+ *******************************************************************************/
+void tuner_snapshot_ezi2c_event(void)
+{
+    uint32_t activity;
+
+    if (NULL == tuner_snapshot_ezi2c_base)
+    {
+        return;
+    }
+    activity = Cy_SCB_EZI2C_GetActivity(tuner_snapshot_ezi2c_base, tuner_snapshot_ezi2c_context);
+    if (0u != (activity & CY_SCB_EZI2C_STATUS_WRITE1))
+    {
+        tuner_snapshot_host_wrote = true;
+    }
+    if (tuner_snapshot_host_wrote && (0u == (activity & CY_SCB_EZI2C_STATUS_BUSY)))
+    {
+        tuner_snapshot_merge();
+    }
+}
+
+/*******************************************************************************
+ * Function Name: tuner_snapshot_merge
+ ********************************************************************************
+ * Summary:
+ *  Copies the bytes in which copy 0 differs from copy 1, that is, the bytes
+ *  written by the EZI2C host, into the live data and into copy 1. Called with
+ *  the EZI2C interrupt masked or from it.
+ *
+ *******************************************************************************/
+static void tuner_snapshot_merge(void)
+{
+    const uint8_t * host = (const uint8_t *)&tuner_snapshot_buf[0u];
+    uint8_t * ref = (uint8_t *)&tuner_snapshot_buf[1u];
+    uint8_t * live = (uint8_t *)&cy_capsense_tuner;
+    uint32_t idx;
+
+    for (idx = 0u; idx < TUNER_SNAPSHOT_SIZE; idx++)
+    {
+        if (host[idx] != ref[idx])
+        {
+            live[idx] = host[idx];
+            ref[idx] = host[idx];
+        }
+    }
+    tuner_snapshot_host_wrote = false;
+    tuner_snapshot_stats.hostWrites++;
+}
+
+/*******************************************************************************
+ * Function Name: tuner_snapshot_frame
+ ********************************************************************************
+ * Summary:
+ *  Returns the published frame. For readers in the main loop, which does not
+ *  publish while they read it.
+ *
+ * Return:
+ *  const cy_stc_capsense_tuner_t * - published frame
+ *
+ * Parameters:
+ *  void
+ *******************************************************************************/
+const cy_stc_capsense_tuner_t * tuner_snapshot_frame(void)
+{
+    return &tuner_snapshot_buf[tuner_snapshot_seq & 1u];
+}
+
+/*******************************************************************************
+ * Function Name: tuner_snapshot_read
+ ********************************************************************************
+ * Summary:
+ *  Copies the published frame. Can be called from interrupts: a reader that
+ *  interrupts the publication reads the other copy, and a copy that changes
+ *  during the read is read again.
+ *
+ * Return:
+ *  uint32_t - number of the frame, incremented by each publication
+ *
+ * Parameters:
+ *  frame - destination
+ *******************************************************************************/
+uint32_t tuner_snapshot_read(cy_stc_capsense_tuner_t * frame)
+{
+    uint32_t seq;
+
+    do
+    {
+        seq = tuner_snapshot_seq;
+        __COMPILER_BARRIER();
+        memcpy(frame, &tuner_snapshot_buf[seq & 1u], TUNER_SNAPSHOT_SIZE);
+        __COMPILER_BARRIER();
+    } while (seq != tuner_snapshot_seq);
+
+    return seq >> 1u;
+}
+
+/*******************************************************************************
+ * Function Name: tuner_snapshot_get_stats
+ ********************************************************************************
+ * Summary:
+ *  Returns the publication counters.
+ *
+ * Return:
+ *  const tuner_snapshot_stats_t * - statistics
+ *
+ * Parameters:
+ *  void
+ *******************************************************************************/
+const tuner_snapshot_stats_t * tuner_snapshot_get_stats(void)
+{
+    return &tuner_snapshot_stats;
+}
+
+/*******************************************************************************
+ * Function Name: tuner_snapshot_pending
+ ********************************************************************************
+ * Summary:
+ *  Tells whether the last publication was deferred by an I2C transaction and
+ *  must be retried without waiting for new data.
+ *
+ * Return:
+ *  bool - true while a publication is deferred
+ *
+ * Parameters:
+ *  void
+ *******************************************************************************/
+bool tuner_snapshot_pending(void)
+{
+    return tuner_snapshot_deferred;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,77 @@
+/******************************************************************************
+ * File Name: tuner_snapshot.h
+ *
+ * Description: Published copy of the tuner data. The main loop publishes a
+ * consistent frame after each pipeline pass; the tuner interfaces read the
+ * published frame instead of the live data that the pipeline is updating.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+
+#ifndef TUNER_SNAPSHOT_H
+#define TUNER_SNAPSHOT_H
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "cy_pdl.h"
+#include "cycfg_capsense.h"
+
+/*******************************************************************************
+ * Data types
+ *******************************************************************************/
+typedef struct
+{
+    uint32_t published;              /* frames published */
+    uint32_t deferred;               /* publications deferred by an I2C transaction */
+    uint32_t hostWrites;             /* I2C host writes merged into the live data */
+} tuner_snapshot_stats_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+void tuner_snapshot_init(void);
+void tuner_snapshot_attach_ezi2c(CySCB_Type * base, cy_stc_scb_ezi2c_context_t * context, IRQn_Type irq);
+void tuner_snapshot_publish(void);
+void tuner_snapshot_ezi2c_event(void);
+const cy_stc_capsense_tuner_t * tuner_snapshot_frame(void);
+uint32_t tuner_snapshot_read(cy_stc_capsense_tuner_t * frame);
+const tuner_snapshot_stats_t * tuner_snapshot_get_stats(void);
+bool tuner_snapshot_pending(void);
+
+#endif /* TUNER_SNAPSHOT_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,357 @@
+/******************************************************************************
+ * File Name: tuner_telemetry.c
+ *
+ * Description: Delta-encoded tuner telemetry. The tuner data is split into
+ * records: the common context, one record per widget context and per sensor
+ * context, and an extra record with the rest of the tuner structure. A delta
+ * frame sends the records that differ from the last frame, a keyframe sends
+ * all records. A keyframe is sent every TUNER_TELEMETRY_KEYFRAME_INTERVAL
+ * frames and whenever the delta frame would be larger.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include <stddef.h>
+#include <string.h>
+#include "cycfg_capsense.h"
+#include "tuner_tx.h"
+#include "tuner_snapshot.h"
+#include "tuner_telemetry.h"
+#include "raw_trace.h"
+#include "wdt_timer.h"
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+#define TELEMETRY_COMMON_SIZE            (offsetof(cy_stc_capsense_tuner_t, widgetContext))
+#define TELEMETRY_WIDGET_SIZE            (sizeof(cy_stc_capsense_widget_context_t))
+#define TELEMETRY_SENSOR_SIZE            (sizeof(cy_stc_capsense_sensor_context_t))
+#define TELEMETRY_EXTRA_OFFSET           (offsetof(cy_stc_capsense_tuner_t, sensorContext) + \
+                                          (CY_CAPSENSE_SENSOR_COUNT * TELEMETRY_SENSOR_SIZE))
+#define TELEMETRY_EXTRA_SIZE             (sizeof(cy_stc_capsense_tuner_t) - TELEMETRY_EXTRA_OFFSET)
+#define TELEMETRY_NUM_RECORDS            (1u + CY_CAPSENSE_WIDGET_COUNT + CY_CAPSENSE_SENSOR_COUNT + \
+                                          ((0u != TELEMETRY_EXTRA_SIZE) ? 1u : 0u))
+#define TELEMETRY_IMAGE_SIZE             (TELEMETRY_COMMON_SIZE + \
+                                          (CY_CAPSENSE_WIDGET_COUNT * TELEMETRY_WIDGET_SIZE) + \
+                                          (CY_CAPSENSE_SENSOR_COUNT * TELEMETRY_SENSOR_SIZE) + \
+                                          TELEMETRY_EXTRA_SIZE)
+#define TELEMETRY_KEYFRAME_SIZE          (TUNER_TELEMETRY_KEYFRAME_HEADER_SIZE + TELEMETRY_IMAGE_SIZE)
+#define TELEMETRY_MAX(a, b)              (((a) > (b)) ? (a) : (b))
+#define TELEMETRY_PAYLOAD_SIZE           TELEMETRY_MAX(TELEMETRY_MAX(TUNER_TELEMETRY_TRACE_SIZE, \
+                                                                     TUNER_TELEMETRY_RAW_SIZE), \
+                                                       TELEMETRY_KEYFRAME_SIZE)
+
+/*******************************************************************************
+ * Global Definitions
+ *******************************************************************************/
+/* Records as last sent, in record index order */
+static uint8_t telemetry_ref[TELEMETRY_IMAGE_SIZE];
+static uint8_t telemetry_payload[TELEMETRY_PAYLOAD_SIZE];
+static uint32_t telemetry_keyframe_countdown = 0u;
+static uint8_t telemetry_seq = 0u;
+
+#if (0u != STAGE_TRACE_ENABLE)
+static uint32_t telemetry_trace_countdown = TUNER_TELEMETRY_TRACE_INTERVAL;
+static uint32_t telemetry_trace_next = 0u;
+static uint8_t telemetry_trace_seq = 0u;
+#endif /* STAGE_TRACE_ENABLE */
+
+#if (0u != RAW_TRACE_ENABLE)
+static uint8_t telemetry_raw_seq = 0u;
+static uint32_t telemetry_raw_frame = 0u;
+#endif /* RAW_TRACE_ENABLE */
+
+/*******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+static const uint8_t * telemetry_record(const cy_stc_capsense_tuner_t * frame, uint32_t index,
+                                       uint32_t * size);
+static void telemetry_put_u16(uint8_t * dst, uint32_t value);
+#if (0u != STAGE_TRACE_ENABLE) || (0u != RAW_TRACE_ENABLE)
+static void telemetry_put_u32(uint8_t * dst, uint32_t value);
+#endif /* STAGE_TRACE_ENABLE || RAW_TRACE_ENABLE */
+#if (0u != STAGE_TRACE_ENABLE)
+static void telemetry_send_trace(void);
+#endif /* STAGE_TRACE_ENABLE */
+#if (0u != RAW_TRACE_ENABLE)
+static void telemetry_send_raw(void);
+#endif /* RAW_TRACE_ENABLE */
+
+/*******************************************************************************
+ * Function Name: tuner_telemetry_init
+ ********************************************************************************
+ * Summary:
+ *  Restarts the stream. The next frame is a keyframe.
+ *
+ * Return:
+ *  void
+ *
+ * Parameters:
+ *  void
+ *******************************************************************************/
+void tuner_telemetry_init(void)
+{
+    telemetry_keyframe_countdown = 0u;
+    telemetry_seq = 0u;
+}
+
+/*******************************************************************************
+ * Function Name: tuner_telemetry_send
+ ********************************************************************************
+ * Summary:
+ *  Encodes the published tuner data as a delta frame or keyframe and passes
+ *  it to the background transmit. Nothing is encoded while an earlier frame
+ *  waits for the UART: a delta frame must not be replaced before it is sent,
+ *  and the changes are carried by the next frame instead.
+ *
+ * Return:
+ *  void
+ *
+ * Parameters:
+ *  void
+ *******************************************************************************/
+void tuner_telemetry_send(void)
+{
+    bool keyframe = (0u == telemetry_keyframe_countdown);
+    uint32_t pos = TUNER_TELEMETRY_HEADER_SIZE;
+    uint32_t refPos = 0u;
+    uint32_t count = 0u;
+    uint32_t index;
+    uint32_t size;
+    const uint8_t * record;
+    const cy_stc_capsense_tuner_t * frame = tuner_snapshot_frame();
+
+    if (!tuner_tx_can_send())
+    {
+        return;
+    }
+
+#if (0u != RAW_TRACE_ENABLE)
+    /* A frozen raw count buffer is read out before the next tuner frame */
+    if (raw_trace_frozen())
+    {
+        telemetry_send_raw();
+        return;
+    }
+#endif /* RAW_TRACE_ENABLE */
+
+#if (0u != STAGE_TRACE_ENABLE)
+    /* The trace frame takes the place of a tuner frame; the tuner data
+     * changes are carried by the next frame
+     */
+    if (0u == --telemetry_trace_countdown)
+    {
+        telemetry_trace_countdown = TUNER_TELEMETRY_TRACE_INTERVAL;
+        telemetry_send_trace();
+        return;
+    }
+#endif /* STAGE_TRACE_ENABLE */
+
+    if (!keyframe)
+    {
+        for (index = 0u; index < TELEMETRY_NUM_RECORDS; index++)
+        {
+            record = telemetry_record(frame, index, &size);
+            if (0 != memcmp(record, &telemetry_ref[refPos], size))
+            {
+                if ((pos + TUNER_TELEMETRY_INDEX_SIZE + size) > TELEMETRY_KEYFRAME_SIZE)
+                {
+                    /* A keyframe is smaller */
+                    keyframe = true;
+                    break;
+                }
+                telemetry_put_u16(&telemetry_payload[pos], index);
+                pos += TUNER_TELEMETRY_INDEX_SIZE;
+
+                /* The reference is taken from the frame sent */
+                memcpy(&telemetry_payload[pos], record, size);
+                memcpy(&telemetry_ref[refPos], &telemetry_payload[pos], size);
+                pos += size;
+                count++;
+            }
+            refPos += size;
+        }
+    }
+
+    if (keyframe)
+    {
+        telemetry_put_u16(&telemetry_payload[4u], CY_CAPSENSE_WIDGET_COUNT);
+        telemetry_put_u16(&telemetry_payload[6u], CY_CAPSENSE_SENSOR_COUNT);
+        telemetry_put_u16(&telemetry_payload[8u], TELEMETRY_COMMON_SIZE);
+        telemetry_put_u16(&telemetry_payload[10u], TELEMETRY_WIDGET_SIZE);
+        telemetry_put_u16(&telemetry_payload[12u], TELEMETRY_SENSOR_SIZE);
+        telemetry_put_u16(&telemetry_payload[14u], TELEMETRY_EXTRA_SIZE);
+        pos = TUNER_TELEMETRY_KEYFRAME_HEADER_SIZE;
+
+        for (index = 0u; index < TELEMETRY_NUM_RECORDS; index++)
+        {
+            record = telemetry_record(frame, index, &size);
+            memcpy(&telemetry_payload[pos], record, size);
+            pos += size;
+        }
+        memcpy(telemetry_ref, &telemetry_payload[TUNER_TELEMETRY_KEYFRAME_HEADER_SIZE], TELEMETRY_IMAGE_SIZE);
+        count = TELEMETRY_NUM_RECORDS;
+        telemetry_keyframe_countdown = TUNER_TELEMETRY_KEYFRAME_INTERVAL;
+    }
+
+    telemetry_keyframe_countdown--;
+    telemetry_payload[0u] = keyframe ? TUNER_TELEMETRY_KEYFRAME : TUNER_TELEMETRY_DELTA_FRAME;
+    telemetry_payload[1u] = telemetry_seq++;
+    telemetry_put_u16(&telemetry_payload[2u], count);
+
+    tuner_tx_send(telemetry_payload, pos);
+}
+
+/*******************************************************************************
+ * Function Name: telemetry_record
+ ********************************************************************************
+ * Summary:
+ *  Returns the address and size of a record in a frame of the tuner data.
+ *
+ *******************************************************************************/
+static const uint8_t * telemetry_record(const cy_stc_capsense_tuner_t * frame, uint32_t index,
+                                       uint32_t * size)
+{
+    if (0u == index)
+    {
+        *size = TELEMETRY_COMMON_SIZE;
+        return (const uint8_t *)frame;
+    }
+    index--;
+    if (index < CY_CAPSENSE_WIDGET_COUNT)
+    {
+        *size = TELEMETRY_WIDGET_SIZE;
+        return (const uint8_t *)&frame->widgetContext[index];
+    }
+    index -= CY_CAPSENSE_WIDGET_COUNT;
+    if (index < CY_CAPSENSE_SENSOR_COUNT)
+    {
+        *size = TELEMETRY_SENSOR_SIZE;
+        return (const uint8_t *)&frame->sensorContext[index];
+    }
+    *size = TELEMETRY_EXTRA_SIZE;
+    return (const uint8_t *)frame + TELEMETRY_EXTRA_OFFSET;
+}
+
+static void telemetry_put_u16(uint8_t * dst, uint32_t value)
+{
+    dst[0u] = (uint8_t)value;
+    dst[1u] = (uint8_t)(value >> 8u);
+}
+
+#if (0u != STAGE_TRACE_ENABLE)
+/*******************************************************************************
+ * Function Name: telemetry_send_trace
+ ********************************************************************************
+ * Summary:
+ *  Sends the next TUNER_TELEMETRY_TRACE_RECORDS stage statistics records.
+ *
+ *******************************************************************************/
+static void telemetry_send_trace(void)
+{
+    uint32_t pos = TUNER_TELEMETRY_TRACE_HEADER_SIZE;
+    uint32_t first = telemetry_trace_next;
+    uint32_t count = 0u;
+    stage_trace_stats_t stats;
+
+    while ((count < TUNER_TELEMETRY_TRACE_RECORDS) && ((first + count) < STAGE_TRACE_NUM_RECORDS))
+    {
+        stage_trace_read(first + count, &stats);
+        memcpy(&telemetry_payload[pos], &stats, sizeof(stats));
+        pos += sizeof(stats);
+        count++;
+    }
+    telemetry_trace_next = ((first + count) < STAGE_TRACE_NUM_RECORDS) ? (first + count) : 0u;
+
+    telemetry_payload[0u] = TUNER_TELEMETRY_TRACE_FRAME;
+    telemetry_payload[1u] = telemetry_trace_seq++;
+    telemetry_put_u16(&telemetry_payload[2u], count);
+    telemetry_payload[4u] = (uint8_t)first;
+    telemetry_payload[5u] = (uint8_t)STAGE_TRACE_NUM_RECORDS;
+    telemetry_put_u16(&telemetry_payload[6u], sizeof(stage_trace_stats_t));
+    telemetry_payload[8u] = (uint8_t)STAGE_TRACE_STAGE_COUNT;
+    telemetry_payload[9u] = (uint8_t)STAGE_TRACE_HISTOGRAM_BINS;
+    telemetry_payload[10u] = (uint8_t)STAGE_TRACE_HISTOGRAM_SHIFT;
+    telemetry_payload[11u] = 0u;
+    telemetry_put_u32(&telemetry_payload[12u], stage_trace_clock_hz());
+
+    tuner_tx_send(telemetry_payload, pos);
+}
+#endif /* STAGE_TRACE_ENABLE */
+
+#if (0u != RAW_TRACE_ENABLE)
+/*******************************************************************************
+ * Function Name: telemetry_send_raw
+ ********************************************************************************
+ * Summary:
+ *  Sends the next records of the frozen raw count buffer.
+ *
+ *******************************************************************************/
+static void telemetry_send_raw(void)
+{
+    uint32_t dump = raw_trace_dump_number();
+    uint32_t records;
+    uint32_t size;
+
+    size = raw_trace_read(&telemetry_payload[TUNER_TELEMETRY_RAW_HEADER_SIZE], TUNER_TELEMETRY_RAW_BYTES,
+                          &records);
+
+    telemetry_payload[0u] = TUNER_TELEMETRY_RAW_FRAME;
+    telemetry_payload[1u] = telemetry_raw_seq++;
+    telemetry_put_u16(&telemetry_payload[2u], records);
+    telemetry_put_u16(&telemetry_payload[4u], dump);
+    telemetry_payload[6u] = raw_trace_frozen() ? 0u : TUNER_TELEMETRY_RAW_LAST;
+    telemetry_payload[7u] = 0u;
+    telemetry_put_u32(&telemetry_payload[8u], wdt_timer_ticks_to_us(0x10000u));
+    telemetry_put_u16(&telemetry_payload[12u], size);
+    telemetry_put_u16(&telemetry_payload[14u], telemetry_raw_frame);
+    telemetry_raw_frame = raw_trace_frozen() ? (telemetry_raw_frame + 1u) : 0u;
+
+    tuner_tx_send(telemetry_payload, TUNER_TELEMETRY_RAW_HEADER_SIZE + size);
+}
+#endif /* RAW_TRACE_ENABLE */
+
+#if (0u != STAGE_TRACE_ENABLE) || (0u != RAW_TRACE_ENABLE)
+static void telemetry_put_u32(uint8_t * dst, uint32_t value)
+{
+    telemetry_put_u16(&dst[0u], value);
+    telemetry_put_u16(&dst[2u], value >> 16u);
+}
+#endif /* STAGE_TRACE_ENABLE || RAW_TRACE_ENABLE */
+
+/* [] END OF FILE */
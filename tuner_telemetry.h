@@ -0,0 +1,155 @@
+/******************************************************************************
+ * File Name: tuner_telemetry.h
+ *
+ * Description: Delta-encoded tuner telemetry. An alternative to the full tuner
+ * frames of the UART tuner interface: each frame carries only the widget and
+ * sensor records that changed since the previous frame, with periodic
+ * keyframes that carry all records. The wire format below is shared with the
+ * host decoder in host_tools.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+
+#ifndef TUNER_TELEMETRY_H
+#define TUNER_TELEMETRY_H
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include "stage_trace.h"
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+/* Tuner UART stream: 0 = full tuner frames for the CAPSENSE Tuner,
+ * 1 = delta-encoded telemetry for the host decoder
+ */
+#ifndef TUNER_TELEMETRY_DELTA
+#define TUNER_TELEMETRY_DELTA            (0u)
+#endif
+
+/* Number of frames from one keyframe to the next */
+#ifndef TUNER_TELEMETRY_KEYFRAME_INTERVAL
+#define TUNER_TELEMETRY_KEYFRAME_INTERVAL (32u)
+#endif
+
+/* With STAGE_TRACE_ENABLE, one frame in TUNER_TELEMETRY_TRACE_INTERVAL
+ * carries up to TUNER_TELEMETRY_TRACE_RECORDS stage statistics records
+ * instead of the tuner data. The records are sent in turn.
+ */
+#ifndef TUNER_TELEMETRY_TRACE_INTERVAL
+#define TUNER_TELEMETRY_TRACE_INTERVAL   (16u)
+#endif
+
+#ifndef TUNER_TELEMETRY_TRACE_RECORDS
+#define TUNER_TELEMETRY_TRACE_RECORDS    (4u)
+#endif
+
+/* With RAW_TRACE_ENABLE, a frozen raw count buffer is sent in raw trace
+ * frames of up to TUNER_TELEMETRY_RAW_BYTES record bytes, in place of the
+ * tuner frames until the buffer is empty
+ */
+#ifndef TUNER_TELEMETRY_RAW_BYTES
+#define TUNER_TELEMETRY_RAW_BYTES        (256u)
+#endif
+
+/* Wire format. Every frame is framed like a tuner frame: 0x0D 0x0A, payload,
+ * 0x00 0xFF 0xFF. Multi-byte fields are little-endian.
+ *
+ * Payload header, both frame types:
+ *   [0] frame type, [1] sequence number, [2..3] number of records
+ * Keyframe, followed by all records in index order:
+ *   [4..5] widgets, [6..7] sensors, [8..9] common record size,
+ *   [10..11] widget record size, [12..13] sensor record size,
+ *   [14..15] extra record size (0 if there is no extra record)
+ * Delta frame, followed by the changed records, each preceded by its index.
+ *
+ * Record indexes: 0 = common context, 1..widgets = widget contexts, then the
+ * sensor contexts, then the extra record with the rest of the tuner data.
+ * A delta frame applies only to the image of the previous sequence number;
+ * after a lost frame, the decoder waits for the next keyframe.
+ *
+ * Trace frame, followed by the statistics records (stage_trace_stats_t):
+ *   [1] trace sequence number, [2..3] number of records, [4] first record,
+ *   [5] total records, [6..7] record size, [8] stages, [9] histogram bins,
+ *   [10] histogram shift, [11] reserved, [12..15] CPU clock in Hz
+ * Trace frames have their own sequence and do not affect the image.
+ *
+ * Raw trace frame, followed by whole raw count records:
+ *   [1] raw trace sequence number, [2..3] number of records, [4..5] dump
+ *   number, [6] flags, [7] reserved, [8..11] microseconds per 65536 WDT
+ *   ticks, [12..13] record bytes, [14..15] frame number within the dump
+ * The last frame of a dump has TUNER_TELEMETRY_RAW_LAST set in the flags.
+ * Raw count record:
+ *   [0] widget ID, [1] bits 0..6 number of sensors, bit 7 widget active after
+ *   processing, [2..3] WDT counter when the widget was processed, then the raw
+ *   count of each sensor before processing, 16 bits each
+ *
+ * Raw trace file, written by the host decoder and read by the replay: a
+ * header followed by the records of one dump:
+ *   [0..3] "CSRT", [4..7] microseconds per 65536 WDT ticks, [8..11] number
+ *   of records, [12..15] record bytes
+ */
+#define TUNER_TELEMETRY_KEYFRAME         (0x4Bu)
+#define TUNER_TELEMETRY_DELTA_FRAME      (0x44u)
+#define TUNER_TELEMETRY_TRACE_FRAME      (0x53u)
+#define TUNER_TELEMETRY_RAW_FRAME        (0x52u)
+#define TUNER_TELEMETRY_HEADER_SIZE      (4u)
+#define TUNER_TELEMETRY_KEYFRAME_HEADER_SIZE (16u)
+#define TUNER_TELEMETRY_INDEX_SIZE       (2u)
+#define TUNER_TELEMETRY_TRACE_HEADER_SIZE (16u)
+#define TUNER_TELEMETRY_TRACE_SIZE       (TUNER_TELEMETRY_TRACE_HEADER_SIZE + \
+                                          (TUNER_TELEMETRY_TRACE_RECORDS * sizeof(stage_trace_stats_t)))
+#define TUNER_TELEMETRY_RAW_HEADER_SIZE  (16u)
+#define TUNER_TELEMETRY_RAW_SIZE         (TUNER_TELEMETRY_RAW_HEADER_SIZE + TUNER_TELEMETRY_RAW_BYTES)
+#define TUNER_TELEMETRY_RAW_LAST         (0x01u)
+#define TUNER_TELEMETRY_RAW_RECORD_HEADER_SIZE (4u)
+#define TUNER_TELEMETRY_RAW_SNS_MASK     (0x7Fu)
+#define TUNER_TELEMETRY_RAW_ACTIVE_MASK  (0x80u)
+#define TUNER_TELEMETRY_RAW_FILE_MAGIC   "CSRT"
+#define TUNER_TELEMETRY_RAW_FILE_HEADER_SIZE (16u)
+
+/*******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+void tuner_telemetry_init(void);
+void tuner_telemetry_send(void);
+
+#endif /* TUNER_TELEMETRY_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,234 @@
+/******************************************************************************
+ * File Name: tuner_tx.c
+ *
+ * Description: Background transmit of the CAPSENSE Tuner data over UART. A
+ * frame is the UART tuner header, the payload, and the tail. The frame being
+ * sent and the next frame live in separate buffers: the main loop writes the
+ * next frame while the SCB interrupt sends the current one through
+ * Cy_SCB_UART_Transmit(). A new frame replaces a waiting frame that has not
+ * started yet, so the tuner always receives the latest data and the main loop
+ * never waits for the UART.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include <string.h>
+#include "tuner_tx.h"
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+#define TUNER_TX_HEADER_SIZE             (2u)
+#define TUNER_TX_TAIL_SIZE               (3u)
+#define TUNER_TX_FRAME_SIZE              (TUNER_TX_HEADER_SIZE + TUNER_TX_MAX_PAYLOAD + TUNER_TX_TAIL_SIZE)
+#define TUNER_TX_BUFFERS                 (2u)
+
+/*******************************************************************************
+ * Global Definitions
+ *******************************************************************************/
+static const uint8_t tuner_tx_header[TUNER_TX_HEADER_SIZE] = {0x0Du, 0x0Au};
+static const uint8_t tuner_tx_tail[TUNER_TX_TAIL_SIZE] = {0x00u, 0xFFu, 0xFFu};
+
+static uint8_t tuner_tx_buf[TUNER_TX_BUFFERS][TUNER_TX_FRAME_SIZE];
+static uint32_t tuner_tx_len[TUNER_TX_BUFFERS];
+
+/* Buffer written by tuner_tx_send(), the other one may be in transmission */
+static volatile uint32_t tuner_tx_fill = 0u;
+/* Cy_SCB_UART_Transmit() runs */
+static volatile bool tuner_tx_running = false;
+/* The fill buffer holds a frame waiting for the running transmit to end */
+static volatile bool tuner_tx_pending = false;
+
+static CySCB_Type * tuner_tx_base = NULL;
+static cy_stc_scb_uart_context_t * tuner_tx_context = NULL;
+
+/*******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+static void tuner_tx_start(void);
+static void tuner_tx_event(uint32_t event);
+
+/*******************************************************************************
+ * Function Name: tuner_tx_init
+ ********************************************************************************
+ * Summary:
+ *  Registers the UART event callback. Call after Cy_SCB_UART_Init().
+ *
+ * Return:
+ *  void
+ *
+ * Parameters:
+ *  base - SCB block of the tuner UART
+ *  context - UART context
+ *******************************************************************************/
+void tuner_tx_init(CySCB_Type * base, cy_stc_scb_uart_context_t * context)
+{
+    tuner_tx_base = base;
+    tuner_tx_context = context;
+    tuner_tx_fill = 0u;
+    tuner_tx_running = false;
+    tuner_tx_pending = false;
+
+    Cy_SCB_UART_RegisterCallback(base, tuner_tx_event, context);
+}
+
+/*******************************************************************************
+ * Function Name: tuner_tx_send
+ ********************************************************************************
+ * Summary:
+ *  Copies the payload into a tuner frame and sends it in the background. If a
+ *  frame is in transmission, the new frame is sent when it ends and replaces
+ *  any frame still waiting. Returns without waiting for the UART.
+ *
+ * Return:
+ *  void
+ *
+ * Parameters:
+ *  payload - frame data
+ *  size - payload size in bytes, at most TUNER_TX_MAX_PAYLOAD
+ *******************************************************************************/
+void tuner_tx_send(const void * payload, uint32_t size)
+{
+    uint32_t interruptState;
+    uint8_t * frame;
+
+    CY_ASSERT(size <= TUNER_TX_MAX_PAYLOAD);
+
+    /* Take back a waiting frame so that the interrupt does not start sending
+     * it while it is overwritten
+     */
+    interruptState = Cy_SysLib_EnterCriticalSection();
+    tuner_tx_pending = false;
+    Cy_SysLib_ExitCriticalSection(interruptState);
+
+    frame = tuner_tx_buf[tuner_tx_fill];
+    memcpy(frame, tuner_tx_header, TUNER_TX_HEADER_SIZE);
+    memcpy(&frame[TUNER_TX_HEADER_SIZE], payload, size);
+    memcpy(&frame[TUNER_TX_HEADER_SIZE + size], tuner_tx_tail, TUNER_TX_TAIL_SIZE);
+    tuner_tx_len[tuner_tx_fill] = TUNER_TX_HEADER_SIZE + size + TUNER_TX_TAIL_SIZE;
+
+    interruptState = Cy_SysLib_EnterCriticalSection();
+    if (tuner_tx_running)
+    {
+        tuner_tx_pending = true;
+    }
+    else
+    {
+        tuner_tx_start();
+    }
+    Cy_SysLib_ExitCriticalSection(interruptState);
+}
+
+/*******************************************************************************
+ * Function Name: tuner_tx_is_busy
+ ********************************************************************************
+ * Summary:
+ *  Checks whether a frame is in transmission or waiting. The SCB cannot enter
+ *  Deep Sleep while it transmits.
+ *
+ * Return:
+ *  bool
+ *
+ * Parameters:
+ *  void
+ *******************************************************************************/
+bool tuner_tx_is_busy(void)
+{
+    return (tuner_tx_running || tuner_tx_pending);
+}
+
+/*******************************************************************************
+ * Function Name: tuner_tx_can_send
+ ********************************************************************************
+ * Summary:
+ *  Checks whether a frame passed to tuner_tx_send() now would be sent, that
+ *  is, no frame is waiting that it would replace.
+ *
+ * Return:
+ *  bool
+ *
+ * Parameters:
+ *  void
+ *******************************************************************************/
+bool tuner_tx_can_send(void)
+{
+    return !tuner_tx_pending;
+}
+
+/*******************************************************************************
+ * Function Name: tuner_tx_start
+ ********************************************************************************
+ * Summary:
+ *  Starts the transmit of the fill buffer and swaps the buffers. Called with
+ *  interrupts disabled or from the UART interrupt.
+ *
+ *******************************************************************************/
+static void tuner_tx_start(void)
+{
+    uint32_t idx = tuner_tx_fill;
+
+    tuner_tx_running = true;
+    tuner_tx_fill = idx ^ 1u;
+    (void)Cy_SCB_UART_Transmit(tuner_tx_base, tuner_tx_buf[idx], tuner_tx_len[idx], tuner_tx_context);
+}
+
+/*******************************************************************************
+ * Function Name: tuner_tx_event
+ ********************************************************************************
+ * Summary:
+ *  UART event callback, called from Cy_SCB_UART_Interrupt(). Starts the
+ *  waiting frame when the running transmit is done.
+ *
+ * Parameters:
+ *  event - UART callback events
+ *
+ *******************************************************************************/
+static void tuner_tx_event(uint32_t event)
+{
+    if (0u != (event & CY_SCB_UART_TRANSMIT_DONE_EVENT))
+    {
+        tuner_tx_running = false;
+        if (tuner_tx_pending)
+        {
+            tuner_tx_pending = false;
+            tuner_tx_start();
+        }
+    }
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,86 @@
+/******************************************************************************
+ * File Name: tuner_tx.h
+ *
+ * Description: Background transmit of the CAPSENSE Tuner data over UART. Each
+ * frame is copied into one of two buffers and sent by the SCB interrupt, so
+ * the tuner send callback returns without waiting for the UART.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+
+#ifndef TUNER_TX_H
+#define TUNER_TX_H
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "cy_pdl.h"
+#include "cycfg_capsense.h"
+#include "tuner_telemetry.h"
+#include "raw_trace.h"
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+/* Largest payload of a tuner frame: the tuner data, a telemetry keyframe,
+ * with STAGE_TRACE_ENABLE a trace frame or with RAW_TRACE_ENABLE a raw trace
+ * frame
+ */
+#define TUNER_TX_KEYFRAME_PAYLOAD        (sizeof(cy_capsense_tuner) + TUNER_TELEMETRY_KEYFRAME_HEADER_SIZE)
+#if (0u != STAGE_TRACE_ENABLE)
+#define TUNER_TX_TRACE_PAYLOAD           ((TUNER_TELEMETRY_TRACE_SIZE > TUNER_TX_KEYFRAME_PAYLOAD) ? \
+                                          TUNER_TELEMETRY_TRACE_SIZE : TUNER_TX_KEYFRAME_PAYLOAD)
+#else
+#define TUNER_TX_TRACE_PAYLOAD           TUNER_TX_KEYFRAME_PAYLOAD
+#endif /* STAGE_TRACE_ENABLE */
+#if (0u != RAW_TRACE_ENABLE)
+#define TUNER_TX_MAX_PAYLOAD             ((TUNER_TELEMETRY_RAW_SIZE > TUNER_TX_TRACE_PAYLOAD) ? \
+                                          TUNER_TELEMETRY_RAW_SIZE : TUNER_TX_TRACE_PAYLOAD)
+#else
+#define TUNER_TX_MAX_PAYLOAD             TUNER_TX_TRACE_PAYLOAD
+#endif /* RAW_TRACE_ENABLE */
+
+/*******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+void tuner_tx_init(CySCB_Type * base, cy_stc_scb_uart_context_t * context);
+void tuner_tx_send(const void * payload, uint32_t size);
+bool tuner_tx_is_busy(void);
+bool tuner_tx_can_send(void);
+
+#endif /* TUNER_TX_H */
+
+/* [] END OF FILE */
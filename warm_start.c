@@ -0,0 +1,541 @@
+/******************************************************************************
+ * File Name: warm_start.c
+ *
+ * Description: Warm start of the CAPSENSE. The saved record holds the
+ * calibrated sense clock, reference CDAC and compensation CDAC settings, and
+ * the baselines. The record is restored only if its data CRC and the CRC of
+ * the configuration match, every value passes a sanity check, and a first
+ * scan with the restored settings lands close to the saved baselines.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include <stddef.h>
+#include <string.h>
+#include "cy_pdl.h"
+#include "cycfg_capsense.h"
+#include "wdt_timer.h"
+#include "warm_start.h"
+#include "multi_freq.h"
+
+#if (0u != WARM_START_ENABLE)
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+#define WARM_START_MAGIC                 (0x57524D53u) /* "WRMS" */
+#define WARM_START_WDT_MASK              (0xFFFFu)
+
+/* Flash rows holding the record */
+#define WARM_START_ROWS                  ((sizeof(warm_start_record_t) + CY_FLASH_SIZEOF_ROW - 1u) / \
+                                          CY_FLASH_SIZEOF_ROW)
+
+/* Address of the saved record */
+#define WARM_START_ADDRESS               ((uintptr_t)&warm_start_flash)
+
+/*******************************************************************************
+ * Types
+ *******************************************************************************/
+/* Calibration of one widget */
+typedef struct
+{
+    uint16_t snsClk;
+    uint16_t cdacRef;
+    uint16_t numSubConversions;
+    uint16_t maxRawCount;
+    uint16_t cdacCompDivider;        /* Chosen by the calibration with COMP_DIV_MODE=AUTO */
+} warm_start_widget_t;
+
+/* Sensors follow in widget order */
+typedef struct
+{
+    uint16_t bsln;
+    uint8_t cdacComp;
+    uint8_t reserved;
+} warm_start_sensor_t;
+
+typedef struct
+{
+    uint32_t magic;
+    uint16_t configCrc;              /* CRC of the configuration before calibration */
+    uint16_t dataCrc;                /* CRC of the widget and sensor data */
+    warm_start_widget_t widget[CY_CAPSENSE_WIDGET_COUNT];
+    warm_start_sensor_t sensor[CY_CAPSENSE_SENSOR_COUNT];
+} warm_start_record_t;
+
+/* Record padded to whole flash rows */
+typedef union
+{
+    warm_start_record_t record;
+    uint32_t words[(WARM_START_ROWS * CY_FLASH_SIZEOF_ROW) / sizeof(uint32_t)];
+} warm_start_rows_t;
+
+/*******************************************************************************
+ * Global Definitions
+ *******************************************************************************/
+static cy_stc_capsense_context_t * warm_start_context = NULL;
+static warm_start_stats_t warm_start_stats;
+static uint16_t warm_start_config_crc;
+static warm_start_rows_t warm_start_buf;
+
+/* Flash rows of the saved record. Like the Em_EEPROM storage, they are a
+ * row-aligned const array placed by the linker, so code and constants never
+ * overlap them. Volatile: Cy_Flash_WriteRow() changes them. Erased rows fail
+ * the magic check.
+ */
+CY_SECTION(".cy_em_eeprom") CY_ALIGN(CY_FLASH_SIZEOF_ROW)
+static const volatile warm_start_rows_t warm_start_flash = {.words = {0u}};
+
+/* Time since boot until the save, in WDT ticks */
+static uint32_t warm_start_last;
+static uint32_t warm_start_elapsed;
+static bool warm_start_checked;
+
+/* Next row to write, WARM_START_ROWS when no save is in progress */
+static uint32_t warm_start_row;
+
+/*******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+static uint16_t warm_start_crc16(uint16_t crc, const uint8_t * data, uint32_t size);
+static uint16_t warm_start_crc_config(const cy_stc_capsense_context_t * context);
+static uint16_t warm_start_crc_data(const warm_start_record_t * record);
+static warm_start_result_t warm_start_check(const warm_start_record_t * record);
+static bool warm_start_drifted(uint32_t wdId, uint16_t value, uint16_t reference);
+static void warm_start_capture(warm_start_record_t * record);
+static bool warm_start_needs_save(const warm_start_record_t * saved, const warm_start_record_t * current);
+
+/*******************************************************************************
+ * Function Name: warm_start_restore
+ ********************************************************************************
+ * Summary:
+ *  Replaces Cy_CapSense_Enable() when a valid record is saved: initializes
+ *  the middleware without the calibration, restores the saved calibration,
+ *  scans all slots once and initializes the baselines from that scan. Call
+ *  after Cy_CapSense_Init() with the CAPSENSE interrupts enabled and no
+ *  end-of-scan callback registered. If the function returns false, the
+ *  caller calibrates with Cy_CapSense_Enable(), which overwrites any
+ *  restored setting.
+ *
+ * Return:
+ *  bool - true if the saved calibration is in use
+ *
+ * Parameters:
+ *  context - CAPSENSE context, initialized and not yet enabled
+ *******************************************************************************/
+bool warm_start_restore(cy_stc_capsense_context_t * context)
+{
+    const warm_start_record_t * saved = (const warm_start_record_t *)WARM_START_ADDRESS;
+    const cy_stc_capsense_widget_config_t * ptrWdCfg = context->ptrWdConfig;
+    cy_stc_capsense_sensor_context_t * ptrSns;
+    uint32_t start = Cy_WDT_GetCount();
+    uint32_t wdId;
+    uint32_t snsId;
+    uint32_t snsIndex = 0u;
+
+    warm_start_context = context;
+    warm_start_stats.rowsWritten = 0u;
+    warm_start_stats.writeErrors = 0u;
+    warm_start_stats.restoreUs = 0u;
+    warm_start_last = start;
+    warm_start_elapsed = 0u;
+    warm_start_checked = false;
+    warm_start_row = WARM_START_ROWS;
+
+    /* The configured settings, before the calibration changes them */
+    warm_start_config_crc = warm_start_crc_config(context);
+
+    warm_start_stats.result = warm_start_check(saved);
+    if (WARM_START_RESTORED_E != warm_start_stats.result)
+    {
+        return false;
+    }
+
+    /* Initialization resets the widget settings to the configured ones */
+    if (CY_CAPSENSE_STATUS_SUCCESS != Cy_CapSense_Initialize(context))
+    {
+        warm_start_stats.result = WARM_START_SCAN_FAILED_E;
+        return false;
+    }
+
+    for (wdId = 0u; wdId < CY_CAPSENSE_WIDGET_COUNT; wdId++)
+    {
+        ptrWdCfg[wdId].ptrWdContext->snsClk = saved->widget[wdId].snsClk;
+        ptrWdCfg[wdId].ptrWdContext->cdacRef = saved->widget[wdId].cdacRef;
+        ptrWdCfg[wdId].ptrWdContext->cdacCompDivider = (uint8_t)saved->widget[wdId].cdacCompDivider;
+        ptrWdCfg[wdId].ptrWdContext->numSubConversions = saved->widget[wdId].numSubConversions;
+        ptrWdCfg[wdId].ptrWdContext->maxRawCount = saved->widget[wdId].maxRawCount;
+        for (snsId = 0u; snsId < ptrWdCfg[wdId].numSns; snsId++)
+        {
+            ptrWdCfg[wdId].ptrSnsContext[snsId].cdacComp = saved->sensor[snsIndex].cdacComp;
+            snsIndex++;
+        }
+    }
+
+    /* One scan with the restored settings checks them against the saved
+     * baselines; the scan builds the sensor configuration from the widget
+     * and sensor context. A finger on a sensor at boot also fails the check.
+     */
+    if (CY_CAPSENSE_STATUS_SUCCESS != Cy_CapSense_ScanAllSlots(context))
+    {
+        warm_start_stats.result = WARM_START_SCAN_FAILED_E;
+        return false;
+    }
+    while (CY_CAPSENSE_NOT_BUSY != Cy_CapSense_IsBusy(context))
+    {
+    }
+
+    snsIndex = 0u;
+    for (wdId = 0u; wdId < CY_CAPSENSE_WIDGET_COUNT; wdId++)
+    {
+        for (snsId = 0u; snsId < ptrWdCfg[wdId].numSns; snsId++)
+        {
+            ptrSns = &ptrWdCfg[wdId].ptrSnsContext[snsId];
+            if (warm_start_drifted(wdId, ptrSns->raw, saved->sensor[snsIndex].bsln))
+            {
+                warm_start_stats.result = WARM_START_DRIFT_E;
+                return false;
+            }
+            snsIndex++;
+        }
+    }
+
+    Cy_CapSense_InitializeAllBaselines(context);
+    warm_start_stats.restoreUs = wdt_timer_ticks_to_us((Cy_WDT_GetCount() - start) & WARM_START_WDT_MASK);
+    return true;
+}
+
+/*******************************************************************************
+ * Function Name: warm_start_restored
+ ********************************************************************************
+ * Summary:
+ *  Tells whether the boot used the saved calibration.
+ *
+ * Return:
+ *  bool - true after a warm start
+ *
+ * Parameters:
+ *  void
+ *******************************************************************************/
+bool warm_start_restored(void)
+{
+    return (WARM_START_RESTORED_E == warm_start_stats.result);
+}
+
+/*******************************************************************************
+ * Function Name: warm_start_service
+ ********************************************************************************
+ * Summary:
+ *  Once WARM_START_SAVE_DELAY_MS have passed since boot and no widget is
+ *  active, saves the calibration and the baselines if the saved record is
+ *  missing, belongs to another configuration, or differs from the current
+ *  calibration or baselines. Runs at most once per boot and writes one flash
+ *  row per call. The CPU is stalled for each row write; the scan in flight
+ *  completes, and its interrupts are served after the write. A save cut short
+ *  by a reset fails the data CRC at the next boot. Call once per main loop
+ *  pass, at least once per WDT counter period.
+ *
+ * Return:
+ *  void
+ *
+ * Parameters:
+ *  void
+ *******************************************************************************/
+void warm_start_service(void)
+{
+    const warm_start_record_t * saved = (const warm_start_record_t *)WARM_START_ADDRESS;
+    uint32_t now;
+
+    if (warm_start_row < WARM_START_ROWS)
+    {
+        /* One row per call bounds the stall of the main loop */
+        if (CY_FLASH_DRV_SUCCESS == Cy_Flash_WriteRow(
+                (uint32_t)(WARM_START_ADDRESS + (warm_start_row * CY_FLASH_SIZEOF_ROW)),
+                &warm_start_buf.words[(warm_start_row * CY_FLASH_SIZEOF_ROW) / sizeof(uint32_t)]))
+        {
+            warm_start_stats.rowsWritten++;
+        }
+        else
+        {
+            warm_start_stats.writeErrors++;
+        }
+        warm_start_row++;
+        return;
+    }
+    if (warm_start_checked)
+    {
+        return;
+    }
+
+    now = Cy_WDT_GetCount();
+    warm_start_elapsed += (now - warm_start_last) & WARM_START_WDT_MASK;
+    warm_start_last = now;
+    if ((wdt_timer_ticks_to_us(warm_start_elapsed) < (WARM_START_SAVE_DELAY_MS * 1000u)) ||
+        (0u != Cy_CapSense_IsAnyWidgetActive(warm_start_context)))
+    {
+        return;
+    }
+    warm_start_checked = true;
+
+    memset(&warm_start_buf, 0, sizeof(warm_start_buf));
+    warm_start_capture(&warm_start_buf.record);
+    if (warm_start_needs_save(saved, &warm_start_buf.record))
+    {
+        warm_start_row = 0u;
+    }
+}
+
+/*******************************************************************************
+ * Function Name: warm_start_get_stats
+ ********************************************************************************
+ * Summary:
+ *  Returns the outcome of the restore and the flash writes.
+ *
+ * Return:
+ *  const warm_start_stats_t * - statistics
+ *
+ * Parameters:
+ *  void
+ *******************************************************************************/
+const warm_start_stats_t * warm_start_get_stats(void)
+{
+    return &warm_start_stats;
+}
+
+/*******************************************************************************
+ * Function Name: warm_start_crc16
+ ********************************************************************************
+ * Summary:
+ *  Continues a CRC-16-CCITT over a block of bytes.
+ *
+ *******************************************************************************/
+static uint16_t warm_start_crc16(uint16_t crc, const uint8_t * data, uint32_t size)
+{
+    uint32_t bit;
+
+    while (0u != size--)
+    {
+        crc ^= (uint16_t)((uint16_t)*data++ << 8u);
+        for (bit = 0u; bit < 8u; bit++)
+        {
+            crc = (0u != (crc & 0x8000u)) ? (uint16_t)((crc << 1u) ^ 0x1021u) : (uint16_t)(crc << 1u);
+        }
+    }
+    return crc;
+}
+
+/*******************************************************************************
+ * Function Name: warm_start_crc_config
+ ********************************************************************************
+ * Summary:
+ *  Computes the CRC of the configuration ID, the widget layout and the
+ *  configured widget settings. Call before the calibration.
+ *
+ *******************************************************************************/
+static uint16_t warm_start_crc_config(const cy_stc_capsense_context_t * context)
+{
+    const cy_stc_capsense_widget_config_t * ptrWdCfg = context->ptrWdConfig;
+    uint16_t fields[7u];
+    uint16_t crc;
+    uint32_t wdId;
+
+    fields[0u] = context->ptrCommonContext->configId;
+    fields[1u] = (uint16_t)CY_CAPSENSE_WIDGET_COUNT;
+    fields[2u] = (uint16_t)CY_CAPSENSE_SENSOR_COUNT;
+    crc = warm_start_crc16(0xFFFFu, (const uint8_t *)fields, 3u * sizeof(fields[0u]));
+
+    for (wdId = 0u; wdId < CY_CAPSENSE_WIDGET_COUNT; wdId++)
+    {
+        fields[0u] = ptrWdCfg[wdId].firstSlotId;
+        fields[1u] = ptrWdCfg[wdId].numSlots;
+        fields[2u] = ptrWdCfg[wdId].numSns;
+        fields[3u] = ptrWdCfg[wdId].ptrWdContext->fingerTh;
+        fields[4u] = ptrWdCfg[wdId].ptrWdContext->snsClk;
+        fields[5u] = ptrWdCfg[wdId].ptrWdContext->cdacRef;
+        fields[6u] = ptrWdCfg[wdId].ptrWdContext->numSubConversions;
+        crc = warm_start_crc16(crc, (const uint8_t *)fields, sizeof(fields));
+    }
+    return crc;
+}
+
+/*******************************************************************************
+ * Function Name: warm_start_crc_data
+ ********************************************************************************
+ * Summary:
+ *  Computes the CRC of the widget and sensor data of a record.
+ *
+ *******************************************************************************/
+static uint16_t warm_start_crc_data(const warm_start_record_t * record)
+{
+    return warm_start_crc16(0xFFFFu, (const uint8_t *)record->widget,
+                            sizeof(warm_start_record_t) - offsetof(warm_start_record_t, widget));
+}
+
+/*******************************************************************************
+ * Function Name: warm_start_check
+ ********************************************************************************
+ * Summary:
+ *  Validates a saved record for the current configuration.
+ *
+ *******************************************************************************/
+static warm_start_result_t warm_start_check(const warm_start_record_t * record)
+{
+    const cy_stc_capsense_widget_config_t * ptrWdCfg = warm_start_context->ptrWdConfig;
+    uint32_t wdId;
+    uint32_t snsId;
+    uint32_t snsIndex = 0u;
+
+    if ((WARM_START_MAGIC != record->magic) || (warm_start_crc_data(record) != record->dataCrc))
+    {
+        return WARM_START_NO_RECORD_E;
+    }
+    if (warm_start_config_crc != record->configCrc)
+    {
+        return WARM_START_CONFIG_CHANGED_E;
+    }
+
+    for (wdId = 0u; wdId < CY_CAPSENSE_WIDGET_COUNT; wdId++)
+    {
+        if ((0u == record->widget[wdId].snsClk) || (0u == record->widget[wdId].cdacRef) ||
+            (0u == record->widget[wdId].numSubConversions) || (0u == record->widget[wdId].maxRawCount) ||
+            (0u == record->widget[wdId].cdacCompDivider) || (UINT8_MAX < record->widget[wdId].cdacCompDivider))
+        {
+            return WARM_START_OUT_OF_RANGE_E;
+        }
+        for (snsId = 0u; snsId < ptrWdCfg[wdId].numSns; snsId++)
+        {
+            if ((0u == record->sensor[snsIndex].bsln) ||
+                (record->sensor[snsIndex].bsln > record->widget[wdId].maxRawCount))
+            {
+                return WARM_START_OUT_OF_RANGE_E;
+            }
+            snsIndex++;
+        }
+    }
+    return WARM_START_RESTORED_E;
+}
+
+/*******************************************************************************
+ * Function Name: warm_start_drifted
+ ********************************************************************************
+ * Summary:
+ *  Tells whether a count differs from a saved baseline by more than
+ *  WARM_START_DRIFT_PERCENT of the finger threshold of the widget.
+ *
+ *******************************************************************************/
+static bool warm_start_drifted(uint32_t wdId, uint16_t value, uint16_t reference)
+{
+    uint32_t diff = (value > reference) ? ((uint32_t)value - reference) : ((uint32_t)reference - value);
+
+    return ((diff * 100u) > ((uint32_t)warm_start_context->ptrWdConfig[wdId].ptrWdContext->fingerTh *
+                             WARM_START_DRIFT_PERCENT));
+}
+
+/*******************************************************************************
+ * Function Name: warm_start_capture
+ ********************************************************************************
+ * Summary:
+ *  Fills a record with the current calibration and baselines.
+ *
+ *******************************************************************************/
+static void warm_start_capture(warm_start_record_t * record)
+{
+    const cy_stc_capsense_widget_config_t * ptrWdCfg = warm_start_context->ptrWdConfig;
+    uint32_t wdId;
+    uint32_t snsId;
+    uint32_t snsIndex = 0u;
+
+    record->magic = WARM_START_MAGIC;
+    record->configCrc = warm_start_config_crc;
+    for (wdId = 0u; wdId < CY_CAPSENSE_WIDGET_COUNT; wdId++)
+    {
+        /* Frequency hopping leaves the divider of the last channel scanned */
+        record->widget[wdId].snsClk = MULTI_FREQ_BASE_SNS_CLK(wdId, ptrWdCfg[wdId].ptrWdContext->snsClk);
+        record->widget[wdId].cdacRef = ptrWdCfg[wdId].ptrWdContext->cdacRef;
+        record->widget[wdId].cdacCompDivider = ptrWdCfg[wdId].ptrWdContext->cdacCompDivider;
+        record->widget[wdId].numSubConversions = ptrWdCfg[wdId].ptrWdContext->numSubConversions;
+        record->widget[wdId].maxRawCount = ptrWdCfg[wdId].ptrWdContext->maxRawCount;
+        for (snsId = 0u; snsId < ptrWdCfg[wdId].numSns; snsId++)
+        {
+            record->sensor[snsIndex].bsln = ptrWdCfg[wdId].ptrSnsContext[snsId].bsln;
+            record->sensor[snsIndex].cdacComp = ptrWdCfg[wdId].ptrSnsContext[snsId].cdacComp;
+            snsIndex++;
+        }
+    }
+    record->dataCrc = warm_start_crc_data(record);
+}
+
+/*******************************************************************************
+ * Function Name: warm_start_needs_save
+ ********************************************************************************
+ * Summary:
+ *  Tells whether the saved record must be replaced: it is not valid for this
+ *  configuration, the calibration has changed, or a baseline has drifted.
+ *  Small baseline changes do not wear the flash.
+ *
+ *******************************************************************************/
+static bool warm_start_needs_save(const warm_start_record_t * saved, const warm_start_record_t * current)
+{
+    const cy_stc_capsense_widget_config_t * ptrWdCfg = warm_start_context->ptrWdConfig;
+    uint32_t wdId;
+    uint32_t snsId;
+    uint32_t snsIndex = 0u;
+
+    if ((WARM_START_RESTORED_E != warm_start_check(saved)) ||
+        (0 != memcmp(saved->widget, current->widget, sizeof(current->widget))))
+    {
+        return true;
+    }
+    for (wdId = 0u; wdId < CY_CAPSENSE_WIDGET_COUNT; wdId++)
+    {
+        for (snsId = 0u; snsId < ptrWdCfg[wdId].numSns; snsId++)
+        {
+            if ((saved->sensor[snsIndex].cdacComp != current->sensor[snsIndex].cdacComp) ||
+                warm_start_drifted(wdId, current->sensor[snsIndex].bsln, saved->sensor[snsIndex].bsln))
+            {
+                return true;
+            }
+            snsIndex++;
+        }
+    }
+    return false;
+}
+
+#endif /* WARM_START_ENABLE */
+
+/* [] END OF FILE */
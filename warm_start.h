@@ -0,0 +1,125 @@
+/******************************************************************************
+ * File Name: warm_start.h
+ *
+ * Description: Warm start of the CAPSENSE. The calibrated sense clock and
+ * CDAC settings and the baselines are saved to the last flash rows together
+ * with a CRC of the CAPSENSE configuration. The next boot restores them in
+ * place of the full calibration and starts scanning without the tuner delay.
+ * Compiled out unless WARM_START_ENABLE is set.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+
+#ifndef WARM_START_H
+#define WARM_START_H
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include "cycfg_capsense.h"
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+/* 1 = restore the calibration saved by the last run, 0 = always calibrate */
+#ifndef WARM_START_ENABLE
+#define WARM_START_ENABLE                (0u)
+#endif
+
+/* Time after boot before the calibration and baselines are saved, so that
+ * the baselines have settled. The save waits until no widget is active.
+ */
+#ifndef WARM_START_SAVE_DELAY_MS
+#define WARM_START_SAVE_DELAY_MS         (2000u)
+#endif
+
+/* Largest difference between the raw count of the first scan and the saved
+ * baseline, in percent of the finger threshold of the widget. A larger
+ * difference rejects the saved data, and a baseline that has moved further
+ * since the last save is saved again.
+ */
+#ifndef WARM_START_DRIFT_PERCENT
+#define WARM_START_DRIFT_PERCENT         (50u)
+#endif
+
+/* Instrumentation of the application. WARM_START_RESTORE() returns true if
+ * the saved calibration replaced Cy_CapSense_Enable().
+ */
+#if (0u != WARM_START_ENABLE)
+#define WARM_START_RESTORE(context)      warm_start_restore(context)
+#define WARM_START_RESTORED()            warm_start_restored()
+#define WARM_START_SERVICE()             warm_start_service()
+#else
+#define WARM_START_RESTORE(context)      (false)
+#define WARM_START_RESTORED()            (false)
+#define WARM_START_SERVICE()
+#endif /* WARM_START_ENABLE */
+
+/*******************************************************************************
+ * Types
+ *******************************************************************************/
+/* Outcome of the restore at boot */
+typedef enum
+{
+    WARM_START_RESTORED_E,           /* saved data restored, calibration skipped */
+    WARM_START_NO_RECORD_E,          /* nothing saved, or the data is corrupted */
+    WARM_START_CONFIG_CHANGED_E,     /* saved for another CAPSENSE configuration */
+    WARM_START_OUT_OF_RANGE_E,       /* saved values failed the sanity check */
+    WARM_START_DRIFT_E,              /* first scan too far from the saved baselines */
+    WARM_START_SCAN_FAILED_E         /* initialization or first scan failed */
+} warm_start_result_t;
+
+typedef struct
+{
+    warm_start_result_t result;      /* outcome of the restore at boot */
+    uint32_t restoreUs;              /* time from the restore call to the baselines, us */
+    uint32_t rowsWritten;            /* flash rows written since boot */
+    uint32_t writeErrors;            /* failed row writes */
+} warm_start_stats_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+bool warm_start_restore(cy_stc_capsense_context_t * context);
+bool warm_start_restored(void);
+void warm_start_service(void);
+const warm_start_stats_t * warm_start_get_stats(void);
+
+#endif /* WARM_START_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,263 @@
+/******************************************************************************
+ * File Name: wdt_timer.c
+ *
+ * Description: WDT timekeeping. The ILO is measured against the IMO once at
+ * startup. The WDT interrupt then adds the cached compensated count to the
+ * match value, so the interrupt period does not depend on the main loop. The
+ * measurement is repeated on a schedule, shortened when the ILO drifts, and
+ * polled from the main loop without busy-waiting.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "wdt_timer.h"
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+#define WDT_MATCH_MASK                   (0xFFFFu)
+
+/*******************************************************************************
+ * Global Definitions
+ *******************************************************************************/
+/* Desired WDT interrupt interval in microseconds */
+static uint32_t wdt_interval_us = 0u;
+
+/* ILO cycles per WDT interrupt interval, read by the WDT interrupt */
+static volatile uint32_t ilo_compensated_counts = 0u;
+
+/* WDT interrupts until the next ILO recompensation */
+static volatile uint32_t wdt_recomp_countdown = 0u;
+static uint32_t wdt_recomp_period = WDT_RECOMP_MIN_INTERRUPTS;
+
+/* ILO measurement in progress */
+static bool ilo_measuring = false;
+
+/*******************************************************************************
+ * Function Name: wdt_timer_init
+ ********************************************************************************
+ * Summary:
+ *  Compensates the ILO and programs the first WDT match. Blocks until the
+ *  first ILO measurement is complete. Call before the WDT is enabled.
+ *
+ * Return:
+ *  void
+ *
+ * Parameters:
+ *  intervalUs - WDT interrupt interval in microseconds
+ *******************************************************************************/
+void wdt_timer_init(uint32_t intervalUs)
+{
+    uint32_t iloCycles = 0u;
+
+    wdt_interval_us = intervalUs;
+
+    /* Get the ILO compensated counts i.e. the actual counts for the desired
+     * ILO frequency. ILO default accuracy is +/- 60%.
+     */
+    Cy_SysClk_IloStartMeasurement();
+    while (CY_SYSCLK_SUCCESS != Cy_SysClk_IloCompensate(wdt_interval_us, &iloCycles))
+    {
+    }
+    Cy_SysClk_IloStopMeasurement();
+
+    ilo_compensated_counts = iloCycles;
+    wdt_recomp_period = WDT_RECOMP_MIN_INTERRUPTS;
+    wdt_recomp_countdown = wdt_recomp_period;
+    ilo_measuring = false;
+
+    Cy_WDT_SetMatch((Cy_WDT_GetCount() + iloCycles) & WDT_MATCH_MASK);
+}
+
+/*******************************************************************************
+ * Function Name: wdt_timer_next_match
+ ********************************************************************************
+ * Summary:
+ *  Programs the WDT match for the next interrupt. The WDT counter is not reset
+ *  on a match, so the match advances by one compensated interval. Call from
+ *  the WDT interrupt.
+ *
+ * Return:
+ *  void
+ *
+ * Parameters:
+ *  void
+ *******************************************************************************/
+void wdt_timer_next_match(void)
+{
+    Cy_WDT_SetMatch((Cy_WDT_GetMatch() + ilo_compensated_counts) & WDT_MATCH_MASK);
+
+    if (0u != wdt_recomp_countdown)
+    {
+        wdt_recomp_countdown--;
+    }
+}
+
+/*******************************************************************************
+ * Function Name: wdt_timer_service
+ ********************************************************************************
+ * Summary:
+ *  Repeats the ILO compensation when it is due. Starts the measurement and
+ *  polls it on later calls instead of waiting for it. When the new count
+ *  differs from the cached one by more than WDT_ILO_DRIFT_PERCENT, the
+ *  recompensation period returns to WDT_RECOMP_MIN_INTERRUPTS; otherwise it
+ *  doubles up to WDT_RECOMP_MAX_INTERRUPTS.
+ *
+ * Return:
+ *  bool - true while the ILO measurement runs. The measurement needs the IMO,
+ *  so the device must not enter Deep Sleep.
+ *
+ * Parameters:
+ *  void
+ *******************************************************************************/
+bool wdt_timer_service(void)
+{
+    uint32_t iloCycles = 0u;
+    uint32_t oldCycles;
+    uint32_t delta;
+
+    if (!ilo_measuring)
+    {
+        if (0u != wdt_recomp_countdown)
+        {
+            return false;
+        }
+        Cy_SysClk_IloStartMeasurement();
+        ilo_measuring = true;
+    }
+
+    if (CY_SYSCLK_SUCCESS != Cy_SysClk_IloCompensate(wdt_interval_us, &iloCycles))
+    {
+        return true;
+    }
+    Cy_SysClk_IloStopMeasurement();
+    ilo_measuring = false;
+
+    oldCycles = ilo_compensated_counts;
+    delta = (iloCycles > oldCycles) ? (iloCycles - oldCycles) : (oldCycles - iloCycles);
+    if ((delta * 100u) > (oldCycles * WDT_ILO_DRIFT_PERCENT))
+    {
+        wdt_recomp_period = WDT_RECOMP_MIN_INTERRUPTS;
+    }
+    else if (wdt_recomp_period < WDT_RECOMP_MAX_INTERRUPTS)
+    {
+        wdt_recomp_period *= 2u;
+        if (wdt_recomp_period > WDT_RECOMP_MAX_INTERRUPTS)
+        {
+            wdt_recomp_period = WDT_RECOMP_MAX_INTERRUPTS;
+        }
+    }
+
+    ilo_compensated_counts = iloCycles;
+    wdt_recomp_countdown = wdt_recomp_period;
+    return false;
+}
+
+/*******************************************************************************
+ * Function Name: wdt_timer_ticks_to_us
+ ********************************************************************************
+ * Summary:
+ *  Converts a number of WDT counter ticks to microseconds with the cached ILO
+ *  compensation.
+ *
+ * Return:
+ *  uint32_t - time in microseconds
+ *
+ * Parameters:
+ *  ticks - WDT counter ticks
+ *******************************************************************************/
+uint32_t wdt_timer_ticks_to_us(uint32_t ticks)
+{
+    uint32_t counts = ilo_compensated_counts;
+
+    if (0u == counts)
+    {
+        return 0u;
+    }
+    return (uint32_t)(((uint64_t)ticks * wdt_interval_us) / counts);
+}
+
+/*******************************************************************************
+ * Function Name: wdt_timer_set_interval
+ ********************************************************************************
+ * Summary:
+ *  Changes the WDT interrupt interval. The cached ILO compensation is scaled
+ *  to the new interval, so no new measurement is needed. The match already
+ *  programmed is kept; the new interval applies from the next interrupt.
+ *
+ * Return:
+ *  void
+ *
+ * Parameters:
+ *  intervalUs - WDT interrupt interval in microseconds
+ *******************************************************************************/
+void wdt_timer_set_interval(uint32_t intervalUs)
+{
+    uint32_t interruptState;
+    uint32_t counts;
+
+    if ((0u == wdt_interval_us) || (intervalUs == wdt_interval_us))
+    {
+        return;
+    }
+    interruptState = Cy_SysLib_EnterCriticalSection();
+    counts = (uint32_t)(((uint64_t)ilo_compensated_counts * intervalUs) / wdt_interval_us);
+    ilo_compensated_counts = (counts < WDT_MATCH_MASK) ? counts : WDT_MATCH_MASK;
+    wdt_interval_us = intervalUs;
+    Cy_SysLib_ExitCriticalSection(interruptState);
+}
+
+/*******************************************************************************
+ * Function Name: wdt_timer_restart
+ ********************************************************************************
+ * Summary:
+ *  Programs the WDT match one interval from now, so the following interrupts
+ *  are aligned to the current time. Call with the WDT interrupt disabled.
+ *
+ * Return:
+ *  void
+ *
+ * Parameters:
+ *  void
+ *******************************************************************************/
+void wdt_timer_restart(void)
+{
+    Cy_WDT_SetMatch((Cy_WDT_GetCount() + ilo_compensated_counts) & WDT_MATCH_MASK);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,86 @@
+/******************************************************************************
+ * File Name: wdt_timer.h
+ *
+ * Description: WDT timekeeping. Compensates the ILO that clocks the WDT,
+ * programs the WDT match for the next periodic interrupt, and repeats the ILO
+ * compensation on a schedule without blocking the main loop.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+
+#ifndef WDT_TIMER_H
+#define WDT_TIMER_H
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "cy_pdl.h"
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+/* Shortest ILO recompensation period in WDT interrupts. Used after startup
+ * and whenever the ILO drifts, for example with temperature.
+ */
+#ifndef WDT_RECOMP_MIN_INTERRUPTS
+#define WDT_RECOMP_MIN_INTERRUPTS        (100u)
+#endif
+
+/* Longest ILO recompensation period in WDT interrupts. The period doubles
+ * after every measurement that shows no drift, up to this limit.
+ */
+#ifndef WDT_RECOMP_MAX_INTERRUPTS
+#define WDT_RECOMP_MAX_INTERRUPTS        (6400u)
+#endif
+
+/* ILO change, in percent, at which the ILO is considered drifting */
+#ifndef WDT_ILO_DRIFT_PERCENT
+#define WDT_ILO_DRIFT_PERCENT            (2u)
+#endif
+
+/*******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+void wdt_timer_init(uint32_t intervalUs);
+void wdt_timer_next_match(void);
+bool wdt_timer_service(void);
+uint32_t wdt_timer_ticks_to_us(uint32_t ticks);
+void wdt_timer_set_interval(uint32_t intervalUs);
+void wdt_timer_restart(void);
+
+#endif /* WDT_TIMER_H */
+
+/* [] END OF FILE */